@@ -66,6 +66,49 @@ const Acid Acid::s_aryACIDS[ACID_MAX] =
 	{ -Constants::s_nMEDIUM_DIAGONALSTEP,	Constants::s_nMEDIUM_DIAGONALSTEP,  Constants::s_nVECTOR_MEDIUM,	DIR_NORTHWEST, 	"Nwm" }
 };
 
+// NOTE: This array MUST be in the same order as the ACIDTYPE enumeration
+const LatticePoint LatticePoint::s_aryACIDS[ACID_MAX] =
+{
+	// Stop vector
+	LatticePoint(LS_SHORT, 0, 0),
+
+	// NORTH vectors
+	LatticePoint(LS_SHORT, 0, 1),
+	LatticePoint(LS_MEDIUM, 0, 1),
+	LatticePoint(LS_LONG, 0, 1),
+
+	// NORTHEAST vectors
+	LatticePoint(LS_SHORTDIAGONAL, 1, 1),
+	LatticePoint(LS_MEDIUMDIAGONAL, 1, 1),
+
+	// EAST vectors
+	LatticePoint(LS_SHORT, 1, 0),
+	LatticePoint(LS_MEDIUM, 1, 0),
+	LatticePoint(LS_LONG, 1, 0),
+
+	// SOUTHEAST vectors
+	LatticePoint(LS_SHORTDIAGONAL, 1, -1),
+	LatticePoint(LS_MEDIUMDIAGONAL, 1, -1),
+
+	// SOUTH vectors
+	LatticePoint(LS_SHORT, 0, -1),
+	LatticePoint(LS_MEDIUM, 0, -1),
+	LatticePoint(LS_LONG, 0, -1),
+
+	// SOUTHWEST vectors
+	LatticePoint(LS_SHORTDIAGONAL, -1, -1),
+	LatticePoint(LS_MEDIUMDIAGONAL, -1, -1),
+
+	// WEST vectors
+	LatticePoint(LS_SHORT, -1, 0),
+	LatticePoint(LS_MEDIUM, -1, 0),
+	LatticePoint(LS_LONG, -1, 0),
+
+	// NORTHWEST vectors
+	LatticePoint(LS_SHORTDIAGONAL, -1, 1),
+	LatticePoint(LS_MEDIUMDIAGONAL, -1, 1)
+};
+
 const std::string Codon::s_strSTART("ATG");
 
 const bool Codon::s_aryCOHERENCE[ACID_MAX][ACID_MAX][ACID_MAX] =
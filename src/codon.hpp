@@ -172,6 +172,49 @@ namespace org_biologicinstitute_stylus
 		Unit _sxy;
 	};
 	
+	/**
+	 * \brief LatticePoint class
+	 *
+	 * This class holds, exactly, the point reached by applying a sequence of vectors.
+	 *
+	 * \remarks
+	 * - Every vector moves along each axis by zero or by one of five lengths (see
+	 *   LATTICESTEP), so each coordinate is held as the (signed) count of each length
+	 *   rather than as an accumulated floating-point sum
+	 * - Counts are integral but held as UNITs (which represent them exactly), paired
+	 *   by length, so that applying a vector (see s_aryACIDS) needs neither branches
+	 *   nor conversions
+	 * - Since no integer combination of the lengths is zero, points are equal if and
+	 *   only if their counts are equal; comparisons need no tolerance
+	 * - Points are relative to an origin (e.g., that of the Gene)
+	 */
+	class LatticePoint
+	{
+	public:
+		LatticePoint();
+		LatticePoint(const LatticePoint& lpt);
+
+		bool operator==(const LatticePoint& lpt) const;
+		bool operator!=(const LatticePoint& lpt) const;
+
+		LatticePoint& operator=(const LatticePoint& lpt);
+
+		LatticePoint& operator+=(ACIDTYPE at);
+		LatticePoint& operator+=(const LatticePoint& lpt);
+
+		LatticePoint& operator-=(ACIDTYPE at);
+		LatticePoint& operator-=(const LatticePoint& lpt);
+
+		void clear();
+
+	private:
+		static const LatticePoint s_aryACIDS[ACID_MAX];
+
+		UNIT _aryCounts[LS_MAX][2];			///< Count of each length moved along the x-axis and the y-axis
+
+		LatticePoint(LATTICESTEP ls, int nX, int nY);
+	};
+
 	/**
 	 * \brief Codon class
 	 *
@@ -270,11 +313,11 @@ namespace org_biologicinstitute_stylus
 
 		/**
 		 * \brief Return true/false if the passed change results in a silent mutation
-		 * \param[in] strBases Base string to be changed
+		 * \param[in] seqBases Base sequence to be changed
 		 * \param[in] iBaseChange Location at to begin the change
 		 * \param[in] strBasesChange Bases to which to change
 		 */
-		static bool isSilentChange(const std::string& strBases, size_t iBaseChange, const std::string& strBasesChange);
+		static bool isSilentChange(const BaseSequence& seqBases, size_t iBaseChange, const std::string& strBasesChange);
 	};
 
 
@@ -158,6 +158,72 @@ inline void ScaledLength::clear()
 	_sx = 1.0; _sy = 1.0; _sxy = 1.0;
 }
 
+//--------------------------------------------------------------------------------
+//
+// LatticePoint
+//
+//--------------------------------------------------------------------------------
+inline LatticePoint::LatticePoint() { clear(); }
+inline LatticePoint::LatticePoint(const LatticePoint& lpt) { *this = lpt; }
+inline LatticePoint::LatticePoint(LATTICESTEP ls, int nX, int nY)
+{
+	clear();
+	_aryCounts[ls][0] = nX;
+	_aryCounts[ls][1] = nY;
+}
+
+inline bool LatticePoint::operator==(const LatticePoint& lpt) const
+{
+	for (size_t ls=LS_SHORT; ls < LS_MAX; ++ls)
+	{
+		if (_aryCounts[ls][0] != lpt._aryCounts[ls][0] || _aryCounts[ls][1] != lpt._aryCounts[ls][1])
+			return false;
+	}
+	return true;
+}
+inline bool LatticePoint::operator!=(const LatticePoint& lpt) const { return !operator==(lpt); }
+
+inline LatticePoint& LatticePoint::operator=(const LatticePoint& lpt)
+{
+	for (size_t ls=LS_SHORT; ls < LS_MAX; ++ls)
+	{
+		_aryCounts[ls][0] = lpt._aryCounts[ls][0];
+		_aryCounts[ls][1] = lpt._aryCounts[ls][1];
+	}
+	return *this;
+}
+
+inline LatticePoint& LatticePoint::operator+=(ACIDTYPE at) { return operator+=(s_aryACIDS[at]); }
+inline LatticePoint& LatticePoint::operator+=(const LatticePoint& lpt)
+{
+	for (size_t ls=LS_SHORT; ls < LS_MAX; ++ls)
+	{
+		_aryCounts[ls][0] += lpt._aryCounts[ls][0];
+		_aryCounts[ls][1] += lpt._aryCounts[ls][1];
+	}
+	return *this;
+}
+
+inline LatticePoint& LatticePoint::operator-=(ACIDTYPE at) { return operator-=(s_aryACIDS[at]); }
+inline LatticePoint& LatticePoint::operator-=(const LatticePoint& lpt)
+{
+	for (size_t ls=LS_SHORT; ls < LS_MAX; ++ls)
+	{
+		_aryCounts[ls][0] -= lpt._aryCounts[ls][0];
+		_aryCounts[ls][1] -= lpt._aryCounts[ls][1];
+	}
+	return *this;
+}
+
+inline void LatticePoint::clear()
+{
+	for (size_t ls=LS_SHORT; ls < LS_MAX; ++ls)
+	{
+		_aryCounts[ls][0] = 0;
+		_aryCounts[ls][1] = 0;
+	}
+}
+
 //--------------------------------------------------------------------------------
 //
 // Codon
@@ -203,9 +269,9 @@ inline bool Codon::isStop(const char* pszCodon)
 	return (Genome::codonToType(pszCodon) == ACID_STP);
 }
 
-inline bool Codon::isSilentChange(const std::string& strBases, size_t iBaseChange, const std::string& strBasesChange)
+inline bool Codon::isSilentChange(const BaseSequence& seqBases, size_t iBaseChange, const std::string& strBasesChange)
 {
-	string strBasesBefore(strBases.substr(toCodonBoundary(iBaseChange), numAffectedCodons(iBaseChange, strBasesChange.length()) * s_cchCODON));
+	string strBasesBefore(seqBases.substr(toCodonBoundary(iBaseChange), numAffectedCodons(iBaseChange, strBasesChange.length()) * s_cchCODON));
 	string strBasesAfter(strBasesBefore);
 	strBasesAfter.replace(toCodonOffset(iBaseChange), strBasesChange.length(), strBasesChange);
 	
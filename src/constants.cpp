@@ -45,6 +45,8 @@ const std::string Constants::s_strFINAL("final");
 const std::string Constants::s_strTRIAL("trial");
 const std::string Constants::s_strHISTORY("history");
 const std::string Constants::s_strPLAN("plan");
+const std::string Constants::s_strLINEAGE("lineage");
+const std::string Constants::s_strATTEMPT("attempt");
 
 const std::string Constants::s_strENTER("ENTER: %s");
 const std::string Constants::s_strEXIT("EXIT : %s");
@@ -44,6 +44,8 @@ namespace org_biologicinstitute_stylus
 		static const UNIT s_nERROR_MARGIN;
 
 		static const size_t s_nMAXIMUMGENERATEDLENGTH = (3 * 3);	///< Maximum generated length (up to 3 trivectors)
+		static const size_t s_cminSWEEPPAIRSPERLINE = 16;		///< Fewest candidate line pairs (per line) for which overlap detection sweeps
+		static const size_t s_cLATTICEINTERVAL = 64;			///< Number of acids between retained gene lattice points
 
 		static const char s_chNULL = '\0';
 
@@ -142,6 +144,8 @@ namespace org_biologicinstitute_stylus
 		static const std::string s_strTRIAL;
 		static const std::string s_strHISTORY;
 		static const std::string s_strPLAN;
+		static const std::string s_strLINEAGE;
+		static const std::string s_strATTEMPT;
 		
 		static const std::string s_strENTER;
 		static const std::string s_strEXIT;
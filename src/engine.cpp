@@ -0,0 +1,984 @@
+/*******************************************************************************
+ * \file	engine.cpp
+ * \brief	Stylus Engine and GenomeContext classes
+ *
+ * Stylus, Copyright 2006-2009 Biologic Institute
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+// Includes ---------------------------------------------------------------------
+#include "headers.hpp"
+
+using namespace std;
+using namespace stylus;
+
+//--------------------------------------------------------------------------------
+//
+// GenomeContext
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: GenomeContext
+ *
+ * NOTES:
+ * - A new context matches the state Genome::initialize establishes
+ */
+GenomeContext::GenomeContext() :
+	_tLoaded(0L),
+	_fReady(false),
+	_rollbackType(RT_ATTEMPT),
+	_cRecordRate(0),
+	_grfRecordDetail(STRD_NONE),
+	_fRecordHistory(false),
+	_fGenesAssigned(false),
+	_fScoresCached(false),
+	_gsCurrent(STGS_DEAD),
+	_gaTermination(STGT_NONE),
+	_grTermination(STGR_NONE),
+	_mutationCallback(NULL)
+{
+	Genome::clearStatistics(_stats, 0);
+	Genome::clearStatistics(_statsRecordRate, 0);
+	_stats._cbBases = 0;
+	_statsRecordRate._cbBases = 0;
+
+	_grfGenesInvalid.set();
+
+#ifdef ST_DEBUG
+	_nFitnessPassing = 0;
+	_fTestingRollback = false;
+#endif
+}
+
+//--------------------------------------------------------------------------------
+//
+// Engine
+//
+//--------------------------------------------------------------------------------
+thread_local Engine* Engine::s_pEngine = NULL;
+
+/*
+ * Function: Engine
+ *
+ */
+Engine::Engine() :
+	_prgen(RGenerator::createInstance()),
+	_fBound(false)
+{
+	ENTER(GLOBAL,Engine);
+}
+
+/*
+ * Function: ~Engine
+ *
+ * NOTES:
+ * - Callers must unbind the engine before destroying it
+ */
+Engine::~Engine()
+{
+	ENTER(GLOBAL,~Engine);
+	ASSERT(!_fBound);
+
+	::delete _prgen;
+}
+
+/*
+ * Function: bind
+ *
+ * Bind the passed engine to the calling thread, first releasing any engine
+ * already bound. Passing NULL restores the thread's own (default) Genome.
+ */
+void
+Engine::bind(Engine* pEngine)
+{
+	ENTER(GLOBAL,bind);
+
+	if (pEngine == s_pEngine)
+		return;
+
+	if (Genome::getPlan().isExecuting())
+		THROWRC((RC(INEXECUTION), "Illegal attempt to change engines while executing a plan"));
+
+	if (VALID(pEngine) && pEngine->_fBound.exchange(true))
+		THROWRC((RC(INVALIDSTATE), "Engine is already bound to another thread"));
+
+	if (VALID(s_pEngine))
+	{
+		s_pEngine->exchange();
+		s_pEngine->_fBound = false;
+	}
+
+	s_pEngine = pEngine;
+
+	if (VALID(s_pEngine))
+	{
+		XMLDocument::initializeThread();
+		s_pEngine->exchange();
+	}
+
+	TFLOW(GLOBAL,L2,(LLTRACE, "Bound engine %p to the current thread", s_pEngine));
+}
+
+/*
+ * Function: exchange
+ *
+ * Exchange the engine state with that of the calling thread. Since exchanging
+ * twice restores the original state, the same routine serves to both bind and
+ * unbind the engine.
+ */
+void
+Engine::exchange()
+{
+	ENTER(GLOBAL,exchange);
+
+	Genome::exchangeContext(_gc);
+	RGenerator::exchangeInstance(_prgen);
+
+	Globals::enableTracing(Genome::getTrial(), Genome::getTrialAttempts());
+}
+
+//--------------------------------------------------------------------------------
+//
+// WorkerPool
+//
+//--------------------------------------------------------------------------------
+
+std::mutex WorkerPool::s_mutex;
+std::condition_variable WorkerPool::s_cvWork;
+std::condition_variable WorkerPool::s_cvDone;
+std::vector<std::thread> WorkerPool::s_vecThreads;
+size_t WorkerPool::s_cWorkers = 0;
+bool WorkerPool::s_fStopping = false;
+WorkerPool::JOBQUEUE WorkerPool::s_queJobs;
+thread_local bool WorkerPool::s_fWorker = false;
+
+/*
+ * Function: start
+ *
+ * Replace the workers with the passed number of workers (none if one or fewer)
+ */
+void
+WorkerPool::start(size_t cWorkers)
+{
+	ENTER(GLOBAL,start);
+
+	stop();
+
+	if (cWorkers <= 1)
+		return;
+
+	lock_guard<mutex> lock(s_mutex);
+	for (size_t iWorker=0; iWorker < cWorkers; ++iWorker)
+		s_vecThreads.push_back(thread(work));
+	s_cWorkers = cWorkers;
+}
+
+/*
+ * Function: stop
+ *
+ * Stop the workers once they complete the queued jobs
+ */
+void
+WorkerPool::stop()
+{
+	ENTER(GLOBAL,stop);
+
+	vector<thread> vecThreads;
+	{
+		lock_guard<mutex> lock(s_mutex);
+		s_cWorkers = 0;
+		s_fStopping = true;
+		vecThreads.swap(s_vecThreads);
+	}
+	s_cvWork.notify_all();
+
+	for (size_t iThread=0; iThread < vecThreads.size(); ++iThread)
+		vecThreads[iThread].join();
+
+	lock_guard<mutex> lock(s_mutex);
+	s_fStopping = false;
+}
+
+/*
+ * Function: execute
+ *
+ * Run each task, passing its index, on a worker thread and wait for all to
+ * complete. Workers take the next unstarted task until none remain; if any
+ * task fails, unstarted tasks are skipped and the first error is raised.
+ */
+void
+WorkerPool::execute(size_t cTasks, const std::function<void (size_t)>& fnTask)
+{
+	ENTER(GLOBAL,execute);
+
+	Job job;
+	job._pfnTask = &fnTask;
+	job._cTasks = cTasks;
+	job._iTaskNext = 0;
+	job._cTasksDone = 0;
+	job._fFailed = false;
+	job._e = Error(ST_RCSUCCESS);
+
+	{
+		unique_lock<mutex> lock(s_mutex);
+		if (s_fWorker || s_cWorkers <= 0)
+		{
+			lock.unlock();
+			executeOnThreads(cTasks, fnTask);
+			return;
+		}
+
+		if (cTasks <= 0)
+			return;
+
+		s_queJobs.push_back(&job);
+		s_cvWork.notify_all();
+		s_cvDone.wait(lock, [&]() { return job._cTasksDone >= job._cTasks; });
+	}
+
+	if (job._fFailed)
+		Error::safeThrow(Error::setNextError(job._e.getFileline(), job._e.getRetcode(), "%s", job._e.getDescription()));
+}
+
+/*
+ * Function: work
+ *
+ * Take tasks, one at a time, from the queued jobs until stopped
+ */
+void
+WorkerPool::work()
+{
+	s_fWorker = true;
+
+	unique_lock<mutex> lock(s_mutex);
+	for (;;)
+	{
+		s_cvWork.wait(lock, []() { return s_fStopping || !s_queJobs.empty(); });
+		if (s_queJobs.empty())
+			break;
+
+		Job& job = *s_queJobs.front();
+		size_t iTask = job._iTaskNext++;
+		if (job._iTaskNext >= job._cTasks)
+			s_queJobs.pop_front();
+
+		Error e(ST_RCSUCCESS);
+		if (!job._fFailed)
+		{
+			lock.unlock();
+			executeTask(*job._pfnTask, iTask, e);
+			lock.lock();
+		}
+
+		if (e.getRetcode() != ST_RCSUCCESS && !job._fFailed)
+		{
+			job._fFailed = true;
+			job._e = e;
+		}
+
+		if (++job._cTasksDone >= job._cTasks)
+			s_cvDone.notify_all();
+	}
+}
+
+/*
+ * Function: executeTask
+ *
+ * Run a task noting, rather than raising, any error
+ */
+void
+WorkerPool::executeTask(const std::function<void (size_t)>& fnTask, size_t iTask, Error& e)
+{
+	try
+	{
+		fnTask(iTask);
+	}
+	catch (const Error* pe)
+	{
+		e = *pe;
+	}
+	catch (std::exception& ex)
+	{
+		e = *Error::setNextError(ST_FILELINE, ST_RCERROR, "%s", ex.what());
+	}
+}
+
+/*
+ * Function: executeOnThreads
+ *
+ * Run the tasks on threads created for the call (used when the pool has no
+ * workers or when the caller is itself a worker)
+ */
+void
+WorkerPool::executeOnThreads(size_t cTasks, const std::function<void (size_t)>& fnTask)
+{
+	ENTER(GLOBAL,executeOnThreads);
+
+	atomic<size_t> iTaskNext(0);
+	atomic<bool> fFailed(false);
+	mutex mutexError;
+	Error e(ST_RCSUCCESS);
+
+	auto fnWorker = [&]()
+	{
+		for (size_t iTask = iTaskNext++; iTask < cTasks && !fFailed; iTask = iTaskNext++)
+		{
+			Error eTask(ST_RCSUCCESS);
+			executeTask(fnTask, iTask, eTask);
+			if (eTask.getRetcode() != ST_RCSUCCESS)
+			{
+				lock_guard<mutex> lock(mutexError);
+				if (!fFailed.exchange(true))
+					e = eTask;
+			}
+		}
+	};
+
+	vector<thread> vecThreads;
+	for (size_t iWorker=getWorkers(cTasks); iWorker > 0; --iWorker)
+		vecThreads.push_back(thread(fnWorker));
+	for (size_t iThread=0; iThread < vecThreads.size(); ++iThread)
+		vecThreads[iThread].join();
+
+	if (fFailed)
+		Error::safeThrow(Error::setNextError(e.getFileline(), e.getRetcode(), "%s", e.getDescription()));
+}
+
+//--------------------------------------------------------------------------------
+//
+// Speculation
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: Speculation
+ *
+ * Attempt substreams derive from a substream of the current generator named
+ * by the trial so that results are reproducible.
+ */
+Speculation::Speculation(size_t cAttempts) :
+	_cAttempts(cAttempts),
+	_prgenTrial(NULL),
+	_iAttempt(0),
+	_iAttemptFirst(0)
+{
+	ENTER(GLOBAL,Speculation);
+
+	if (_cAttempts > 0)
+	{
+		ostringstream ostrStream;
+		ostrStream << Constants::s_strTRIAL << Genome::getTrial();
+		_prgenTrial = RGenerator::createStream(ostrStream.str());
+	}
+}
+
+/*
+ * Function: ~Speculation
+ *
+ */
+Speculation::~Speculation()
+{
+	ENTER(GLOBAL,~Speculation);
+	::delete _prgenTrial;
+}
+
+/*
+ * Function: execute
+ *
+ * Execute the next attempt of the trial, taking the outcome of the attempt
+ * executed ahead if one exists. Attempts execute on the calling
+ * thread alone when too few workers exist or when a mutation callback is
+ * set (callbacks expect to run on the thread executing the plan).
+ *
+ * NOTES:
+ * - fSpeculated is set if the attempt failed while executed ahead (its
+ *   changes are already removed)
+ */
+bool
+Speculation::execute(Plan& plan, MutationSelector& mutationSelector, STFLAGS grfOptions, size_t iTrialInStep,
+					 bool& fRollbackPossible, bool& fSpeculated)
+{
+	ENTER(GLOBAL,execute);
+	ASSERT(isEnabled());
+
+	fSpeculated = false;
+
+	if (WorkerPool::getWorkers(_cAttempts) > 1 && !VALID(Genome::_mutationCallback))
+	{
+		if (_iAttempt >= _iAttemptFirst + _vecAttempts.size())
+			speculate(plan, grfOptions, iTrialInStep);
+
+		// Merge a failed attempt into the Genome as though executed by the calling thread
+		size_t iAhead = _iAttempt - _iAttemptFirst;
+		Attempt& attempt = _vecAttempts[iAhead];
+		if (!attempt._fSuccess)
+		{
+			ST_STATISTICS stats(_stats);
+			ST_STATISTICS statsRecordRate(_statsRecordRate);
+			stats._cTrialAttempts += iAhead;
+			statsRecordRate._cTrialAttempts += iAhead;
+			Genome::mergeContext(attempt._gc, stats, statsRecordRate);
+
+			if (attempt._gc._gaTermination != STGT_NONE)
+				Genome::recordTermination(attempt._gc._gaTermination, attempt._gc._grTermination, attempt._gc._dsTermination);
+			Globals::enableTracing(Genome::getTrial(), Genome::getTrialAttempts());
+
+			fRollbackPossible = attempt._fRollbackPossible;
+			fSpeculated = true;
+			++_iAttempt;
+			return false;
+		}
+
+		// Adopt the successful attempt (discarding those beyond it)
+		ST_STATISTICS stats(_stats);
+		ST_STATISTICS statsRecordRate(_statsRecordRate);
+		stats._cTrialAttempts += iAhead;
+		statsRecordRate._cTrialAttempts += iAhead;
+		Genome::adoptContext(attempt._gc, stats, statsRecordRate);
+		plan.adoptConditions(attempt._gc._plan);
+		Globals::enableTracing(Genome::getTrial(), Genome::getTrialAttempts());
+
+		fRollbackPossible = attempt._fRollbackPossible;
+		_vecAttempts.clear();
+		++_iAttempt;
+		return true;
+	}
+
+	return executeAttempt(plan, mutationSelector, grfOptions, iTrialInStep, _iAttempt++, fRollbackPossible);
+}
+
+/*
+ * Function: speculate
+ *
+ * Execute the next set of attempts, each against a copy of the Genome, on
+ * worker threads. Failed attempts are rolled back by the worker.
+ */
+void
+Speculation::speculate(Plan& plan, STFLAGS grfOptions, size_t iTrialInStep)
+{
+	ENTER(GLOBAL,speculate);
+
+	_iAttemptFirst = _iAttempt;
+	_vecAttempts.clear();
+	_vecAttempts.resize(_cAttempts);
+
+	_stats = Genome::_stats;
+	_statsRecordRate = Genome::_statsRecordRate;
+
+	for (size_t iAhead=0; iAhead < _vecAttempts.size(); ++iAhead)
+	{
+		Genome::copyContext(_vecAttempts[iAhead]._gc);
+		_vecAttempts[iAhead]._gc._plan = plan;
+		_vecAttempts[iAhead]._gc._plan.endExecution();
+	}
+
+	WorkerPool::execute(_vecAttempts.size(), [&](size_t iAhead)
+	{
+		Attempt& attempt = _vecAttempts[iAhead];
+
+		Genome::exchangeContext(attempt._gc);
+		try
+		{
+			// Count the attempts preceding this one
+			Genome::_stats._cTrialAttempts += iAhead;
+			Genome::_statsRecordRate._cTrialAttempts += iAhead;
+
+			MutationSelector mutationSelector(Genome::_plan);
+			attempt._fSuccess = executeAttempt(Genome::_plan, mutationSelector, grfOptions, iTrialInStep,
+											   _iAttemptFirst + iAhead, attempt._fRollbackPossible);
+			if (!attempt._fSuccess)
+				Genome::rollback();
+		}
+		catch (...)
+		{
+			Genome::exchangeContext(attempt._gc);
+			throw;
+		}
+		Genome::exchangeContext(attempt._gc);
+	});
+}
+
+/*
+ * Function: executeAttempt
+ *
+ * Execute the passed attempt of the trial using the random generator for its
+ * substream.
+ */
+bool
+Speculation::executeAttempt(Plan& plan, MutationSelector& mutationSelector, STFLAGS grfOptions, size_t iTrialInStep,
+							size_t iAttempt, bool& fRollbackPossible) const
+{
+	ENTER(GLOBAL,executeAttempt);
+
+	ostringstream ostrStream;
+	ostrStream << Constants::s_strATTEMPT << iAttempt;
+
+	IRandom* prgen = _prgenTrial->createStream(ostrStream.str());
+	RGenerator::exchangeInstance(prgen);
+
+	bool fSuccess = false;
+	try
+	{
+		fSuccess = plan.executeAttempt(mutationSelector, grfOptions, iTrialInStep);
+		fRollbackPossible = mutationSelector.getRollbackPossible();
+	}
+	catch (...)
+	{
+		RGenerator::exchangeInstance(prgen);
+		::delete prgen;
+		throw;
+	}
+	RGenerator::exchangeInstance(prgen);
+	::delete prgen;
+
+	return fSuccess;
+}
+
+//--------------------------------------------------------------------------------
+//
+// Population
+//
+//--------------------------------------------------------------------------------
+thread_local Population* Population::s_pPopulation = NULL;
+thread_local size_t Population::s_iLineage = 0;
+
+/*
+ * Function: Population
+ *
+ */
+Population::Population(size_t cLineages, size_t iTrialFirst, size_t cMigrationInterval, UNIT nTemperatureRatio) :
+	_vecLineages(cLineages),
+	_iTrialFirst(iTrialFirst),
+	_cMigrationInterval(cMigrationInterval),
+	_nTemperatureRatio(nTemperatureRatio),
+	_prgenExchange(NULL),
+	_cThreads(Globals::getThreadCount()),
+	_cActive(cLineages),
+	_cMigrating(0),
+	_cMigrations(0),
+	_fTerminated(false),
+	_fFailed(false),
+	_e(ST_RCSUCCESS)
+{
+	ENTER(GLOBAL,Population);
+
+	for (size_t iLineage=0; iLineage < _vecLineages.size(); ++iLineage)
+	{
+		_vecLineages[iLineage]._pEngine = NULL;
+		_vecLineages[iLineage]._iImmigrant = iLineage;
+		_vecLineages[iLineage]._fMigrating = false;
+		_vecLineages[iLineage]._nTemperature = 0.0;
+		Genome::clearStatistics(_vecLineages[iLineage]._stats, 0);
+	}
+}
+
+/*
+ * Function: ~Population
+ *
+ */
+Population::~Population()
+{
+	ENTER(GLOBAL,~Population);
+
+	for (size_t iLineage=0; iLineage < _vecLineages.size(); ++iLineage)
+		::delete _vecLineages[iLineage]._pEngine;
+	::delete _prgenExchange;
+}
+
+/*
+ * Function: execute
+ *
+ * Execute the loaded plan across a population of lineages (see the plan
+ * population option). The calling thread executes the first lineage, which
+ * alone receives status callbacks; the others each execute on a thread of
+ * their own and record (if recording) into a sub-directory of the record
+ * directory named for the lineage.
+ */
+void
+Population::execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t cStatusRate)
+{
+	ENTER(GLOBAL,execute);
+	ASSERT(!VALID(s_pPopulation));
+
+	const Plan& plan = Genome::getPlan();
+	Population population(plan.getPopulation(), iTrialFirst, plan.getMigrationInterval(), plan.getTemperatureRatio());
+
+	LOGINFO((LLINFO, "Plan will evolve %lu lineages migrating every %lu trials", population._vecLineages.size(), population._cMigrationInterval));
+
+	if (population._nTemperatureRatio > 0.0)
+	{
+		LOGINFO((LLINFO, "Lineages will exchange replicas with a temperature ratio of %f", population._nTemperatureRatio));
+		population._prgenExchange = RGenerator::createStream(xmlTag(XT_TEMPERATURERATIO));
+	}
+
+	// Create the remaining lineages, each a copy of the genome with its own random generator
+	// - Generators are substreams of the current generator so that results are reproducible
+	for (size_t iLineage=1; iLineage < population._vecLineages.size(); ++iLineage)
+	{
+		Engine* pEngine = ::new Engine();
+		population._vecLineages[iLineage]._pEngine = pEngine;
+
+		Genome::cloneContext(pEngine->_gc);
+
+		ostringstream ostrStream;
+		ostrStream << Constants::s_strLINEAGE << iLineage;
+		IRandom* prgen = RGenerator::createStream(ostrStream.str());
+		std::swap(pEngine->_prgen, prgen);
+		::delete prgen;
+
+		if (population._nTemperatureRatio > 0.0)
+			pEngine->_gc._plan.scaleTemperatures(::pow(population._nTemperatureRatio, static_cast<UNIT>(iLineage)));
+
+		if (!pEngine->_gc._strRecordDirectory.empty())
+		{
+			ostringstream ostrDirectory;
+			ostrDirectory
+				<< pEngine->_gc._strRecordDirectory
+				<< Constants::s_strLINEAGE
+				<< iLineage;
+
+			if (::mkdir(ostrDirectory.str().c_str(), 0777) != 0 && errno != EEXIST)
+				THROWRC((RC(ERROR), "Unable to create lineage record directory %s", ostrDirectory.str().c_str()));
+
+			pEngine->_gc._strRecordDirectory = ostrDirectory.str();
+			terminatePath(pEngine->_gc._strRecordDirectory);
+		}
+	}
+
+	// Execute all lineages and wait for them to complete
+	vector<thread> vecThreads;
+	for (size_t iLineage=1; iLineage < population._vecLineages.size(); ++iLineage)
+		vecThreads.push_back(thread(&Population::executeLineage, &population, iLineage, iTrialFirst, cTrials, static_cast<ST_PFNSTATUS>(NULL), cStatusRate));
+	population.executeLineage(0, iTrialFirst, cTrials, pfnStatus, cStatusRate);
+	for (size_t iThread=0; iThread < vecThreads.size(); ++iThread)
+		vecThreads[iThread].join();
+
+	if (population._fFailed)
+		Error::safeThrow(Error::setNextError(population._e.getFileline(), population._e.getRetcode(), "%s", population._e.getDescription()));
+
+	// Save the statistics of each lineage and adopt the most fit lineage
+	size_t iFittest = 0;
+	Genome::_vecLineageStatistics.resize(population._vecLineages.size());
+	for (size_t iLineage=0; iLineage < population._vecLineages.size(); ++iLineage)
+	{
+		const Lineage& lineage = population._vecLineages[iLineage];
+
+		Genome::_vecLineageStatistics[iLineage] = lineage._stats;
+		if (	lineage._gcMigrant._gsCurrent == STGS_ALIVE
+			&&	lineage._stats._nFitness > population._vecLineages[iFittest]._stats._nFitness)
+			iFittest = iLineage;
+	}
+
+	if (iFittest != 0 && Genome::isState(STGS_ALIVE))
+		Genome::adoptContext(population._vecLineages[iFittest]._gcMigrant, iFittest);
+}
+
+/*
+ * Function: terminate
+ *
+ * End execution of the population (if any) executing on the calling thread.
+ * Other lineages end upon completing their current trial.
+ */
+void
+Population::terminate()
+{
+	ENTER(GLOBAL,terminate);
+
+	if (!VALID(s_pPopulation))
+		return;
+
+	lock_guard<mutex> lock(s_pPopulation->_mutex);
+	s_pPopulation->_fTerminated = true;
+	s_pPopulation->_cv.notify_all();
+}
+
+/*
+ * Function: executeLineage
+ *
+ * Execute the loaded plan for a single lineage. Errors are saved, rather than
+ * raised, so that the calling thread may wait for all lineages to complete.
+ */
+void
+Population::executeLineage(size_t iLineage, size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t cStatusRate)
+{
+	ENTER(GLOBAL,executeLineage);
+
+	Lineage& lineage = _vecLineages[iLineage];
+
+	{
+		unique_lock<mutex> lock(_mutex);
+		acquireThread(lock);
+	}
+
+	Error e(ST_RCSUCCESS);
+	WorkerPool::executeTask([&](size_t iTask)
+	{
+		if (VALID(lineage._pEngine))
+		{
+			Engine::bind(lineage._pEngine);
+			Genome::recordPlan(Genome::RT_INITIAL);
+		}
+
+		s_pPopulation = this;
+		s_iLineage = iTask;
+
+		Genome::_plan.execute(iTrialFirst, cTrials, pfnStatus, cStatusRate);
+
+		s_pPopulation = NULL;
+
+		if (VALID(lineage._pEngine))
+			Genome::recordPlan(Genome::RT_FINAL);
+
+		Genome::cloneContext(lineage._gcMigrant);
+		Genome::getStatistics(&lineage._stats);
+	}, iLineage, e);
+
+	if (e.getRetcode() != ST_RCSUCCESS)
+		fail(e);
+
+	s_pPopulation = NULL;
+	if (VALID(lineage._pEngine) && lineage._pEngine->isBound())
+		Engine::bind(NULL);
+
+	leave();
+}
+
+/*
+ * Function: migrate
+ *
+ * Called by each lineage as it completes a trial. At each migration interval,
+ * wait for all other lineages to arrive, exchange genomes, and adopt the
+ * genome (if any) received. Returns false if the population has ended.
+ */
+bool
+Population::migrate()
+{
+	ENTER(GLOBAL,migrate);
+
+	if (_fTerminated)
+		return false;
+
+	if (_cMigrationInterval <= 0 || ((Genome::getTrial() + 1 - _iTrialFirst) % _cMigrationInterval) != 0)
+		return true;
+
+	Lineage& lineage = _vecLineages[s_iLineage];
+	Genome::cloneContext(lineage._gcMigrant);
+
+	size_t iImmigrant;
+	{
+		unique_lock<mutex> lock(_mutex);
+		size_t cMigrations = _cMigrations;
+
+		lineage._nTemperature = Genome::_plan.getTemperature();
+		lineage._fMigrating = true;
+		++_cMigrating;
+		releaseThread();
+
+		if (_cMigrating >= _cActive)
+			exchangeMigrants();
+		else
+			_cv.wait(lock, [&]() { return _cMigrations != cMigrations || _fTerminated; });
+
+		acquireThread(lock);
+
+		if (_fTerminated)
+			return false;
+		iImmigrant = lineage._iImmigrant;
+	}
+
+	if (iImmigrant != s_iLineage)
+	{
+		Genome::adoptContext(lineage._gcImmigrant, iImmigrant);
+		Genome::_plan.resetAnnealing();
+	}
+	return true;
+}
+
+/*
+ * Function: exchangeMigrants
+ *
+ * Offer each migrating lineage the genome of the preceding migrating lineage
+ * (wrapping from the first to the last) if that genome is more fit.
+ *
+ * NOTES:
+ * - The caller must hold the population lock
+ */
+void
+Population::exchangeMigrants()
+{
+	ENTER(GLOBAL,exchangeMigrants);
+
+	if (_nTemperatureRatio > 0.0)
+		exchangeReplicas();
+
+	else
+	{
+		size_t iPrevious = _vecLineages.size();
+		for (size_t iLineage=_vecLineages.size(); iLineage > 0 && iPrevious >= _vecLineages.size(); --iLineage)
+		{
+			if (_vecLineages[iLineage-1]._fMigrating)
+				iPrevious = iLineage-1;
+		}
+
+		for (size_t iLineage=0; iLineage < _vecLineages.size(); ++iLineage)
+		{
+			Lineage& lineage = _vecLineages[iLineage];
+			if (!lineage._fMigrating)
+				continue;
+
+			const Lineage& lineagePrevious = _vecLineages[iPrevious];
+			lineage._iImmigrant = iLineage;
+			if (lineagePrevious._gcMigrant._stats._nFitness > lineage._gcMigrant._stats._nFitness)
+			{
+				lineage._gcImmigrant = lineagePrevious._gcMigrant;
+				lineage._iImmigrant = iPrevious;
+			}
+			iPrevious = iLineage;
+		}
+	}
+
+	for (size_t iLineage=0; iLineage < _vecLineages.size(); ++iLineage)
+		_vecLineages[iLineage]._fMigrating = false;
+
+	_cMigrating = 0;
+	++_cMigrations;
+	_cv.notify_all();
+}
+
+/*
+ * Function: exchangeReplicas
+ *
+ * Pair neighbouring migrating lineages, alternating with each migration
+ * whether pairing begins with the first or second, and swap the genomes of
+ * each pair by the Metropolis criterion: always if the hotter lineage holds
+ * the more fit genome, otherwise with probability
+ * exp((1/T(cold) - 1/T(hot)) * (fitness(hot) - fitness(cold))).
+ *
+ * NOTES:
+ * - The caller must hold the population lock
+ * - Lineages without a temperature swap only to gain fitness
+ */
+void
+Population::exchangeReplicas()
+{
+	ENTER(GLOBAL,exchangeReplicas);
+	ASSERT(VALID(_prgenExchange));
+
+	vector<size_t> vecMigrating;
+	for (size_t iLineage=0; iLineage < _vecLineages.size(); ++iLineage)
+	{
+		if (_vecLineages[iLineage]._fMigrating)
+		{
+			_vecLineages[iLineage]._iImmigrant = iLineage;
+			vecMigrating.push_back(iLineage);
+		}
+	}
+
+	for (size_t iPair=(_cMigrations % 2); iPair+1 < vecMigrating.size(); iPair += 2)
+	{
+		size_t iCold = vecMigrating[iPair];
+		size_t iHot = vecMigrating[iPair+1];
+		Lineage& lineageCold = _vecLineages[iCold];
+		Lineage& lineageHot = _vecLineages[iHot];
+
+		UNIT nFitnessCold = lineageCold._gcMigrant._stats._nFitness;
+		UNIT nFitnessHot = lineageHot._gcMigrant._stats._nFitness;
+
+		bool fExchange = (nFitnessHot > nFitnessCold);
+		if (!fExchange && lineageCold._nTemperature > 0.0 && lineageHot._nTemperature > 0.0)
+		{
+			UNIT nExponent = ((1.0 / lineageCold._nTemperature) - (1.0 / lineageHot._nTemperature)) * (nFitnessHot - nFitnessCold);
+			fExchange = (_prgenExchange->getUniform() < ::exp(nExponent));
+		}
+
+		if (fExchange)
+		{
+			lineageCold._gcImmigrant = lineageHot._gcMigrant;
+			lineageCold._iImmigrant = iHot;
+			lineageHot._gcImmigrant = lineageCold._gcMigrant;
+			lineageHot._iImmigrant = iCold;
+		}
+	}
+}
+
+/*
+ * Function: leave
+ *
+ * Remove a completed lineage from the population, completing any migration
+ * that was waiting only on it.
+ */
+void
+Population::leave()
+{
+	ENTER(GLOBAL,leave);
+
+	lock_guard<mutex> lock(_mutex);
+
+	--_cActive;
+	releaseThread();
+
+	if (!_fTerminated && _cMigrating > 0 && _cMigrating >= _cActive)
+		exchangeMigrants();
+}
+
+/*
+ * Function: fail
+ *
+ * Save the first error raised by any lineage and end the population.
+ */
+void
+Population::fail(const Error& e)
+{
+	ENTER(GLOBAL,fail);
+
+	lock_guard<mutex> lock(_mutex);
+
+	if (!_fFailed)
+	{
+		_fFailed = true;
+		_e = e;
+	}
+
+	_fTerminated = true;
+	_cv.notify_all();
+}
+
+/*
+ * Function: acquireThread
+ *
+ * Wait until a thread is available to run the calling lineage.
+ *
+ * NOTES:
+ * - The passed lock must hold the population lock
+ */
+void
+Population::acquireThread(unique_lock<mutex>& lock)
+{
+	_cv.wait(lock, [this]() { return _cThreads > 0; });
+	--_cThreads;
+}
+
+/*
+ * Function: releaseThread
+ *
+ * NOTES:
+ * - The caller must hold the population lock
+ */
+void
+Population::releaseThread()
+{
+	++_cThreads;
+	_cv.notify_all();
+}
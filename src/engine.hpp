@@ -0,0 +1,295 @@
+/*******************************************************************************
+ * \file	engine.hpp
+ * \brief	Stylus Engine and GenomeContext classes
+ *
+ * An Engine holds one genome (along with its plan, statistics, and random
+ * generator) and allows a single process to host several genomes. The Genome
+ * itself remains a static object whose members are thread-local; binding an
+ * engine to a thread exchanges the engine's saved state with that of the
+ * thread's Genome. Immutable data (e.g., loaded Han definitions and global
+ * weights) is shared by all engines.
+ *
+ * Stylus, Copyright 2006-2009 Biologic Institute
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+namespace org_biologicinstitute_stylus
+{
+	/**
+	 * \brief The saved state of a Genome
+	 *
+	 * A GenomeContext holds, member for member, the state of a Genome while it
+	 * is not bound to a thread. Binding exchanges the context with the thread's
+	 * Genome (see Genome::exchangeContext).
+	 */
+	class GenomeContext
+	{
+		friend class Genome;
+		friend class Population;
+		friend class Speculation;
+
+	public:
+		GenomeContext();
+
+	private:
+		std::string _strAuthor;
+		CodonTable _ct;
+		BaseSequence _seqBases;
+		utime _tLoaded;
+
+		std::string _strUUID;
+		std::string _strStrain;
+		std::string _strAncestors;
+
+		bool _fReady;
+		ROLLBACKTYPE _rollbackType;
+
+		Plan _plan;
+
+		ST_STATISTICS _stats;
+		ST_STATISTICS _statsRecordRate;
+		STATISTICSARRAY _vecLineageStatistics;
+
+		size_t _cRecordRate;
+		STFLAGS _grfRecordDetail;
+		std::string _strRecordDirectory;
+
+		size_t _fRecordHistory;
+
+		bool _fGenesAssigned;
+		GENEARRAY _vecGenes;
+		std::bitset<Genome::s_maxGENES> _grfGenesInvalid;
+
+		FitnessCache _cacheFitness;
+		bool _fScoresCached;
+
+		ModificationStack _msModifications;
+		AttemptHistory _ahAttempts;
+		AttemptHistory _ahConsiderations;
+
+		ST_GENOMESTATE _gsCurrent;
+
+		ST_GENOMETERMINATION _gaTermination;
+		ST_GENOMEREASON _grTermination;
+		Description _dsTermination;
+		ST_PFNSTATUS _mutationCallback;
+		std::string _mutationFullString;
+
+#ifdef ST_DEBUG
+		Unit _nFitnessPassing;
+		bool _fTestingRollback;
+#endif
+	};
+
+	/**
+	 * \brief A Stylus engine
+	 *
+	 * Each engine owns a genome and random generator. Engines are bound to at
+	 * most one thread at a time; threads that do not bind an engine use their
+	 * own (default) Genome, established by Globals::initializeThread.
+	 */
+	class Engine
+	{
+		friend class Population;
+
+	public:
+		Engine();
+		~Engine();
+
+		bool isBound() const;
+
+		static Engine* getBound();
+		static void bind(Engine* pEngine);
+
+	private:
+		GenomeContext _gc;					///< Genome state while not bound
+		IRandom* _prgen;					///< Random generator while not bound
+		std::atomic<bool> _fBound;			///< Engine is bound to a thread
+
+		void exchange();
+
+		static thread_local Engine* s_pEngine;	///< Engine bound to the current thread (if any)
+	};
+
+	/**
+	 * \brief A pool of worker threads
+	 *
+	 * The pool runs a set of independent tasks across, at most, the number of
+	 * threads allowed by Globals::getThreadCount(). Tasks always run on worker
+	 * threads (never the caller), so each may exchange the thread-local Genome
+	 * freely. Errors raised by tasks are raised again on the calling thread
+	 * once all workers complete.
+	 *
+	 * The workers are started when the thread count is set (see stSetThreads)
+	 * and wait between calls; callers on several threads share them. Tasks
+	 * that themselves run tasks do so on threads created for the call.
+	 */
+	class WorkerPool
+	{
+		friend class Population;
+
+	public:
+		static size_t getWorkers(size_t cTasks);
+		static void start(size_t cWorkers);
+		static void stop();
+		static void execute(size_t cTasks, const std::function<void (size_t)>& fnTask);
+
+	private:
+		struct Job
+		{
+			const std::function<void (size_t)>* _pfnTask;
+			size_t _cTasks;
+			size_t _iTaskNext;					///< Next task to start
+			size_t _cTasksDone;					///< Tasks completed (or skipped)
+			bool _fFailed;						///< A task raised an error
+			Error _e;							///< First error raised by a task
+		};
+		typedef std::deque<Job*> JOBQUEUE;
+
+		static std::mutex s_mutex;
+		static std::condition_variable s_cvWork;
+		static std::condition_variable s_cvDone;
+		static std::vector<std::thread> s_vecThreads;
+		static size_t s_cWorkers;				///< Workers accepting jobs (zero while stopping)
+		static bool s_fStopping;
+		static JOBQUEUE s_queJobs;
+		static thread_local bool s_fWorker;		///< Current thread is a worker
+
+		static void work();
+		static void executeTask(const std::function<void (size_t)>& fnTask, size_t iTask, Error& e);
+		static void executeOnThreads(size_t cTasks, const std::function<void (size_t)>& fnTask);
+	};
+
+	/**
+	 * \brief Trial attempts executed ahead of need
+	 *
+	 * When most attempts of a trial fail (and are rolled back), the attempts
+	 * may be executed ahead, several at once, on worker threads. Each attempt
+	 * draws from a substream of the trial's random numbers named by the
+	 * attempt number, so the outcome of an attempt does not depend upon which thread executed
+	 * it. Failed attempts are merged into the Genome, in order, as though the
+	 * calling thread had made them; the Genome adopts the first successful
+	 * attempt (discarding those executed beyond it).
+	 */
+	class Speculation
+	{
+	public:
+		Speculation(size_t cAttempts);
+		~Speculation();
+
+		bool isEnabled() const;
+		bool execute(Plan& plan, MutationSelector& mutationSelector, STFLAGS grfOptions, size_t iTrialInStep,
+					 bool& fRollbackPossible, bool& fSpeculated);
+
+	private:
+		struct Attempt
+		{
+			GenomeContext _gc;					///< Genome after the attempt (changes removed if it failed)
+			bool _fSuccess;						///< Attempt succeeded
+			bool _fRollbackPossible;			///< Attempt may be rolled back and tried again
+		};
+		typedef std::vector<Attempt> ATTEMPTARRAY;
+
+		size_t _cAttempts;						///< Attempts to execute at once
+		IRandom* _prgenTrial;					///< Generator from which each attempt's substream derives
+		size_t _iAttempt;						///< Next attempt of the trial
+		size_t _iAttemptFirst;					///< Attempt held by the first executed attempt
+		ATTEMPTARRAY _vecAttempts;				///< Attempts executed ahead
+		ST_STATISTICS _stats;					///< Genome statistics before executing ahead
+		ST_STATISTICS _statsRecordRate;			///< Genome record rate statistics before executing ahead
+
+		void speculate(Plan& plan, STFLAGS grfOptions, size_t iTrialInStep);
+		bool executeAttempt(Plan& plan, MutationSelector& mutationSelector, STFLAGS grfOptions, size_t iTrialInStep,
+							size_t iAttempt, bool& fRollbackPossible) const;
+	};
+
+	/**
+	 * \brief A population of lineages evolved under one plan
+	 *
+	 * A population evolves several copies (lineages) of the genome, each with
+	 * its own random generator, under the loaded plan. The first lineage is the
+	 * calling thread's Genome; each of the others is held by an Engine bound to
+	 * a thread of its own. At most Globals::getThreadCount() lineages run at
+	 * once; a lineage waiting to migrate yields its thread to the others.
+	 *
+	 * Every migration interval, the lineages meet and each adopts the genome of
+	 * the preceding lineage (in a ring) if that genome is more fit. Since
+	 * lineages migrate only at trial boundaries and in a fixed order, results
+	 * do not depend on thread scheduling. Once all lineages complete, the
+	 * Genome adopts the most fit lineage.
+	 *
+	 * Given a temperature ratio, the population instead exchanges replicas
+	 * (parallel tempering): each lineage anneals at the plan's temperatures
+	 * scaled by the ratio raised to the lineage number and, when meeting,
+	 * neighbouring lineages swap genomes by the Metropolis criterion.
+	 */
+	class Population
+	{
+	public:
+		static void execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t cStatusRate);
+
+		static bool completeTrial();
+		static void terminate();
+
+	private:
+		struct Lineage
+		{
+			Engine* _pEngine;					///< Engine holding the lineage (NULL for the first lineage)
+			GenomeContext _gcMigrant;			///< Genome offered at the last migration (or upon completion)
+			GenomeContext _gcImmigrant;			///< Genome to adopt from the preceding lineage
+			size_t _iImmigrant;					///< Lineage supplying the genome to adopt
+			bool _fMigrating;					///< Lineage is waiting to migrate
+			UNIT _nTemperature;					///< Temperature of the lineage at the last migration
+			ST_STATISTICS _stats;				///< Statistics upon completion
+		};
+		typedef std::vector<Lineage> LINEAGEARRAY;
+
+		LINEAGEARRAY _vecLineages;
+		size_t _iTrialFirst;					///< First trial of the plan
+		size_t _cMigrationInterval;				///< Trials between migrations
+		UNIT _nTemperatureRatio;				///< Temperature ratio of successive lineages (zero if not exchanging replicas)
+		IRandom* _prgenExchange;				///< Generator deciding replica exchanges
+
+		std::mutex _mutex;
+		std::condition_variable _cv;
+		size_t _cThreads;						///< Threads available to run lineages
+		size_t _cActive;						///< Lineages not yet completed
+		size_t _cMigrating;						///< Lineages waiting to migrate
+		size_t _cMigrations;					///< Migrations completed
+		std::atomic<bool> _fTerminated;			///< Population asked to end
+		bool _fFailed;							///< A lineage raised an error
+		Error _e;								///< First error raised by a lineage
+
+		Population(size_t cLineages, size_t iTrialFirst, size_t cMigrationInterval, UNIT nTemperatureRatio);
+		~Population();
+
+		void executeLineage(size_t iLineage, size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t cStatusRate);
+		bool migrate();
+		void exchangeMigrants();
+		void exchangeReplicas();
+		void leave();
+		void fail(const Error& e);
+
+		void acquireThread(std::unique_lock<std::mutex>& lock);
+		void releaseThread();
+
+		static thread_local Population* s_pPopulation;	///< Population executing on the current thread (if any)
+		static thread_local size_t s_iLineage;			///< Lineage executing on the current thread
+	};
+
+}	// namespace org_biologicinstitute_stylus
+#endif // ENGINE_HPP
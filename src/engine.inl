@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * \file	engine.inl
+ * \brief	Stylus Engine class inline methods
+ *
+ * Stylus, Copyright 2006-2009 Biologic Institute
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+using namespace std;
+using namespace stylus;
+
+//--------------------------------------------------------------------------------
+//
+// Engine
+//
+//--------------------------------------------------------------------------------
+inline bool Engine::isBound() const { return _fBound; }
+
+inline Engine* Engine::getBound() { return s_pEngine; }
+
+//--------------------------------------------------------------------------------
+//
+// WorkerPool
+//
+//--------------------------------------------------------------------------------
+inline size_t WorkerPool::getWorkers(size_t cTasks) { return min<size_t>(Globals::getThreadCount(), cTasks); }
+
+//--------------------------------------------------------------------------------
+//
+// Speculation
+//
+//--------------------------------------------------------------------------------
+inline bool Speculation::isEnabled() const { return (_cAttempts > 0); }
+
+//--------------------------------------------------------------------------------
+//
+// Population
+//
+//--------------------------------------------------------------------------------
+inline bool Population::completeTrial() { return (!VALID(s_pPopulation) || s_pPopulation->migrate()); }
@@ -24,11 +24,11 @@
 using namespace std;
 using namespace stylus;
 
-char Error::s_szBuffer[Constants::s_cbmaxBUFFER];
+thread_local char Error::s_szBuffer[Constants::s_cbmaxBUFFER];
 
-Error Error::s_aryErrors[10];
-size_t Error::s_iError = 0;
-size_t Error::s_cErrors = 0;
+thread_local Error Error::s_aryErrors[10];
+thread_local size_t Error::s_iError = 0;
+thread_local size_t Error::s_cErrors = 0;
 
 /*
  * Function: setNextError
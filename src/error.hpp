@@ -91,11 +91,11 @@ namespace org_biologicinstitute_stylus
 	private:
 		static const char s_szERRORHEADER[];
 
-		static char s_szBuffer[Constants::s_cbmaxBUFFER];
+		static thread_local char s_szBuffer[Constants::s_cbmaxBUFFER];
 
-		static Error s_aryErrors[10];
-		static size_t s_iError;
-		static size_t s_cErrors;
+		static thread_local Error s_aryErrors[10];
+		static thread_local size_t s_iError;
+		static thread_local size_t s_cErrors;
 		
 		Error(const Error& e) throw();
 
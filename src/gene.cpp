@@ -78,6 +78,9 @@ Stroke::operator=(const Stroke& st)
 
 	_rectBounds = st._rectBounds;
 
+	_sxIsInherited = st._sxIsInherited;
+	_syIsInherited = st._syIsInherited;
+
 	_slVectors = st._slVectors;
 
 	_sxToHan = st._sxToHan;
@@ -87,6 +90,9 @@ Stroke::operator=(const Stroke& st)
 	_dxToHan = st._dxToHan;
 	_dyToHan = st._dyToHan;
 
+	_dxParentToHan = st._dxParentToHan;
+	_dyParentToHan = st._dyParentToHan;
+
 	_nExtraLength = st._nExtraLength;
 	_nDeviation = st._nDeviation;
 
@@ -290,14 +296,22 @@ Gene::operator=(const Gene& gene)
 	_grfInvalid = gene._grfInvalid;
 
 	_vecAcids = gene._vecAcids;
-	_vecPoints = gene._vecPoints;
+	_vecLattice = gene._vecLattice;
+	_cLattice = gene._cLattice;
+	_vecX = gene._vecX;
+	_vecY = gene._vecY;
 	_vecCoherent = gene._vecCoherent;
 
 	_vecSegments = gene._vecSegments;
 	_cCoherent = gene._cCoherent;
 	_nUnits = gene._nUnits;
 
+	_rgAcidsDirty = gene._rgAcidsDirty;
+	_dAcidsDirty = gene._dAcidsDirty;
+	_fInternalStop = gene._fInternalStop;
+
 	_strUnicode = gene._strUnicode;
+	_vecHOverlaps = gene._vecHOverlaps;
 
 	_vecGroups = gene._vecGroups;
 
@@ -309,6 +323,11 @@ Gene::operator=(const Gene& gene)
 
 	_vecMarks = gene._vecMarks;
 	_setOverlaps = gene._setOverlaps;
+	_vecOverlapRanges = gene._vecOverlapRanges;
+	_vecOverlapOrigins = gene._vecOverlapOrigins;
+	_vecOverlapCrossings = gene._vecOverlapCrossings;
+	_rgOverlapsDirty = gene._rgOverlapsDirty;
+	_dOverlapsDirty = gene._dOverlapsDirty;
 	_vecMissingOverlaps = gene._vecMissingOverlaps;
 	_vecIllegalOverlaps = gene._vecIllegalOverlaps;
 
@@ -324,6 +343,7 @@ Gene::operator=(const Gene& gene)
 
 	::memcpy(_aryScoreExponents, gene._aryScoreExponents, ARRAY_SIZE(_aryScoreExponents));
 	_nScore = gene._nScore;
+	_fScoreBounded = gene._fScoreBounded;
 
 	return *this;
 }
@@ -455,7 +475,7 @@ Gene::setRange(const Range& rgBases)
 {
 	ENTER(GENOME,setRange);
 
-	ASSERT(rgBases.isEmpty() || Codon::isStop(Genome::getBases().c_str()+rgBases.getEnd()-2));
+	ASSERT(rgBases.isEmpty() || Codon::isStop(Genome::getBaseSequence().view(rgBases.getEnd()-2, Codon::s_cchCODON)));
 
 	_rgBases = rgBases;
 
@@ -502,8 +522,8 @@ Gene::markInvalid(GENECHANGE gc, const Range& rg, bool fSilent)
 
 	// Otherwise, adjust arrays and stroke ranges to accommodate insertions and deletions
 	// - Fix-up acids and points if possible
-	// - More complex fix-up (such as recalculating coherence on sub-regions) tends to be
-	//   error prone and, more importantly, of very little performance benefit
+	// - Note the changed acids so that coherence and segments are recomputed only around
+	//   them (see ensureCoherence and ensureSegments)
 
 	else
 	{
@@ -517,15 +537,18 @@ Gene::markInvalid(GENECHANGE gc, const Range& rg, bool fSilent)
 			
 			// Resize the acids, points, and coherence arrays to match the new number of codons
 			ACIDTYPEARRAY::iterator itAcids = _vecAcids.begin();
-			POINTARRAY::iterator itPoints = _vecPoints.begin();
-			UINTARRAY::iterator itCoherent = _vecCoherent.begin();
-			ASSERT(_vecAcids.size() == _vecPoints.size());
+			UNITARRAY::iterator itX = _vecX.begin();
+			UNITARRAY::iterator itY = _vecY.begin();
+			COHERENCEARRAY::iterator itCoherent = _vecCoherent.begin();
+			ASSERT(_vecAcids.size() == _vecX.size());
+			ASSERT(_vecAcids.size() == _vecY.size());
 			ASSERT(_vecAcids.size() == _vecCoherent.size());
 			if (gc == GC_INSERT)
 			{
 				_rgBases.extend(cBasesChange);
 				_vecAcids.insert(itAcids+iAcid, cAcidChange, ACID_STP);
-				_vecPoints.insert(itPoints+iAcid, cAcidChange, Point());
+				_vecX.insert(itX+iAcid, cAcidChange, 0);
+				_vecY.insert(itY+iAcid, cAcidChange, 0);
 				_vecCoherent.insert(itCoherent+iAcid, cAcidChange, 0);
 			}
 			else
@@ -533,13 +556,15 @@ Gene::markInvalid(GENECHANGE gc, const Range& rg, bool fSilent)
 				ASSERT(iAcid-cAcidChange <= static_cast<long>(_vecAcids.size()));
 				_rgBases.extend(-cBasesChange);
 				_vecAcids.erase(itAcids+iAcid, itAcids+iAcid+cAcidChange);
-				_vecPoints.erase(itPoints+iAcid, itPoints+iAcid+cAcidChange);
+				_vecX.erase(itX+iAcid, itX+iAcid+cAcidChange);
+				_vecY.erase(itY+iAcid, itY+iAcid+cAcidChange);
 				_vecCoherent.erase(itCoherent+iAcid, itCoherent+iAcid+cAcidChange);
 				cAcidChange *= -1;
 				cBasesChange *= -1;
 			}
 			ASSERT(_vecAcids.size() == static_cast<size_t>(::abs(Codon::numWholeCodons(_rgBases.getLength()))));
-			ASSERT(_vecAcids.size() == _vecPoints.size());
+			ASSERT(_vecAcids.size() == _vecX.size());
+			ASSERT(_vecAcids.size() == _vecY.size());
 			ASSERT(_vecAcids.size() == _vecCoherent.size());
 
 			// Unless within a rollback or restore, adjust stroke locations after insertions and deletions
@@ -594,12 +619,65 @@ Gene::markInvalid(GENECHANGE gc, const Range& rg, bool fSilent)
 		{
 			ensureAcids(iAcid, cAcidChange);
 			grfInvalid &= ~(GI_ACIDS | GI_POINTS);
+
+			if (!_rgAcidsDirty.isEmpty() || isValid(GI_COHERENCE | GI_SEGMENTS))
+				markAcidsDirty(_rgAcidsDirty, _dAcidsDirty, gc, iAcid, cAcidChange);
+			if (!_vecOverlapRanges.empty())
+				markAcidsDirty(_rgOverlapsDirty, _dOverlapsDirty, gc, iAcid, cAcidChange);
 		}
 	}
 
 	markInvalid(grfInvalid);
 }
 
+/*
+ * Function: markAcidsDirty
+ *
+ * Extend the range of changed acids to include those just changed or inserted
+ * (or, for deletions, the acid preceding those deleted). The range is kept
+ * in the current acid positions, so an existing range shifts with insertions
+ * and deletions that precede it.
+ */
+void
+Gene::markAcidsDirty(Range& rgDirty, long& dDirty, GENECHANGE gc, long iAcid, long cAcidChange)
+{
+	ENTER(MUTATION,markAcidsDirty);
+
+	if (!rgDirty.isEmpty() && gc != GC_CHANGE)
+	{
+		long iStart = rgDirty.getStart();
+		long iEnd = rgDirty.getEnd();
+
+		if (gc == GC_INSERT)
+		{
+			if (iStart >= iAcid)
+				iStart += cAcidChange;
+			if (iEnd >= iAcid)
+				iEnd += cAcidChange;
+		}
+		else
+		{
+			long iAcidDeleted = iAcid - cAcidChange;
+			iStart = (iStart >= iAcidDeleted ? iStart + cAcidChange : min(iStart, iAcid));
+			iEnd = (iEnd >= iAcidDeleted ? iEnd + cAcidChange : min(iEnd, iAcid));
+		}
+		rgDirty.set(iStart, iEnd);
+	}
+
+	Range rgAcids(gc == GC_DELETE
+				  ? Range(iAcid-1)
+				  : Range(iAcid, iAcid + cAcidChange - 1));
+	if (rgDirty.isEmpty())
+		rgDirty.set(rgAcids);
+	else
+		rgDirty.merge(rgAcids);
+
+	if (gc != GC_CHANGE)
+		dDirty += cAcidChange;
+
+	TDATA(MUTATION,L3,(LLTRACE, "Changed acids now range over %s", rgDirty.toString().c_str()));
+}
+
 /*
  * Function: ensureCompiled
  *
@@ -633,20 +711,45 @@ Gene::ensureCompiled()
 /*
  * Function: ensureScore
  *
+ * Score the gene, stopping once the score divided by the passed cost must fall
+ * below the passed bound (a bound of zero scores the gene in full). A gene that
+ * stops remains unscored, but succeeds with an upper bound of its score (see
+ * isScoreBounded).
  */
 bool
-Gene::ensureScore()
+Gene::ensureScore(UNIT nScoreBound, UNIT nCost)
 {
 	ENTER(VALIDATION,ensureScore);
 	
 	ASSERT(isValid(GI_COMPILED | GI_VALIDATED));
 
-	if (isInvalid(GI_SCORE) && calcScore())
-		markValid(GI_SCORE);
+	_fScoreBounded = false;
+	if (isInvalid(GI_SCORE))
+	{
+		if (calcScore(nScoreBound, nCost))
+			markValid(GI_SCORE);
 
-	TFLOW(SCORING,L2,(LLTRACE, "Gene scored %f in trial %d", static_cast<UNIT>(_nScore), Genome::getTrial()));
+		// Discard the partial scores of a gene that stopped at the bound
+		// (including the overlap errors noted while scoring)
+		else if (_fScoreBounded)
+		{
+			UNIT nScore = _nScore;
+			_vecMissingOverlaps.clear();
+			_vecIllegalOverlaps.clear();
+			invalidate();
+			_nScore = nScore;
+
+#ifdef ST_DEBUG
+			Gene gene(*this);
+			gene.ensureScore();
+			ASSERT(gene.score() <= nScore);
+#endif
+		}
+	}
+
+	TFLOW(SCORING,L2,(LLTRACE, "Gene scored %f%s in trial %d", static_cast<UNIT>(_nScore), (_fScoreBounded ? " (bounded)" : ""), Genome::getTrial()));
 	TRACEDOIF(SCORING,DATA,L3,traceScores());
-	return isValid(GI_SCORED);
+	return (isValid(GI_SCORED) || _fScoreBounded);
 }
 
 /*
@@ -765,18 +868,29 @@ Gene::invalidate()
 		if (isInvalid(GI_ACIDS | GI_POINTS))
 		{
 			_vecAcids.clear();
-			_vecPoints.clear();
+			_vecLattice.clear();
+			_cLattice = 0;
+			_vecX.clear();
+			_vecY.clear();
 			_nUnits.setUndefined();
+			_rgAcidsDirty.clear();
+			_dAcidsDirty = 0;
+			_vecOverlapRanges.clear();
+			_vecOverlapOrigins.clear();
+			_vecOverlapCrossings.clear();
+			_rgOverlapsDirty.clear();
+			_dOverlapsDirty = 0;
 			TFLOW(VALIDATION,L4,(LLTRACE, "Invalidated acids and points"));
 		}
 
-		if (isInvalid(GI_COHERENCE))
+		// Coherence and segments around changed acids are recomputed in place
+		if (isInvalid(GI_COHERENCE) && _rgAcidsDirty.isEmpty())
 		{
 			_vecCoherent.clear();
 			TFLOW(VALIDATION,L4,(LLTRACE, "Invalidated coherence"));
 		}
 
-		if (isInvalid(GI_SEGMENTS))
+		if (isInvalid(GI_SEGMENTS) && _rgAcidsDirty.isEmpty())
 		{
 			_vecSegments.clear();
 			_cCoherent = 0;
@@ -826,6 +940,7 @@ Gene::invalidate()
 			TFLOW(VALIDATION,L4,(LLTRACE, "Invalidated dimensions"));
 		}
 
+		// The lines crossing between unchanged strokes are retained for reuse (see ensureOverlaps)
 		if (isInvalid(GI_OVERLAPS))
 		{
 			_setOverlaps.clear();
@@ -1128,10 +1243,9 @@ Gene::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
 			//   the point before marks where the segment actually begins
 			for (size_t iPoint=sg.getStart()-1; iPoint <= static_cast<size_t>(sg.getEnd()); ++iPoint)
 			{
-				const Point& pt = _vecPoints[iPoint];
 				xs.openStart(xmlTag(XT_POINT));
-				xs.writeAttribute(xmlTag(XT_X), pt.x());
-				xs.writeAttribute(xmlTag(XT_Y), pt.y());
+				xs.writeAttribute(xmlTag(XT_X), getX()[iPoint]);
+				xs.writeAttribute(xmlTag(XT_Y), getY()[iPoint]);
 				xs.closeStart(false);
 			}
 			
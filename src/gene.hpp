@@ -228,9 +228,64 @@ namespace org_biologicinstitute_stylus
 		Unit _nDeviation;						///< Maximum deviation between stroke and Han
 		Unit _nExtraLength;						///< Length of Stroke length in excess of Han length
 
+		/**
+		 * \brief Outcome of measuring deviation against each stroke and Han point
+		 *
+		 */
+		enum DEVIATIONMEASURE
+		{
+			DM_MEASURED = 0,					///< Deviation measured at every point
+			DM_NOHANPOINTS,						///< Stroke points remained after the Han points ran out
+			DM_NOPOINTS							///< Han points remained after the stroke points ran out
+		};
+
+		/**
+		 * \brief Deviation measured against one Han path as the stroke points are reached
+		 *
+		 * \remarks
+		 * - Stroke points are supplied in order, in Han coordinates, along with the (scaled)
+		 *   distance traversed to each; measuring stops once the Han points run out
+		 * - Several paths may be measured while reaching the stroke points just once
+		 */
+		class DeviationWalk
+		{
+		public:
+			DeviationWalk(const HPath& hpath, UNIT x, UNIT y);
+
+			bool isWalking() const;
+
+			void measure(UNIT nStrokeLength, UNIT xPrev, UNIT yPrev, UNIT dPrev, UNIT x, UNIT y, UNIT d);
+
+			DEVIATIONMEASURE getOutcome() const;
+			UNIT getSquareDeviation() const;
+
+		private:
+			const UNIT* _pxHan;					///< Han point x-coordinates
+			const UNIT* _pyHan;					///< Han point y-coordinates
+			const UNIT* _pdHan;					///< Han point fractional distances
+			size_t _cHPoints;					///< Number of Han points
+			size_t _iHPoint;					///< Next Han point to reach
+
+			UNIT _hxPrev;						///< Han point preceding the next (x-coordinate)
+			UNIT _hyPrev;						///< Han point preceding the next (y-coordinate)
+			UNIT _hdPrev;						///< Han point preceding the next (fractional distance)
+			UNIT _hx;							///< Next Han point (x-coordinate)
+			UNIT _hy;							///< Next Han point (y-coordinate)
+			UNIT _hd;							///< Next Han point (fractional distance)
+
+			UNIT _nMaximum;						///< Maximum square deviation measured
+		};
+
 		int compare(const Stroke& stroke) const;
 
-		const HPOINTARRAY& determineStrokeOrientation(const Gene& gene, const HStroke& hst);
+		const HPath& determineStrokeOrientation(const Gene& gene, const HStroke& hst);
+
+		DEVIATIONMEASURE measureDeviation(const Gene& gene, const HPath& hpath, Unit& nSquareDeviation) const;
+		DEVIATIONMEASURE measureDeviation(const Gene& gene, const HStroke& hst, Unit& nSquareDeviation) const;
+
+#ifdef ST_DEBUG
+		DEVIATIONMEASURE walkDeviation(const Gene& gene, const HPath& hpath, Unit& nSquareDeviation) const;
+#endif
 	};
 
 	/**
@@ -335,6 +390,10 @@ namespace org_biologicinstitute_stylus
 	 *
 	 * Genes contain Groups and Strokes; it tends to manage them recursively, though some
 	 * aspects (tracking overlaps) is handled at the gene level.
+	 *
+	 * The per-acid data (acids, point coordinates, and coherence) is held in separate,
+	 * compact arrays so that the linear passes of validation and scoring read only the
+	 * values they use.
 	 */
 	class Gene
 	{
@@ -387,7 +446,9 @@ namespace org_biologicinstitute_stylus
 		Range baseToCodonRange(const Range& rgBases) const;
 
 		const ACIDTYPEARRAY& getAcids() const;
-		const POINTARRAY& getPoints() const;
+		const UNITARRAY& getX() const;
+		const UNITARRAY& getY() const;
+		Point getPoint(size_t iPoint) const;
 		const SEGMENTARRAY& getSegments() const;
 		//@}
 
@@ -399,6 +460,7 @@ namespace org_biologicinstitute_stylus
 		const std::string& getUnicode() const;
 		const STROKEARRAY& getStrokes() const;
 		STROKEARRAY& getStrokes();
+		bool hasAssignedStrokes() const;
 
 		size_t mapHanToStroke(size_t iHStroke) const;
 		size_t mapStrokeToHan(size_t iStroke) const;
@@ -412,13 +474,14 @@ namespace org_biologicinstitute_stylus
 
 		const UNIT score() const;
 		const UNIT units() const;
+		bool isScoreBounded() const;
 		//@}
 
 		void markInvalid();
 		void markInvalid(GENECHANGE gc, const Range& rg, bool fSilent);
 
 		bool ensureCompiled();
-		bool ensureScore();
+		bool ensureScore(UNIT nScoreBound = 0, UNIT nCost = 1);
 		bool ensureValid();
 
 		std::string toString() const;
@@ -463,12 +526,19 @@ namespace org_biologicinstitute_stylus
 		STFLAGS _grfInvalid;					///< Set of GENEINVALID flags
 
 		ACIDTYPEARRAY _vecAcids;				///< Array of acids in the gene
-		POINTARRAY _vecPoints;					///< Array of points *after* applying codon vector
-		UINTARRAY _vecCoherent;					///< Array of coherence count for each vector
+		mutable LATTICEPOINTARRAY _vecLattice;	///< Array of exact points (relative to the origin) after every s_cLATTICEINTERVAL acids
+		mutable size_t _cLattice;				///< Number of leading lattice points unaffected by changes in acids
+		UNITARRAY _vecX;						///< Array of point x-coordinates *after* applying codon vector
+		UNITARRAY _vecY;						///< Array of point y-coordinates *after* applying codon vector
+		COHERENCEARRAY _vecCoherent;			///< Array of coherence count (0 through 3) for each vector
 
 		SEGMENTARRAY _vecSegments;				///< Array of Segments within the gene
 		size_t _cCoherent;						///< Number of coherent segments within the gene
 		Unit _nUnits;							///< Gene unit length
+
+		Range _rgAcidsDirty;					///< Acids changed since coherence and segments were compiled (empty if unknown)
+		long _dAcidsDirty;						///< Net acids inserted (or deleted) within the changed acids
+		bool _fInternalStop;					///< A stop codon precedes the last acid (ending the trivectors early)
 		//@}
 
 		///-------------------------------------------------------------------------------
@@ -494,6 +564,11 @@ namespace org_biologicinstitute_stylus
 
 		NUMERICMAP _vecMarks;					///< Marks within the gene (by index into segments)
 		STROKEOVERLAPS _setOverlaps;			///< Array of overlaps between strokes
+		std::vector<Range> _vecOverlapRanges;	///< Stroke ranges when overlaps were last found (empty if none retained)
+		LATTICEPOINTARRAY _vecOverlapOrigins;	///< Stroke start points (exact) when overlaps were last found
+		LINECROSSINGARRAY _vecOverlapCrossings;	///< Intersecting lines when overlaps were last found
+		Range _rgOverlapsDirty;					///< Acids changed since overlaps were last found
+		long _dOverlapsDirty;					///< Net acids inserted (or deleted) within the changed acids
 		NUMERICPAIRARRAY _vecMissingOverlaps;	///< Array of missing overlaps
 		NUMERICPAIRARRAY _vecIllegalOverlaps;	///< Array of illegal overlaps
 
@@ -509,6 +584,7 @@ namespace org_biologicinstitute_stylus
 
 		Unit _aryScoreExponents[SC_GENEMAX];	///< Score exponent values
 		Unit _nScore;							///< Gene score
+		bool _fScoreBounded;					///< Scoring stopped at the score bound (the score is an upper bound)
 		//@}
 
 		void invalidate();
@@ -519,13 +595,21 @@ namespace org_biologicinstitute_stylus
 		void markInvalid(STFLAGS grf);
 
 		void ensureAcids(size_t iAcidChange, long cAcidsChanged);
+		void ensurePoints(size_t iAcidChange);
+		LatticePoint calcLatticePoint(size_t iAcid) const;
 		void ensureCoherence();
 		void ensureSegments();
+
+		static void markAcidsDirty(Range& rgDirty, long& dDirty, GENECHANGE gc, long iAcid, long cAcidChange);
+		bool calcCoherence(COHERENCEARRAY& vecCoherent) const;
+		void calcSegments(long iAcidFirst, long iAcidLast, SEGMENTARRAY& vecSegments, size_t& cCoherent) const;
+		size_t findSegment(long iAcid) const;
 		void ensureStrokes();
 		void ensureDimensions();
 		void ensureOverlaps();
+		bool isStrokeRigid(size_t iStroke) const;
 
-		bool calcScore();
+		bool calcScore(UNIT nScoreBound, UNIT nCost);
 		void scoreOverlaps(const Han& han);
 
 		void validateStrokeRanges(const STROKERANGEARRAY& vecStrokeRange) const;
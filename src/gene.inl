@@ -183,6 +183,98 @@ inline int Stroke::compare(const Stroke& stroke) const
 					: 1));
 }
 
+//--------------------------------------------------------------------------------
+//
+// Stroke::DeviationWalk
+//
+//--------------------------------------------------------------------------------
+inline Stroke::DeviationWalk::DeviationWalk(const HPath& hpath, UNIT x, UNIT y)
+{
+	ASSERT(hpath.size() > 0);
+
+	_pxHan = &hpath.getX()[0];
+	_pyHan = &hpath.getY()[0];
+	_pdHan = &hpath.getDistances()[0];
+	_cHPoints = hpath.size();
+	_iHPoint = 0;
+
+	// Measure the first stroke and Han points against one another
+	_hxPrev = _pxHan[_iHPoint];
+	_hyPrev = _pyHan[_iHPoint];
+	_hdPrev = _pdHan[_iHPoint];
+
+	UNIT dx = _hxPrev - x;
+	UNIT dy = _hyPrev - y;
+	_nMaximum = (dx*dx) + (dy*dy);
+
+	// Note: The final Han point is repeated (see HPath), so the next point is always readable
+	++_iHPoint;
+	_hx = _pxHan[_iHPoint];
+	_hy = _pyHan[_iHPoint];
+	_hd = _pdHan[_iHPoint];
+}
+
+inline bool Stroke::DeviationWalk::isWalking() const { return (_iHPoint < _cHPoints); }
+
+inline void Stroke::DeviationWalk::measure(UNIT nStrokeLength, UNIT xPrev, UNIT yPrev, UNIT dPrev, UNIT x, UNIT y, UNIT d)
+{
+	ASSERT(isWalking());
+
+	Unit dTraversedCurrent = d / nStrokeLength;
+	UNIT dx;
+	UNIT dy;
+
+	// Measure each Han point occurring before the stroke point along the stroke segment
+	while (dTraversedCurrent > _hd)
+	{
+		UNIT dProportion = ((nStrokeLength * _hd) - dPrev) / (d - dPrev);
+		dx = _hx - (xPrev + ((x - xPrev) * dProportion));
+		dy = _hy - (yPrev + ((y - yPrev) * dProportion));
+		_nMaximum = max<UNIT>(_nMaximum, (dx*dx) + (dy*dy));
+
+		_hxPrev = _hx;
+		_hyPrev = _hy;
+		_hdPrev = _hd;
+		if (++_iHPoint >= _cHPoints)
+			return;
+		_hx = _pxHan[_iHPoint];
+		_hy = _pyHan[_iHPoint];
+		_hd = _pdHan[_iHPoint];
+	}
+
+	// Measure the stroke point along the Han segment containing it (or at the Han point it reaches)
+	ASSERT(Unit(_hdPrev) < dTraversedCurrent);
+	ASSERT(Unit(_hd) >= dTraversedCurrent);
+	if (dTraversedCurrent < _hd)
+	{
+		UNIT dProportion = (dTraversedCurrent - _hdPrev) / (_hd - _hdPrev);
+		dx = (_hxPrev + ((_hx - _hxPrev) * dProportion)) - x;
+		dy = (_hyPrev + ((_hy - _hyPrev) * dProportion)) - y;
+	}
+	else
+	{
+		dx = _hx - x;
+		dy = _hy - y;
+	}
+	_nMaximum = max<UNIT>(_nMaximum, (dx*dx) + (dy*dy));
+
+	// Advance the Han point if measured against
+	if (dTraversedCurrent == _hd)
+	{
+		_hxPrev = _hx;
+		_hyPrev = _hy;
+		_hdPrev = _hd;
+		++_iHPoint;
+		_hx = _pxHan[_iHPoint];
+		_hy = _pyHan[_iHPoint];
+		_hd = _pdHan[_iHPoint];
+	}
+}
+
+// Note: Measuring stops early only when the Han points run out, so Han points remaining means the stroke points ran out
+inline Stroke::DEVIATIONMEASURE Stroke::DeviationWalk::getOutcome() const { return (isWalking() ? DM_NOPOINTS : DM_MEASURED); }
+inline UNIT Stroke::DeviationWalk::getSquareDeviation() const { return _nMaximum; }
+
 //--------------------------------------------------------------------------------
 //
 // Group
@@ -244,7 +336,7 @@ inline void StrokeRangeChange::toXML(XMLStream& xs, STFLAGS grfRecordDetail) con
 // Gene
 //
 //--------------------------------------------------------------------------------
-inline Gene::Gene() { markInvalid(GI_ALL); }
+inline Gene::Gene() : _cLattice(0), _dAcidsDirty(0), _fInternalStop(false), _dOverlapsDirty(0), _fScoreBounded(false) { markInvalid(GI_ALL); }
 inline Gene::Gene(const Gene& gene) { *this = gene; }
 
 inline bool Gene::operator==(const Gene& gene) const { return (compare(gene) == 0); }
@@ -261,11 +353,18 @@ inline void Gene::moveRange(long d) { _rgBases.move(d); }
 inline bool Gene::intersectsRange(const Range& rg) const { return _rgBases.intersects(rg); }
 
 inline const ACIDTYPEARRAY& Gene::getAcids() const { return _vecAcids; }
-inline const POINTARRAY& Gene::getPoints() const { return _vecPoints; }
+inline const UNITARRAY& Gene::getX() const { return _vecX; }
+inline const UNITARRAY& Gene::getY() const { return _vecY; }
+inline Point Gene::getPoint(size_t iPoint) const
+{
+	ASSERT(iPoint < _vecX.size());
+	return Point(_vecX[iPoint], _vecY[iPoint]);
+}
 inline const SEGMENTARRAY& Gene::getSegments() const { return _vecSegments; }
 inline const std::string& Gene::getUnicode() const { return _strUnicode; }
 inline const STROKEARRAY& Gene::getStrokes() const { return _vecStrokes; }
 inline STROKEARRAY& Gene::getStrokes() { return _vecStrokes; }
+inline bool Gene::hasAssignedStrokes() const { return _fStrokesAssigned; }
 
 inline void Gene::setOrigin(const Point& ptOrigin) { _ptOrigin = ptOrigin; markInvalid(GI_POINTS); }
 
@@ -280,6 +379,7 @@ inline const UNIT Gene::dxToHan() const { return _dxToHan; }
 inline const UNIT Gene::dyToHan() const { return _dyToHan; }
 
 inline const UNIT Gene::score() const { return _nScore; }
+inline bool Gene::isScoreBounded() const { return _fScoreBounded; }
 inline const UNIT Gene::units() const { return _nUnits; }
 
 inline void Gene::markInvalid() { markInvalid(GI_ALL); }
@@ -308,7 +408,7 @@ inline int Gene::compare(const Gene& gene) const
 			: (_rgBases > gene._rgBases
 				? 1
 				: (		_vecAcids == gene._vecAcids
-					&&	_vecPoints == gene._vecPoints
+					&&	_ptOrigin == gene._ptOrigin
 					&&	_vecCoherent == gene._vecCoherent
 					&&	_vecSegments == gene._vecSegments
 					&&	_vecStrokes == gene._vecStrokes
@@ -198,6 +198,27 @@ const ACIDTYPE CodonTable::s_mapCodonToType[Constants::s_nmaxCODONS] =
 	ACID_Wes  // 63 - GGG
 };
 
+// Two-bit index of each base (T, C, A, and G map to 0 through 3; anything else maps as G)
+const unsigned char CodonTable::s_mapBaseToIndex[UCHAR_MAX+1] =
+{
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 00
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 10
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 20
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 30
+	3, 2, 3, 1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 40
+	3, 3, 3, 3, 0, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 50
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 60
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 70
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 80
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // 90
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // A0
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // B0
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // C0
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // D0
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, // E0
+	3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3  // F0
+};
+
 /*
  * Function: load
  *
@@ -309,177 +330,1403 @@ CodonTable::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
 
 //--------------------------------------------------------------------------------
 //
-// Genome
+// Description
 //
 //--------------------------------------------------------------------------------
 
-const char* Genome::s_aryGENOMESTATES[STGS_MAX] =
+/*
+ * Function: scanConversion
+ *
+ * Skip the flags, width, and precision of a conversion specification (just past the '%'),
+ * note its length modifier ('q' standing for "ll"), and return the conversion character
+ * (a '*' width or precision and an 'L' modifier are returned as the conversion character)
+ */
+const char*
+Description::scanConversion(const char* pch, char& chLength)
 {
-	"ALIVE",
-	"COMPILED",
-	"COMPILING",
-	"DEAD",
-	"INVALID",
-	"LOADING",
-	"MUTATING",
-	"RECORDING",
-	"ROLLBACK",
-	"RESTORING",
-	"SCORED",
-	"SCORING",
-	"SPAWNING",
-	"VALIDATED",
-	"VALIDATING"
-};
+	chLength = Constants::s_chNULL;
+
+	while (*pch && ::strchr("-+ #0123456789.", *pch))
+		++pch;
+
+	switch (*pch)
+	{
+	case 'h':
+		chLength = 'h';
+		pch += (*(pch+1) == 'h' ? 2 : 1);
+		break;
+
+	case 'l':
+		chLength = (*(pch+1) == 'l' ? 'q' : 'l');
+		pch += (chLength == 'q' ? 2 : 1);
+		break;
+
+	case 'j':
+		chLength = 'q';
+		++pch;
+		break;
+
+	case 'z':
+	case 't':
+		chLength = 'z';
+		++pch;
+		break;
+
+	default:
+		break;
+	}
+
+	return pch;
+}
+
+/*
+ * Function: copyPrefix
+ *
+ * Write the file/line (if any) and separating blank that precede the text
+ */
+size_t
+Description::copyPrefix(char* pszBuffer, size_t cbRemaining, const char* pszFileline)
+{
+	if (!VALID(pszFileline))
+		return 0;
+
+	size_t cbWritten = copyFileline(pszBuffer, cbRemaining, pszFileline);
+	if (cbWritten + 1 < cbRemaining)
+		pszBuffer[cbWritten++] = Constants::s_chBLANK;
+	pszBuffer[cbWritten] = Constants::s_chNULL;
+	return cbWritten;
+}
+
+/*
+ * Function: record
+ *
+ * Capture the arguments of the format; strings are copied since they rarely outlive
+ * the call. Formats whose arguments do not fit (or cannot be captured) are formatted
+ * immediately instead.
+ */
+void
+Description::record(const char* pszFileline, const char* pszFormat, va_list ap)
+{
+	ENTER(GENOME,record);
+	ASSERT(VALID(pszFormat));
+
+	_pszFileline = pszFileline;
+	_pszFormat = pszFormat;
+	_cchStrings = 0;
+	_strText.clear();
+
+	va_list apCaptured;
+	va_copy(apCaptured, ap);
+
+	bool fCaptured = true;
+	size_t iArgument = 0;
+	for (const char* pch = ::strchr(pszFormat, '%'); fCaptured && VALID(pch) && *pch; pch = ::strchr(pch, '%'))
+	{
+		char chLength;
+		const char* pchStart = pch;
+		pch = scanConversion(pch+1, chLength);
+		if (*pch == Constants::s_chNULL)
+			break;
+
+		// The specification must fit within that used by toString
+		if (static_cast<size_t>(pch - pchStart) >= s_cchmaxSPECIFICATION)
+		{
+			fCaptured = false;
+			break;
+		}
+
+		if (*pch == '%')
+		{
+			++pch;
+			continue;
+		}
+
+		if (iArgument >= s_cmaxARGUMENTS)
+		{
+			fCaptured = false;
+			break;
+		}
+		Argument& arg = _aryArguments[iArgument];
+
+		switch (*pch++)
+		{
+		case 'd':
+		case 'i':
+		case 'c':
+			arg._ll = (chLength == 'q'
+						? va_arg(apCaptured, long long)
+						: chLength == 'l'
+						? va_arg(apCaptured, long)
+						: chLength == 'z'
+						? static_cast<long long>(va_arg(apCaptured, size_t))
+						: va_arg(apCaptured, int));
+			++iArgument;
+			break;
+
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			arg._ll = (chLength == 'q'
+						? static_cast<long long>(va_arg(apCaptured, unsigned long long))
+						: chLength == 'l'
+						? static_cast<long long>(va_arg(apCaptured, unsigned long))
+						: chLength == 'z'
+						? static_cast<long long>(va_arg(apCaptured, size_t))
+						: static_cast<long long>(va_arg(apCaptured, unsigned int)));
+			++iArgument;
+			break;
+
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			arg._n = va_arg(apCaptured, double);
+			++iArgument;
+			break;
+
+		case 'p':
+			arg._pv = va_arg(apCaptured, const void*);
+			++iArgument;
+			break;
+
+		case 's':
+			{
+				const char* psz = va_arg(apCaptured, const char*);
+				if (!VALID(psz))
+					psz = "(null)";
+
+				size_t cch = ::strlen(psz);
+				if (_cchStrings + cch >= s_cchmaxSTRINGS)
+				{
+					fCaptured = false;
+					break;
+				}
+
+				::memcpy(_aryStrings + _cchStrings, psz, cch + 1);
+				arg._iString = _cchStrings;
+				_cchStrings += cch + 1;
+				++iArgument;
+			}
+			break;
+
+		// Other conversions (including '*' widths or precisions) are not captured
+		default:
+			fCaptured = false;
+			break;
+		}
+	}
+	va_end(apCaptured);
+
+	if (fCaptured)
+		return;
+
+	// Format the description now, just as toString would have
+	char szDescription[Constants::s_cbmaxBUFFER];
+	size_t cbWritten = copyPrefix(szDescription, SZ_OF(szDescription), pszFileline);
+	::vsnprintf(szDescription + cbWritten, SZ_OF(szDescription) - cbWritten, pszFormat, ap);
+
+	_pszFileline = NULL;
+	_pszFormat = NULL;
+	_cchStrings = 0;
+	_strText = szDescription;
+}
+
+/*
+ * Function: toString
+ *
+ * Format the description, exactly as the recorded format and arguments would have been
+ */
+std::string
+Description::toString() const
+{
+	ENTER(GENOME,toString);
+
+	if (!_strText.empty())
+		return _strText;
+	if (isEmpty())
+		return std::string();
+
+	char szDescription[Constants::s_cbmaxBUFFER];
+	size_t cbWritten = copyPrefix(szDescription, SZ_OF(szDescription), _pszFileline);
+	char* pszDescription = szDescription + cbWritten;
+	size_t cbRemaining = SZ_OF(szDescription) - cbWritten;
+
+	size_t iArgument = 0;
+	for (const char* pch = _pszFormat; *pch && cbRemaining > 1; )
+	{
+		if (*pch != '%')
+		{
+			*pszDescription++ = *pch++;
+			cbRemaining -= 1;
+			continue;
+		}
+
+		// Isolate the conversion specification and format its argument alone
+		char chLength;
+		const char* pchStart = pch;
+		pch = scanConversion(pch+1, chLength);
+		if (*pch == Constants::s_chNULL)
+			break;
+
+		char szSpecification[s_cchmaxSPECIFICATION+1];
+		size_t cchSpecification = (pch - pchStart) + 1;
+		ASSERT(cchSpecification <= s_cchmaxSPECIFICATION);
+		::memcpy(szSpecification, pchStart, cchSpecification);
+		szSpecification[cchSpecification] = Constants::s_chNULL;
+
+		const Argument& arg = _aryArguments[min<size_t>(iArgument, s_cmaxARGUMENTS-1)];
+		int cch = 0;
+
+		switch (*pch++)
+		{
+		case '%':
+			cch = ::snprintf(pszDescription, cbRemaining, "%%");
+			break;
+		case 'd':
+		case 'i':
+		case 'c':
+			cch = (chLength == 'q'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, arg._ll)
+					: chLength == 'l'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<long>(arg._ll))
+					: chLength == 'z'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<size_t>(arg._ll))
+					: ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<int>(arg._ll)));
+			++iArgument;
+			break;
+
+		case 'u':
+		case 'x':
+		case 'X':
+		case 'o':
+			cch = (chLength == 'q'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<unsigned long long>(arg._ll))
+					: chLength == 'l'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<unsigned long>(arg._ll))
+					: chLength == 'z'
+					? ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<size_t>(arg._ll))
+					: ::snprintf(pszDescription, cbRemaining, szSpecification, static_cast<unsigned int>(arg._ll)));
+			++iArgument;
+			break;
+
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			cch = ::snprintf(pszDescription, cbRemaining, szSpecification, arg._n);
+			++iArgument;
+			break;
+
+		case 'p':
+			cch = ::snprintf(pszDescription, cbRemaining, szSpecification, arg._pv);
+			++iArgument;
+			break;
+
+		case 's':
+			cch = ::snprintf(pszDescription, cbRemaining, szSpecification, _aryStrings + arg._iString);
+			++iArgument;
+			break;
+
+		default:
+			break;
+		}
+
+		cbWritten = min<size_t>(max<int>(cch, 0), cbRemaining - 1);
+		pszDescription += cbWritten;
+		cbRemaining -= cbWritten;
+	}
+	*pszDescription = Constants::s_chNULL;
+
+	return std::string(szDescription);
+}
+
+//--------------------------------------------------------------------------------
+//
+// AttemptHistory
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: reserve
+ *
+ * Offer an attempt to the history and return the slot into which to place it
+ * (or NULL if the attempt is not retained)
+ */
+ModificationStack*
+AttemptHistory::reserve(ATTEMPTHISTORY ah, size_t cRetain)
+{
+	ENTER(GENOME,reserve);
+
+	size_t iOffered = _cOffered++;
+	size_t iSlot;
+
+	if (ah == AH_NONE)
+		return NULL;
+
+	// Until the history holds all it may retain, add a slot for each attempt
+	if (ah == AH_ALL || _vecAttempts.size() < cRetain)
+	{
+		_vecAttempts.push_back(ModificationStack());
+		_vecSequence.push_back(iOffered);
+		_fOrdered = false;
+		return &_vecAttempts.back();
+	}
+
+	if (_vecAttempts.empty())
+		return NULL;
+
+	// Once full, overwrite the oldest attempt or, when sampling, keep the attempt
+	// with a probability of size/(iOffered+1) in place of a uniformly chosen slot
+	if (ah == AH_LAST)
+	{
+		iSlot = _iOldest % _vecAttempts.size();
+		_iOldest = (iSlot + 1) % _vecAttempts.size();
+	}
+	else
+	{
+		ASSERT(ah == AH_SAMPLE);
+
+		// Hash the count offered (with the SplitMix64 finalizer)
+		uint64_t nHash = static_cast<uint64_t>(iOffered) + 0x9E3779B97F4A7C15ULL;
+		nHash = (nHash ^ (nHash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		nHash = (nHash ^ (nHash >> 27)) * 0x94D049BB133111EBULL;
+		nHash = nHash ^ (nHash >> 31);
+
+		iSlot = static_cast<size_t>(nHash % (iOffered + 1));
+		if (iSlot >= _vecAttempts.size())
+			return NULL;
+	}
+
+	_vecSequence[iSlot] = iOffered;
+	_fOrdered = false;
+	return &_vecAttempts[iSlot];
+}
+
+/*
+ * Function: merge
+ *
+ * Offer the attempts of the passed history (emptying it) as though they followed
+ * those already offered
+ */
+void
+AttemptHistory::merge(AttemptHistory& ahHistory, ATTEMPTHISTORY ah, size_t cRetain)
+{
+	ENTER(GENOME,merge);
+
+	ahHistory.ensureOrder();
+	for (size_t iAttempt=0; iAttempt < ahHistory._vecOrder.size(); ++iAttempt)
+	{
+		ModificationStack* pms = reserve(ah, cRetain);
+		if (VALID(pms))
+			pms->swap(ahHistory._vecAttempts[ahHistory._vecOrder[iAttempt]]);
+	}
+	ahHistory.clear();
+}
+
+/*
+ * Function: erase
+ *
+ */
+void
+AttemptHistory::erase(size_t iAttempt)
+{
+	ENTER(GENOME,erase);
+	ASSERT(iAttempt < _vecAttempts.size());
+
+	ensureOrder();
+	size_t iSlot = _vecOrder[iAttempt];
+	_vecAttempts.erase(_vecAttempts.begin() + iSlot);
+	_vecSequence.erase(_vecSequence.begin() + iSlot);
+	_fOrdered = false;
+
+	// The oldest remaining attempt is the next to overwrite
+	_iOldest = 0;
+	for (size_t i=1; i < _vecSequence.size(); ++i)
+	{
+		if (_vecSequence[i] < _vecSequence[_iOldest])
+			_iOldest = i;
+	}
+}
+
+/*
+ * Function: ensureOrder
+ *
+ */
+void
+AttemptHistory::ensureOrder() const
+{
+	if (_fOrdered)
+		return;
+
+	_vecOrder.resize(_vecAttempts.size());
+	for (size_t iSlot=0; iSlot < _vecOrder.size(); ++iSlot)
+		_vecOrder[iSlot] = iSlot;
+
+	const NUMERICARRAY& vecSequence = _vecSequence;
+	std::sort(_vecOrder.begin(), _vecOrder.end(), [&vecSequence](size_t iSlot1, size_t iSlot2) { return vecSequence[iSlot1] < vecSequence[iSlot2]; });
+	_fOrdered = true;
+}
+
+//--------------------------------------------------------------------------------
+//
+// FitnessCache
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: find
+ *
+ */
+const FitnessCache::Entry*
+FitnessCache::find(size_t nKey)
+{
+	ENTER(GENOME,find);
+
+	if (!isEnabled())
+		return NULL;
+
+	ENTRYMAP::iterator itEntry = _mapEntries.find(nKey);
+	if (itEntry == _mapEntries.end())
+		return NULL;
+
+	_lstEntries.splice(_lstEntries.begin(), _lstEntries, itEntry->second);
+	return &_lstEntries.front().second;
+}
+
+/*
+ * Function: insert
+ *
+ */
+void
+FitnessCache::insert(size_t nKey, const Entry& entry)
+{
+	ENTER(GENOME,insert);
+
+	if (!isEnabled())
+		return;
+
+	ENTRYLIST lstEntry;
+	lstEntry.push_back(KEYENTRY(nKey, entry));
+	insert(lstEntry, lstEntry.begin());
+}
+
+/*
+ * Function: merge
+ *
+ * Note:
+ * - Entries move from the supplied cache, oldest first, so that its most
+ *   recently used entries remain most recently used
+ */
+void
+FitnessCache::merge(FitnessCache& fc)
+{
+	ENTER(GENOME,merge);
+
+	if (isEnabled())
+	{
+		while (!fc._lstEntries.empty())
+			insert(fc._lstEntries, --fc._lstEntries.end());
+	}
+	fc.clear();
+}
+
+/*
+ * Function: insert
+ *
+ * Note:
+ * - The entry is spliced from the supplied list to the front of the cache
+ */
+void
+FitnessCache::insert(ENTRYLIST& lstEntries, ENTRYLIST::iterator itEntry)
+{
+	ENTER(GENOME,insert);
+
+	size_t nKey = itEntry->first;
+	ENTRYMAP::iterator itExisting = _mapEntries.find(nKey);
+	if (itExisting != _mapEntries.end())
+	{
+		_lstEntries.erase(itExisting->second);
+		_mapEntries.erase(itExisting);
+	}
+
+	_lstEntries.splice(_lstEntries.begin(), lstEntries, itEntry);
+	_mapEntries[nKey] = _lstEntries.begin();
+
+	evict();
+}
+
+/*
+ * Function: evict
+ *
+ */
+void
+FitnessCache::evict()
+{
+	ENTER(GENOME,evict);
+
+	while (_lstEntries.size() > _cEntries)
+	{
+		_mapEntries.erase(_lstEntries.back().first);
+		_lstEntries.pop_back();
+	}
+}
+
+//--------------------------------------------------------------------------------
+//
+// BaseSequence
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: operator=
+ *
+ * Note:
+ * - New chunks are half-full so that later insertions rarely split them
+ */
+BaseSequence&
+BaseSequence::operator=(const std::string& strBases)
+{
+	ENTER(GENOME,operator=);
+
+	clear();
+	for (size_t iBase=0; iBase < strBases.length(); iBase += (s_cbMAXCHUNK / 2))
+	{
+		_vecChunks.push_back(std::make_shared<Chunk>(strBases, iBase, (s_cbMAXCHUNK / 2)));
+		_vecStarts.push_back(iBase);
+	}
+	_cbBases = strBases.length();
+	hashChunks();
+	return *this;
+}
+
+/*
+ * Function: view
+ *
+ * Note:
+ * - The returned bases are not terminated at the end of the view
+ */
+const char*
+BaseSequence::view(size_t iBase, size_t cbBases) const
+{
+	ENTER(GENOME,view);
+	ASSERT(cbBases > 0 && (iBase + cbBases) <= _cbBases);
+
+	if (_fFlat)
+		return _strFlat.c_str() + iBase;
+
+	size_t iChunk = findChunk(iBase);
+	size_t iOffset = iBase - _vecStarts[iChunk];
+	const std::string& strChunk = _vecChunks[iChunk]->_strBases;
+	if ((iOffset + cbBases) <= strChunk.length())
+		return strChunk.c_str() + iOffset;
+
+	_strView.clear();
+	appendTo(_strView, iBase, cbBases);
+	return _strView.c_str();
+}
+
+/*
+ * Function: appendTo
+ *
+ */
+void
+BaseSequence::appendTo(std::string& str, size_t iBase, size_t cbBases) const
+{
+	ENTER(GENOME,appendTo);
+	ASSERT((iBase + cbBases) <= _cbBases);
+
+	if (cbBases <= 0)
+		return;
+
+	size_t iChunk = findChunk(iBase);
+	size_t iOffset = iBase - _vecStarts[iChunk];
+	for (; cbBases > 0; ++iChunk, iOffset = 0)
+	{
+		const std::string& strChunk = _vecChunks[iChunk]->_strBases;
+		size_t cbAppend = min<size_t>(cbBases, strChunk.length() - iOffset);
+		str.append(strChunk, iOffset, cbAppend);
+		cbBases -= cbAppend;
+	}
+}
+
+/*
+ * Function: compare
+ *
+ * Compare the bases to the string (as does std::string::compare)
+ */
+int
+BaseSequence::compare(size_t iBase, size_t cbBases, const std::string& strBases) const
+{
+	ENTER(GENOME,compare);
+	ASSERT(iBase <= _cbBases);
+
+	cbBases = min<size_t>(cbBases, _cbBases - iBase);
+
+	int nCompare = 0;
+	size_t cbCompare = min<size_t>(cbBases, strBases.length());
+	if (cbCompare > 0)
+	{
+		size_t iChunk = findChunk(iBase);
+		size_t iOffset = iBase - _vecStarts[iChunk];
+		for (size_t i=0; nCompare == 0 && i < cbCompare; ++iChunk, iOffset = 0)
+		{
+			const std::string& strChunk = _vecChunks[iChunk]->_strBases;
+			size_t cb = min<size_t>(cbCompare - i, strChunk.length() - iOffset);
+			nCompare = ::memcmp(strChunk.c_str() + iOffset, strBases.c_str() + i, cb);
+			i += cb;
+		}
+	}
+
+	if (nCompare == 0)
+		nCompare = (cbBases < strBases.length() ? -1 : (cbBases > strBases.length() ? 1 : 0));
+	return nCompare;
+}
+
+/*
+ * Function: hash
+ *
+ * Return the polynomial hash of the bases (the same for equal bases however
+ * they are split across chunks)
+ */
+size_t
+BaseSequence::hash(size_t iBase, size_t cbBases) const
+{
+	ENTER(GENOME,hash);
+	ASSERT((iBase + cbBases) <= _cbBases);
+
+	size_t nHash = 0;
+	if (cbBases <= 0)
+		return nHash;
+
+	size_t iChunk = findChunk(iBase);
+	size_t iOffset = iBase - _vecStarts[iChunk];
+	for (; cbBases > 0; ++iChunk, iOffset = 0)
+	{
+		const Chunk& chunk = *_vecChunks[iChunk];
+		size_t cbHash = min<size_t>(cbBases, chunk._strBases.length() - iOffset);
+		if (cbHash >= chunk._strBases.length())
+		{
+			ASSERT(chunk._fHashed);
+			nHash = (nHash * chunk._nScale) + chunk._nHash;
+		}
+		else
+		{
+			const char* pb = chunk._strBases.c_str() + iOffset;
+			for (size_t i=0; i < cbHash; ++i)
+				nHash = (nHash * s_nHASHBASE) + static_cast<unsigned char>(pb[i]);
+		}
+		cbBases -= cbHash;
+	}
+	return nHash;
+}
+
+/*
+ * Function: str
+ *
+ */
+const std::string&
+BaseSequence::str() const
+{
+	ENTER(GENOME,str);
+
+	if (!_fFlat)
+	{
+		_strFlat.clear();
+		_strFlat.reserve(_cbBases);
+		for (size_t iChunk=0; iChunk < _vecChunks.size(); ++iChunk)
+			_strFlat.append(_vecChunks[iChunk]->_strBases);
+		_fFlat = true;
+	}
+	return _strFlat;
+}
+
+/*
+ * Function: replace
+ *
+ * Replace the bases starting at the index with the same number of bases
+ */
+void
+BaseSequence::replace(size_t iBase, const char* pbBases, size_t cbBases)
+{
+	ENTER(GENOME,replace);
+	ASSERT((iBase + cbBases) <= _cbBases);
+
+	invalidate();
+
+	for (size_t i=0; i < cbBases; )
+	{
+		size_t iChunk = findChunk(iBase + i);
+		size_t iOffset = (iBase + i) - _vecStarts[iChunk];
+		std::string& strChunk = ownChunk(iChunk);
+		size_t cb = min<size_t>(cbBases - i, strChunk.length() - iOffset);
+		strChunk.replace(iOffset, cb, pbBases + i, cb);
+		i += cb;
+	}
+
+	hashChunks();
+}
+
+/*
+ * Function: insert
+ *
+ */
+void
+BaseSequence::insert(size_t iBase, const char* pbBases, size_t cbBases)
+{
+	ENTER(GENOME,insert);
+	ASSERT(iBase <= _cbBases);
+
+	if (cbBases <= 0)
+		return;
+
+	if (_vecChunks.empty())
+	{
+		operator=(std::string(pbBases, cbBases));
+		return;
+	}
+
+	invalidate();
+
+	// Insert into the chunk holding the index (or, when appending, the last chunk)
+	size_t iChunk = (iBase < _cbBases ? findChunk(iBase) : _vecChunks.size()-1);
+	ownChunk(iChunk).insert(iBase - _vecStarts[iChunk], pbBases, cbBases);
+	_cbBases += cbBases;
+
+	for (size_t i=iChunk+1; i < _vecStarts.size(); ++i)
+		_vecStarts[i] += cbBases;
+
+	splitChunk(iChunk);
+	hashChunks();
+}
+
+/*
+ * Function: erase
+ *
+ */
+void
+BaseSequence::erase(size_t iBase, size_t cbBases)
+{
+	ENTER(GENOME,erase);
+	ASSERT((iBase + cbBases) <= _cbBases);
+
+	if (cbBases <= 0)
+		return;
+
+	invalidate();
+
+	// Remove the bases from each chunk they cover, dropping wholly covered chunks
+	size_t iChunkFirst = findChunk(iBase);
+	size_t iChunk = iChunkFirst;
+	size_t iOffset = iBase - _vecStarts[iChunk];
+	for (size_t cbRemaining = cbBases; cbRemaining > 0; iOffset = 0)
+	{
+		size_t cbChunk = _vecChunks[iChunk]->_strBases.length();
+		size_t cbErase = min<size_t>(cbRemaining, cbChunk - iOffset);
+		if (cbErase >= cbChunk)
+		{
+			_vecChunks.erase(_vecChunks.begin() + iChunk);
+			_vecStarts.erase(_vecStarts.begin() + iChunk);
+		}
+		else
+		{
+			ownChunk(iChunk).erase(iOffset, cbErase);
+			++iChunk;
+		}
+		cbRemaining -= cbErase;
+	}
+	_cbBases -= cbBases;
+
+	// Chunks starting within the erased bases now start at the index, those beyond move down
+	for (size_t i=iChunkFirst; i < _vecStarts.size(); ++i)
+	{
+		if (_vecStarts[i] > iBase)
+			_vecStarts[i] = max<size_t>(_vecStarts[i], iBase + cbBases) - cbBases;
+	}
+
+	balanceChunk(iChunkFirst+1);
+	balanceChunk(iChunkFirst);
+	hashChunks();
+}
+
+/*
+ * Function: splitChunk
+ *
+ * Split an oversized chunk into half-full chunks
+ */
+void
+BaseSequence::splitChunk(size_t iChunk)
+{
+	ENTER(GENOME,splitChunk);
+
+	if (_vecChunks[iChunk]->_strBases.length() <= s_cbMAXCHUNK)
+		return;
+
+	std::string& strChunk = ownChunk(iChunk);
+
+	CHUNKARRAY vecChunks;
+	NUMERICARRAY vecStarts;
+	for (size_t iOffset = (s_cbMAXCHUNK / 2); iOffset < strChunk.length(); iOffset += (s_cbMAXCHUNK / 2))
+	{
+		vecChunks.push_back(std::make_shared<Chunk>(strChunk, iOffset, (s_cbMAXCHUNK / 2)));
+		vecStarts.push_back(_vecStarts[iChunk] + iOffset);
+	}
+	strChunk.resize(s_cbMAXCHUNK / 2);
+
+	_vecChunks.insert(_vecChunks.begin() + iChunk + 1, vecChunks.begin(), vecChunks.end());
+	_vecStarts.insert(_vecStarts.begin() + iChunk + 1, vecStarts.begin(), vecStarts.end());
+}
+
+/*
+ * Function: balanceChunk
+ *
+ * Merge an undersized chunk into a neighbor, if the two fit within one chunk
+ */
+void
+BaseSequence::balanceChunk(size_t iChunk)
+{
+	ENTER(GENOME,balanceChunk);
+
+	if (iChunk >= _vecChunks.size() || _vecChunks[iChunk]->_strBases.length() >= s_cbMINCHUNK)
+		return;
+
+	if (	iChunk > 0
+		&&	(_vecChunks[iChunk-1]->_strBases.length() + _vecChunks[iChunk]->_strBases.length()) <= s_cbMAXCHUNK)
+		--iChunk;
+	else if (	(iChunk+1) >= _vecChunks.size()
+			||	(_vecChunks[iChunk]->_strBases.length() + _vecChunks[iChunk+1]->_strBases.length()) > s_cbMAXCHUNK)
+		return;
+
+	ownChunk(iChunk).append(_vecChunks[iChunk+1]->_strBases);
+	_vecChunks.erase(_vecChunks.begin() + iChunk + 1);
+	_vecStarts.erase(_vecStarts.begin() + iChunk + 1);
+}
+
+/*
+ * Function: hashChunks
+ *
+ * Hash the chunks changed (or created) since the last change
+ */
+void
+BaseSequence::hashChunks()
+{
+	ENTER(GENOME,hashChunks);
+
+	for (size_t iChunk=0; iChunk < _vecChunks.size(); ++iChunk)
+	{
+		if (!_vecChunks[iChunk]->_fHashed)
+			_vecChunks[iChunk]->rehash();
+	}
+}
+
+/*
+ * Function: rehash
+ *
+ */
+void
+BaseSequence::Chunk::rehash()
+{
+	_nHash = 0;
+	_nScale = 1;
+	for (size_t iBase=0; iBase < _strBases.length(); ++iBase)
+	{
+		_nHash = (_nHash * s_nHASHBASE) + static_cast<unsigned char>(_strBases[iBase]);
+		_nScale *= s_nHASHBASE;
+	}
+	_fHashed = true;
+}
+
+//--------------------------------------------------------------------------------
+//
+// Genome
+//
+//--------------------------------------------------------------------------------
+
+const char* Genome::s_aryGENOMESTATES[STGS_MAX] =
+{
+	"ALIVE",
+	"COMPILED",
+	"COMPILING",
+	"DEAD",
+	"INVALID",
+	"LOADING",
+	"MUTATING",
+	"RECORDING",
+	"ROLLBACK",
+	"RESTORING",
+	"SCORED",
+	"SCORING",
+	"SPAWNING",
+	"VALIDATED",
+	"VALIDATING"
+};
+
+thread_local std::string Genome::_strAuthor;
+thread_local CodonTable Genome::_ct;
+thread_local BaseSequence Genome::_seqBases;
+thread_local utime Genome::_tLoaded = 0L;
+thread_local std::string Genome::_strUUID;
+thread_local std::string Genome::_strStrain;
+thread_local std::string Genome::_strAncestors;
+
+thread_local bool Genome::_fReady;
+thread_local ROLLBACKTYPE Genome::_rollbackType = RT_ATTEMPT;
+
+thread_local Plan Genome::_plan;
+
+thread_local ST_STATISTICS Genome::_stats;
+thread_local ST_STATISTICS Genome::_statsRecordRate;
+thread_local STATISTICSARRAY Genome::_vecLineageStatistics;
+
+thread_local size_t Genome::_cRecordRate = 0;
+thread_local STFLAGS Genome::_grfRecordDetail = STRD_NONE;
+thread_local std::string Genome::_strRecordDirectory;
+thread_local size_t Genome::_fRecordHistory;
+
+thread_local bool Genome::_fGenesAssigned;
+thread_local GENEARRAY Genome::_vecGenes;
+thread_local std::bitset<Genome::s_maxGENES> Genome::_grfGenesInvalid;
+
+thread_local FitnessCache Genome::_cacheFitness;
+thread_local bool Genome::_fScoresCached = false;
+
+thread_local UNIT Genome::_nScoreBound = 0;
+thread_local bool Genome::_fBoundFitness = false;
+thread_local bool Genome::_fScoreBounded = false;
+
+thread_local ModificationStack Genome::_msModifications;
+thread_local AttemptHistory Genome::_ahAttempts;
+thread_local AttemptHistory Genome::_ahConsiderations;
+
+thread_local ST_GENOMESTATE Genome::_gsCurrent = STGS_DEAD;
+
+thread_local ST_GENOMETERMINATION Genome::_gaTermination = STGT_NONE;
+thread_local ST_GENOMEREASON Genome::_grTermination = STGR_NONE;
+thread_local Description Genome::_dsTermination;
+thread_local ST_PFNSTATUS Genome::_mutationCallback;
+thread_local std::string Genome::_mutationFullString;
+
+#ifdef ST_DEBUG
+thread_local Unit Genome::_nFitnessPassing;
+thread_local bool Genome::_fTestingRollback = false;
+#endif
+
+/*
+ * Function: initialize
+ *
+ * Initializes all internal state, including values through public methods.
+ */
+void
+Genome::initialize()
+{
+	ENTER(GENOME,initialize);
+	ASSERT(!_plan.isExecuting());
+
+	_ct.reset();
+	_seqBases.clear();
+	_tLoaded = 0L;
+	_strUUID.clear();
+	_strStrain.clear();
+	_strAncestors.clear();
+
+	_fReady = false;
+
+	_plan.clear();
+
+	clearStatistics(_stats, 0);
+	clearStatistics(_statsRecordRate, 0);
+	_vecLineageStatistics.clear();
+
+	_fGenesAssigned = false;
+	_vecGenes.clear();
+	_grfGenesInvalid.set();
+
+	_cacheFitness.clear();
+	_fScoresCached = false;
+
+	purgeModifications();
+
+	_gsCurrent = STGS_DEAD;
+	
+	_gaTermination = STGT_NONE;
+	_grTermination = STGR_NONE;
+	_dsTermination.clear();
+
+    _rollbackType = RT_ATTEMPT;
+
+	Globals::enableTracing(getTrial(), getTrialAttempts());
+	
+#ifdef ST_DEBUG
+	_nFitnessPassing = 0;
+	_fTestingRollback = false;
+#endif
+}
+
+/*
+ * Function: clearStatistics
+ *
+ */
+void
+Genome::clearStatistics(ST_STATISTICS& stats, size_t iTrial)
+{
+	ENTER(GENOME,clearStatistics);
+	
+	::memset(&stats, 0, sizeof(stats));
+	
+	stats._nScore = 0.0;
+	stats._nUnits = 0.0;
+	stats._nCost = 0.0;
+	stats._nFitness = 0.0;
+
+	stats._iTrialInitial =
+	stats._iTrialCurrent =
+	stats._tsMax._iTrial =
+	stats._tsMin._iTrial =
+	stats._tuMax._iTrial =
+	stats._tuMin._iTrial =
+	stats._tcMax._iTrial =
+	stats._tcMin._iTrial =
+	stats._tfMax._iTrial =
+	stats._tfMin._iTrial =
+	stats._trMax._iTrial =
+	stats._trMin._iTrial =
+	stats._tzMax._iTrial =
+	stats._tzMin._iTrial = iTrial;
+
+	stats._tsMax._nValue = 0.0;
+	stats._tsMin._nValue = 1.0;
+	
+	stats._tuMax._nValue = 0.0;
+	stats._tuMin._nValue = numeric_limits<size_t>::max();
+	
+	stats._tcMax._nValue = 0.0;
+	stats._tcMin._nValue = numeric_limits<size_t>::max();
+	
+	stats._tfMax._nValue = 0.0;
+	stats._tfMin._nValue = 1.0;
+	
+	stats._trMin._cRollbacks = numeric_limits<size_t>::max();
+	
+	stats._cbBases = _seqBases.length();
+	stats._tzMax._cbBases = stats._cbBases;
+	stats._tzMin._cbBases = stats._tzMax._cbBases;
+}
+
+/*
+ * Function: terminate
+ *
+ */
+void
+Genome::terminate()
+{
+	ENTER(GENOME,terminate);
+	ASSERT(!_plan.isExecuting());
+}
+
+/*
+ * Function: exchangeContext
+ *
+ * Exchange the Genome state of the calling thread with the passed context.
+ */
+void
+Genome::exchangeContext(GenomeContext& gc)
+{
+	ENTER(GENOME,exchangeContext);
+	ASSERT(!_plan.isExecuting());
+
+	_strAuthor.swap(gc._strAuthor);
+	std::swap(_ct, gc._ct);
+	_seqBases.swap(gc._seqBases);
+	std::swap(_tLoaded, gc._tLoaded);
+
+	_strUUID.swap(gc._strUUID);
+	_strStrain.swap(gc._strStrain);
+	_strAncestors.swap(gc._strAncestors);
+
+	std::swap(_fReady, gc._fReady);
+	std::swap(_rollbackType, gc._rollbackType);
+
+	std::swap(_plan, gc._plan);
+
+	std::swap(_stats, gc._stats);
+	std::swap(_statsRecordRate, gc._statsRecordRate);
+	_vecLineageStatistics.swap(gc._vecLineageStatistics);
+
+	std::swap(_cRecordRate, gc._cRecordRate);
+	std::swap(_grfRecordDetail, gc._grfRecordDetail);
+	_strRecordDirectory.swap(gc._strRecordDirectory);
+
+	std::swap(_fRecordHistory, gc._fRecordHistory);
+
+	std::swap(_fGenesAssigned, gc._fGenesAssigned);
+	_vecGenes.swap(gc._vecGenes);
+	std::swap(_grfGenesInvalid, gc._grfGenesInvalid);
+
+	_cacheFitness.swap(gc._cacheFitness);
+	std::swap(_fScoresCached, gc._fScoresCached);
+
+	_msModifications.swap(gc._msModifications);
+	_ahAttempts.swap(gc._ahAttempts);
+	_ahConsiderations.swap(gc._ahConsiderations);
+
+	std::swap(_gsCurrent, gc._gsCurrent);
+
+	std::swap(_gaTermination, gc._gaTermination);
+	std::swap(_grTermination, gc._grTermination);
+	std::swap(_dsTermination, gc._dsTermination);
+	std::swap(_mutationCallback, gc._mutationCallback);
+	_mutationFullString.swap(gc._mutationFullString);
+
+#ifdef ST_DEBUG
+	std::swap(_nFitnessPassing, gc._nFitnessPassing);
+	std::swap(_fTestingRollback, gc._fTestingRollback);
+#endif
+}
+
+/*
+ * Function: copyContext
+ *
+ * Copy into the passed context the Genome state needed to mutate, validate,
+ * and rollback the genome on a worker thread. Modifications, attempt history,
+ * and the plan are not copied.
+ *
+ * NOTES:
+ * - The copied scores are marked as not-a-number so that mergeContext can
+ *   detect whether the worker scored the genome
+ */
+void
+Genome::copyContext(GenomeContext& gc)
+{
+	ENTER(GENOME,copyContext);
+
+	gc._ct = _ct;
+	gc._seqBases = _seqBases;
+	gc._tLoaded = _tLoaded;
+
+	gc._fReady = _fReady;
+	gc._rollbackType = _rollbackType;
+
+	gc._stats = _stats;
+	gc._statsRecordRate = _statsRecordRate;
+	gc._stats._nScore = gc._stats._nUnits = gc._stats._nCost = gc._stats._nFitness = numeric_limits<UNIT>::quiet_NaN();
+	gc._statsRecordRate._nScore = gc._statsRecordRate._nUnits = gc._statsRecordRate._nCost = gc._statsRecordRate._nFitness = numeric_limits<UNIT>::quiet_NaN();
+
+	gc._fGenesAssigned = _fGenesAssigned;
+	gc._vecGenes = _vecGenes;
+	gc._grfGenesInvalid = _grfGenesInvalid;
+
+	gc._cacheFitness = _cacheFitness;
+	gc._fScoresCached = _fScoresCached;
+
+	gc._gsCurrent = _gsCurrent;
+
+#ifdef ST_DEBUG
+	gc._nFitnessPassing = _nFitnessPassing;
+#endif
+}
 
-std::string Genome::_strAuthor;
-CodonTable Genome::_ct;
-std::string Genome::_strBases;
-utime Genome::_tLoaded = 0L;
-std::string Genome::_strUUID;
-std::string Genome::_strStrain;
-std::string Genome::_strAncestors;
+/*
+ * Function: cloneContext
+ *
+ * Copy into the passed context the Genome state needed to execute the loaded
+ * plan as a separate lineage. Unlike copyContext, the scores, plan, recording
+ * options, and termination are retained. Modifications, attempt history, and
+ * the mutation callback are not copied.
+ */
+void
+Genome::cloneContext(GenomeContext& gc)
+{
+	ENTER(GENOME,cloneContext);
 
-bool Genome::_fReady;
-ROLLBACKTYPE Genome::_rollbackType;
+	copyContext(gc);
 
-Plan Genome::_plan;
+	gc._strAuthor = _strAuthor;
+	gc._strUUID = _strUUID;
+	gc._strStrain = _strStrain;
+	gc._strAncestors = _strAncestors;
 
-ST_STATISTICS Genome::_stats;
-ST_STATISTICS Genome::_statsRecordRate;
+	gc._plan = _plan;
 
-size_t Genome::_cRecordRate = 0;
-STFLAGS Genome::_grfRecordDetail = STRD_NONE;
-std::string Genome::_strRecordDirectory;
-size_t Genome::_fRecordHistory;
+	gc._stats = _stats;
+	gc._statsRecordRate = _statsRecordRate;
 
-bool Genome::_fGenesAssigned;
-GENEARRAY Genome::_vecGenes;
-std::bitset<Genome::s_maxGENES> Genome::_grfGenesInvalid;
+	gc._cRecordRate = _cRecordRate;
+	gc._grfRecordDetail = _grfRecordDetail;
+	gc._strRecordDirectory = _strRecordDirectory;
+	gc._fRecordHistory = _fRecordHistory;
 
-ModificationStack Genome::_msModifications;
-MODIFICATIONSTACKARRAY Genome::_vecAttempts;
-MODIFICATIONSTACKARRAY Genome::_vecConsiderations;
+	gc._gaTermination = _gaTermination;
+	gc._grTermination = _grTermination;
+	gc._dsTermination = _dsTermination;
+	gc._mutationCallback = NULL;
+}
 
-ST_GENOMESTATE Genome::_gsCurrent;
+/*
+ * Function: adoptContext
+ *
+ * Replace the genome with that held by the passed context (cloned from the
+ * passed lineage). Only the bases, genes, and scores are taken; the trial
+ * and accumulated statistics remain those of the Genome.
+ *
+ * NOTES:
+ * - The adopted genome becomes the last stable state, so any recorded
+ *   modifications are discarded
+ */
+void
+Genome::adoptContext(const GenomeContext& gc, size_t iLineage)
+{
+	ENTER(GENOME,adoptContext);
+	ASSERT(isState(STGS_ALIVE));
 
-ST_GENOMETERMINATION Genome::_gaTermination = STGT_NONE;
-ST_GENOMEREASON Genome::_grTermination = STGR_NONE;
-std::string Genome::_strTermination;
-ST_PFNSTATUS Genome::_mutationCallback;
-std::string Genome::_mutationFullString;
+	LOGINFO((LLINFO, "Trial %lu adopted the genome of lineage %lu (fitness %f replaces %f)",
+					getTrial(), iLineage, static_cast<UNIT>(gc._stats._nFitness), static_cast<UNIT>(_stats._nFitness)));
 
-#ifdef ST_DEBUG
-Unit Genome::_nFitnessPassing;
-bool Genome::_fTestingRollback = false;
-#endif
+	_seqBases = gc._seqBases;
+
+	_fGenesAssigned = gc._fGenesAssigned;
+	_vecGenes = gc._vecGenes;
+	_grfGenesInvalid = gc._grfGenesInvalid;
+
+	_stats._cbBases = _statsRecordRate._cbBases = _seqBases.length();
+	_stats._nScore = _statsRecordRate._nScore = gc._stats._nScore;
+	_stats._nUnits = _statsRecordRate._nUnits = gc._stats._nUnits;
+	_stats._nCost = _statsRecordRate._nCost = gc._stats._nCost;
+	_stats._nFitness = _statsRecordRate._nFitness = gc._stats._nFitness;
+
+	_strUUID.clear();
+
+	purgeModifications();
+}
 
 /*
- * Function: initialize
+ * Function: adoptContext
  *
- * Initializes all internal state, including values through public methods.
+ * Replace the genome with the outcome of a successful attempt executed by a
+ * worker, as though the calling thread had made the attempt: the bases,
+ * genes, scores, state, and modifications are taken from the context and its
+ * statistics and history are merged (see mergeContext). The passed statistics
+ * are those the worker context was copied from.
  */
 void
-Genome::initialize()
+Genome::adoptContext(GenomeContext& gc, const ST_STATISTICS& stats, const ST_STATISTICS& statsRecordRate)
 {
-	ENTER(GENOME,initialize);
-	ASSERT(!_plan.isExecuting());
+	ENTER(GENOME,adoptContext);
+	ASSERT(_msModifications.isEmpty());
 
-	_ct.reset();
-	_strBases.clear();
-	_tLoaded = 0L;
-	_strUUID.clear();
-	_strStrain.clear();
-	_strAncestors.clear();
+	mergeStatistics(_stats, stats, gc._stats);
+	mergeStatistics(_statsRecordRate, statsRecordRate, gc._statsRecordRate);
 
-	_fReady = false;
+	_cacheFitness.merge(gc._cacheFitness);
 
-	_plan.clear();
+	_ahAttempts.merge(gc._ahAttempts, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
+	_ahConsiderations.merge(gc._ahConsiderations, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
 
-	clearStatistics(_stats, 0);
-	clearStatistics(_statsRecordRate, 0);
+	_seqBases.swap(gc._seqBases);
+	_stats._cbBases = _statsRecordRate._cbBases = _seqBases.length();
 
-	_fGenesAssigned = false;
-	_vecGenes.clear();
-	_grfGenesInvalid.set();
+	std::swap(_fReady, gc._fReady);
+	std::swap(_rollbackType, gc._rollbackType);
 
-	purgeModifications();
+	std::swap(_fGenesAssigned, gc._fGenesAssigned);
+	_vecGenes.swap(gc._vecGenes);
+	std::swap(_grfGenesInvalid, gc._grfGenesInvalid);
+	std::swap(_fScoresCached, gc._fScoresCached);
 
-	_gsCurrent = STGS_DEAD;
-	
-	_gaTermination = STGT_NONE;
-	_grTermination = STGR_NONE;
-	_strTermination.clear();
+	_msModifications.swap(gc._msModifications);
 
-    _rollbackType = RT_ATTEMPT;
+	std::swap(_gsCurrent, gc._gsCurrent);
+
+	if (gc._gaTermination != STGT_NONE)
+		recordTermination(gc._gaTermination, gc._grTermination, gc._dsTermination);
 
-	Globals::enableTracing(getTrial(), getTrialAttempts());
-	
 #ifdef ST_DEBUG
-	_nFitnessPassing = 0;
-	_fTestingRollback = false;
+	std::swap(_nFitnessPassing, gc._nFitnessPassing);
 #endif
 }
 
 /*
- * Function: clearStatistics
+ * Function: mergeContext
  *
+ * Merge into the Genome the statistics and history collected by a worker.
+ * The passed statistics are those the worker context was copied from.
+ * Contexts must be merged in the same order their work would have occurred
+ * serially.
  */
 void
-Genome::clearStatistics(ST_STATISTICS& stats, size_t iTrial)
+Genome::mergeContext(GenomeContext& gc, const ST_STATISTICS& stats, const ST_STATISTICS& statsRecordRate)
 {
-	ENTER(GENOME,clearStatistics);
-	
-	::memset(&stats, 0, sizeof(stats));
-	
-	stats._nScore = 0.0;
-	stats._nUnits = 0.0;
-	stats._nCost = 0.0;
-	stats._nFitness = 0.0;
+	ENTER(GENOME,mergeContext);
+	ASSERT(gc._seqBases == _seqBases);
 
-	stats._iTrialInitial =
-	stats._iTrialCurrent =
-	stats._tsMax._iTrial =
-	stats._tsMin._iTrial =
-	stats._tuMax._iTrial =
-	stats._tuMin._iTrial =
-	stats._tcMax._iTrial =
-	stats._tcMin._iTrial =
-	stats._tfMax._iTrial =
-	stats._tfMin._iTrial =
-	stats._trMax._iTrial =
-	stats._trMin._iTrial =
-	stats._tzMax._iTrial =
-	stats._tzMin._iTrial = iTrial;
+	mergeStatistics(_stats, stats, gc._stats);
+	mergeStatistics(_statsRecordRate, statsRecordRate, gc._statsRecordRate);
 
-	stats._tsMax._nValue = 0.0;
-	stats._tsMin._nValue = 1.0;
-	
-	stats._tuMax._nValue = 0.0;
-	stats._tuMin._nValue = numeric_limits<size_t>::max();
-	
-	stats._tcMax._nValue = 0.0;
-	stats._tcMin._nValue = numeric_limits<size_t>::max();
-	
-	stats._tfMax._nValue = 0.0;
-	stats._tfMin._nValue = 1.0;
-	
-	stats._trMin._cRollbacks = numeric_limits<size_t>::max();
-	
-	stats._cbBases = _strBases.length();
-	stats._tzMax._cbBases = stats._cbBases;
-	stats._tzMin._cbBases = stats._tzMax._cbBases;
+	_cacheFitness.merge(gc._cacheFitness);
+
+	_ahAttempts.merge(gc._ahAttempts, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
+	_ahConsiderations.merge(gc._ahConsiderations, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
 }
 
 /*
- * Function: terminate
+ * Function: mergeStatistics
  *
+ * Add to the passed statistics the counts accumulated between statsBefore and
+ * statsAfter and, if statsAfter was scored, take its scores.
  */
 void
-Genome::terminate()
+Genome::mergeStatistics(ST_STATISTICS& stats, const ST_STATISTICS& statsBefore, const ST_STATISTICS& statsAfter)
 {
-	ENTER(GENOME,terminate);
-	ASSERT(!_plan.isExecuting());
+	ENTER(GENOME,mergeStatistics);
+
+	if (!std::isnan(statsAfter._nScore))
+	{
+		stats._nScore = statsAfter._nScore;
+		stats._nUnits = statsAfter._nUnits;
+		stats._nCost = statsAfter._nCost;
+		stats._nFitness = statsAfter._nFitness;
+	}
+
+	stats._cTrialAttempts += statsAfter._cTrialAttempts - statsBefore._cTrialAttempts;
+	stats._cRollbacks += statsAfter._cRollbacks - statsBefore._cRollbacks;
+	stats._cTotalRollbacks += statsAfter._cTotalRollbacks - statsBefore._cTotalRollbacks;
+
+	stats._cbBasesChanged += statsAfter._cbBasesChanged - statsBefore._cbBasesChanged;
+	stats._cbBasesInserted += statsAfter._cbBasesInserted - statsBefore._cbBasesInserted;
+	stats._cbBasesDeleted += statsAfter._cbBasesDeleted - statsBefore._cbBasesDeleted;
+
+	stats._cSilent += statsAfter._cSilent - statsBefore._cSilent;
+	stats._cAttempted += statsAfter._cAttempted - statsBefore._cAttempted;
+	stats._cConsidered += statsAfter._cConsidered - statsBefore._cConsidered;
+	stats._cAccepted += statsAfter._cAccepted - statsBefore._cAccepted;
+	stats._cCacheHits += statsAfter._cCacheHits - statsBefore._cCacheHits;
+	stats._cCacheMisses += statsAfter._cCacheMisses - statsBefore._cCacheMisses;
+
+	mergeAttempts(stats._atChanged, statsBefore._atChanged, statsAfter._atChanged);
+	mergeAttempts(stats._atCopied, statsBefore._atCopied, statsAfter._atCopied);
+	mergeAttempts(stats._atDeleted, statsBefore._atDeleted, statsAfter._atDeleted);
+	mergeAttempts(stats._atInserted, statsBefore._atInserted, statsAfter._atInserted);
+	mergeAttempts(stats._atTransposed, statsBefore._atTransposed, statsAfter._atTransposed);
+}
+
+/*
+ * Function: mergeAttempts
+ *
+ */
+void
+Genome::mergeAttempts(ST_ATTEMPTS& attempts, const ST_ATTEMPTS& attemptsBefore, const ST_ATTEMPTS& attemptsAfter)
+{
+	attempts._cConsidered += attemptsAfter._cConsidered - attemptsBefore._cConsidered;
+	attempts._cAttempted += attemptsAfter._cAttempted - attemptsBefore._cAttempted;
+	attempts._cAccepted += attemptsAfter._cAccepted - attemptsBefore._cAccepted;
+	attempts._cbBases += attemptsAfter._cbBases - attemptsBefore._cbBases;
 }
 
 /*
@@ -546,12 +1793,14 @@ Genome::setGenome(const char* pxmlGenome, const char* pszAuthor)
 			THROWRC((RC(XMLERROR), "Unexpected number of bases elements"));
 
 		pxn = spxpo->nodesetval->nodeTab[0];
-		spxd->getContent(pxn, _strBases);
+		string strBases;
+		spxd->getContent(pxn, strBases);
+		_seqBases = strBases;
 		
-		if (_strBases.length() <= (2 * Codon::s_cchCODON))
+		if (_seqBases.length() <= (2 * Codon::s_cchCODON))
 			THROWRC((RC(XMLERROR), "Too few bases supplied - must contain at least %ld bases", (2 * Codon::s_cchCODON)));
 
-		_stats._cbBases = _strBases.length();
+		_stats._cbBases = _seqBases.length();
 		_stats._tzMax._cbBases = _stats._cbBases;
 		_stats._tzMin._cbBases = _stats._cbBases;
 		
@@ -693,27 +1942,13 @@ Genome::recordAttempt(const char* pszFileline, ST_TRACEREGION tr, const char* ps
 	ASSERT(VALID(pszFileline));
 	ASSERT(VALID(pszFormat));
 
-	char szTermination[Constants::s_cbmaxBUFFER];
-	char* pszTermination = szTermination;
-	size_t cbRemaining = SZ_OF(szTermination);
-	size_t cbWritten;
-	
+	// Record the description unformatted (it is formatted only when read)
 	va_list ap;
 	va_start(ap, pszFormat);
-
-	cbWritten = copyFileline(pszTermination, cbRemaining, pszFileline);
-	pszTermination += cbWritten;
-	cbRemaining -= cbWritten;
-
-	*pszTermination++ = Constants::s_chBLANK;
-	cbRemaining -= 1;
-	
-	::vsnprintf(pszTermination, cbRemaining, pszFormat, ap);
-
+	_msModifications.recordDescription(pszFileline, pszFormat, ap);
 	va_end(ap);
 
-	_msModifications.recordDescription(szTermination);
-	if (Globals::traceIf(tr, STTC_FLOW, STTL_L2)) LOGTRACE((LLTRACE, szTermination));
+	if (Globals::traceIf(tr, STTC_FLOW, STTL_L2)) LOGTRACE((LLTRACE, _msModifications.toString().c_str()));
 }
 
 /*
@@ -727,34 +1962,32 @@ Genome::recordTermination(const char* pszFileline, ST_GENOMETERMINATION ga, ST_G
 
 	ASSERT(VALID(pszFormat));
 
-	char szTermination[Constants::s_cbmaxBUFFER];
-	char* pszTermination = szTermination;
-	size_t cbRemaining = SZ_OF(szTermination);
-	size_t cbWritten;
-	
 	_gaTermination = ga;
 	_grTermination = gr;
 	
+	// Record the description unformatted (it is formatted only when read)
 	va_list ap;
 	va_start(ap, pszFormat);
+	_dsTermination.record(pszFileline, pszFormat, ap);
+	va_end(ap);
 
 	if (VALID(pszFileline))
-	{
-		cbWritten = copyFileline(pszTermination, cbRemaining, pszFileline);
-		pszTermination += cbWritten;
-		cbRemaining -= cbWritten;
-
-		*pszTermination++ = Constants::s_chBLANK;
-		cbRemaining -= 1;
-	}
-	
-	::vsnprintf(pszTermination, cbRemaining, pszFormat, ap);
+		LOGINFO((LLINFO, _dsTermination.toString().c_str()));
+}
 
-	va_end(ap);
+/*
+ * Function: recordTermination
+ *
+ * Record a termination previously recorded elsewhere (e.g., by another thread)
+ */
+void
+Genome::recordTermination(ST_GENOMETERMINATION ga, ST_GENOMEREASON gr, const Description& dsTermination)
+{
+	ENTER(GENOME,recordTermination);
 
-	_strTermination = szTermination;
-	if (VALID(pszFileline))
-		LOGINFO((LLINFO, szTermination));
+	_gaTermination = ga;
+	_grTermination = gr;
+	_dsTermination = dsTermination;
 }
 
 /*
@@ -774,13 +2007,14 @@ Genome::getTermination(ST_GENOMETERMINATION* pgt, ST_GENOMEREASON* pgr, char* ps
 
 	if (VALID(pszTermination) && VALID(pcchTermination))
 	{
-		if (*pcchTermination < (_strTermination.length()+1))
+		std::string strTermination(_dsTermination.toString());
+		if (*pcchTermination < (strTermination.length()+1))
 		{
-			*pcchTermination = _strTermination.length() + 1;
+			*pcchTermination = strTermination.length() + 1;
 			THROWRC((RC(BUFFERTOOSMALL), "Termination buffer is too small - must be at least %ld bytes", *pcchTermination));
 		}
 
-		THROWIFERROR(copyBytes(pszTermination, pcchTermination, _strTermination.c_str(), _strTermination.length()));
+		THROWIFERROR(copyBytes(pszTermination, pcchTermination, strTermination.c_str(), strTermination.length()));
 		*(pszTermination+*pcchTermination) = Constants::s_chNULL;
 		++(*pcchTermination);
 	}
@@ -801,16 +2035,16 @@ Genome::toString()
 void 
 Genome::writeConsiderations(XMLStream & xs, STFLAGS grfRecordDetail)
 {
-    if( !_vecConsiderations.empty() && ST_ISANYSET(grfRecordDetail, STRD_LINEAGEALL)
+    if( !_ahConsiderations.empty() && ST_ISANYSET(grfRecordDetail, STRD_LINEAGEALL)
 )
     {
         xs.openStart(xmlTag(XT_COMPAREDMUTATIONS));
         xs.closeStart();
 
 
-        for (size_t iAttempt=0; iAttempt < _vecConsiderations.size(); ++iAttempt)
+        for (size_t iAttempt=0; iAttempt < _ahConsiderations.size(); ++iAttempt)
         {
-            const ModificationStack& ms = _vecConsiderations[iAttempt];
+            const ModificationStack& ms = _ahConsiderations[iAttempt];
 
             xs.openStart(xmlTag(XT_COMPARED));
             xs.writeAttribute(xmlTag(XT_DESCRIPTION), ms.toString());
@@ -861,7 +2095,7 @@ Genome::toXML(XMLStream& xs, STFLAGS grfRecordDetail, bool fUseTrialStatistics)
 	
 	// Add the bases element
 	xs.writeStart(xmlTag(XT_BASES), true, false);
-	xs.writeContent(_strBases);
+	xs.writeContent(_seqBases.str());
 	xs.writeEnd(xmlTag(XT_BASES));
 	
 	// Add termination code if one exists
@@ -870,7 +2104,7 @@ Genome::toXML(XMLStream& xs, STFLAGS grfRecordDetail, bool fUseTrialStatistics)
 		xs.openStart(xmlTag(XT_TERMINATION));
 		xs.writeAttribute(xmlTag(XT_TERMINATIONCODE), _gaTermination);
 		xs.writeAttribute(xmlTag(XT_REASONCODE), _grTermination);
-		xs.writeAttribute(xmlTag(XT_DESCRIPTION), _strTermination);
+		xs.writeAttribute(xmlTag(XT_DESCRIPTION), _dsTermination.toString());
 		xs.closeStart(false);
 	}
 	
@@ -905,7 +2139,7 @@ Genome::toXML(XMLStream& xs, STFLAGS grfRecordDetail, bool fUseTrialStatistics)
 		{
 			if (ST_ISANYSET(grfRecordDetail, STRD_STATISTICS))
 			{
-				ASSERT(stats._cbBases == _strBases.length());
+				ASSERT(stats._cbBases == _seqBases.length());
 				xs.writeAttribute(xmlTag(XT_COUNTBASES), stats._cbBases);
 				xs.writeAttribute(xmlTag(XT_COUNTROLLBACKS), stats._cRollbacks);
 			}
@@ -1058,12 +2292,12 @@ Genome::toXML(XMLStream& xs, STFLAGS grfRecordDetail, bool fUseTrialStatistics)
 		}
 
 		
-		if (_vecAttempts.size() && ST_ISANYSET(grfRecordDetail, STRD_LINEAGEALL))
+		if (_ahAttempts.size() && ST_ISANYSET(grfRecordDetail, STRD_LINEAGEALL))
 		{
 			xs.writeStart(xmlTag(XT_REJECTEDMUTATIONS));
-			for (size_t iAttempt=0; iAttempt < _vecAttempts.size(); ++iAttempt)
+			for (size_t iAttempt=0; iAttempt < _ahAttempts.size(); ++iAttempt)
 			{
-				const ModificationStack& ms = _vecAttempts[iAttempt];
+				const ModificationStack& ms = _ahAttempts[iAttempt];
 				
 				xs.openStart(xmlTag(XT_ATTEMPT));
 				xs.writeAttribute(xmlTag(XT_DESCRIPTION), ms.toString());
@@ -1342,6 +2576,7 @@ Genome::doRollback()
 bool
 Genome::rollback()
 {
+	_fScoresCached = false;
     return (	Genome::enterState(STGS_ROLLBACK)
             &&	Genome::exitState(Genome::doRollback));
 }
@@ -1357,22 +2592,39 @@ Genome::doScoring()
 	ENTER(SCORING,doScoring);
 	ASSERT(isState(STGS_SCORING));
 
+	// NOTE: This version of Stylus assumes and supports only a single gene
+	ASSERT(_vecGenes.size() == 1);
+	const Gene& gene = _vecGenes[0];
+	UNIT nCost = Globals::getGenomeWeight(SC_FIXEDCOST) + (Unit(Globals::getGenomeWeight(SC_COSTPERBASE)) * gene.getRange().getLength()) +  (Unit(Globals::getGenomeWeight(SC_COSTPERUNIT)) * gene.units());
+
 	// Score each contained gene
+	// - Scoring may stop once the gene cannot reach the score bound (fitness bounds
+	//   are taken relative to the cost, which does not depend upon the score)
+	UNIT nScoreBound = 0;
+	UNIT nBoundCost = 1;
+	if (_nScoreBound > 0 && (!_fBoundFitness || nCost > 0))
+	{
+		nScoreBound = _nScoreBound;
+		if (_fBoundFitness)
+			nBoundCost = nCost;
+	}
+
 	bool fSuccess = true;
+	_fScoreBounded = false;
 	for (size_t iGene=0; fSuccess && iGene < _vecGenes.size(); ++iGene)
 	{
 		if (_grfGenesInvalid.test(iGene))
-			fSuccess = _vecGenes[iGene].ensureScore();
+		{
+			fSuccess = _vecGenes[iGene].ensureScore(nScoreBound, nBoundCost);
+			_fScoreBounded = _fScoreBounded || _vecGenes[iGene].isScoreBounded();
+		}
 	}
 
-	// NOTE: This version of Stylus assumes and supports only a single gene
-	ASSERT(_vecGenes.size() == 1);
 	if (fSuccess)
 	{
-		const Gene& gene = _vecGenes[0];
 		_statsRecordRate._nScore = gene.score();
 		_statsRecordRate._nUnits = gene.units();
-		_statsRecordRate._nCost = Globals::getGenomeWeight(SC_FIXEDCOST) + (Unit(Globals::getGenomeWeight(SC_COSTPERBASE)) * gene.getRange().getLength()) +  (Unit(Globals::getGenomeWeight(SC_COSTPERUNIT)) * gene.units());
+		_statsRecordRate._nCost = nCost;
 		_statsRecordRate._nFitness = (_statsRecordRate._nScore / _statsRecordRate._nCost);
 
 		_stats._nScore = _statsRecordRate._nScore;
@@ -1400,6 +2652,9 @@ Genome::doScoring()
 
 bool Genome::recordStatistics(bool fPreserveErrors)
 {
+	if (_fScoresCached)
+		completeCached();
+
     if( _rollbackType & RT_ATTEMPT )
     {
         if (	_statsRecordRate._iTrialInitial > _statsRecordRate._tsMax._iTrial
@@ -1484,7 +2739,7 @@ bool Genome::recordStatistics(bool fPreserveErrors)
         {
             _gaTermination = STGT_NONE;
             _grTermination = STGR_NONE;
-            _strTermination.clear();
+            _dsTermination.clear();
         }
         
         if (	_statsRecordRate._iTrialInitial > _statsRecordRate._trMax._iTrial
@@ -1505,18 +2760,18 @@ bool Genome::recordStatistics(bool fPreserveErrors)
         }
 
         if (	_statsRecordRate._iTrialInitial > _statsRecordRate._tzMax._iTrial
-            ||	_strBases.length() > _statsRecordRate._tzMax._cbBases)
+            ||	_seqBases.length() > _statsRecordRate._tzMax._cbBases)
         {
             _statsRecordRate._tzMax._iTrial = _statsRecordRate._iTrialCurrent;
-            _statsRecordRate._tzMax._cbBases = _strBases.length();
+            _statsRecordRate._tzMax._cbBases = _seqBases.length();
             if (_statsRecordRate._tzMax._cbBases > _stats._tzMax._cbBases)
                 _stats._tzMax = _statsRecordRate._tzMax;
         }
         if (	_statsRecordRate._iTrialInitial > _statsRecordRate._tzMin._iTrial
-            ||	_strBases.length() < _statsRecordRate._tzMin._cbBases)
+            ||	_seqBases.length() < _statsRecordRate._tzMin._cbBases)
         {
             _statsRecordRate._tzMin._iTrial = _statsRecordRate._iTrialCurrent;
-            _statsRecordRate._tzMin._cbBases = _strBases.length();
+            _statsRecordRate._tzMin._cbBases = _seqBases.length();
             if (_statsRecordRate._tzMin._cbBases < _stats._tzMin._cbBases)
                 _stats._tzMin = _statsRecordRate._tzMin;
         }
@@ -1705,18 +2960,242 @@ Genome::validate(bool fPreserveErrors)
 
     ImpreciseMode impreciseMode;
 
+	// Use the cached outcome of validating identical genes, if any
+	size_t nKey = 0;
+	if (_cacheFitness.isEnabled())
+	{
+		nKey = cacheKey();
+		const FitnessCache::Entry* pEntry = _cacheFitness.find(nKey);
+		if (VALID(pEntry))
+		{
+			++_stats._cCacheHits;
+			++_statsRecordRate._cCacheHits;
+			return validateCached(*pEntry);
+		}
+
+		++_stats._cCacheMisses;
+		++_statsRecordRate._cCacheMisses;
+	}
+	_fScoresCached = false;
+	_fScoreBounded = false;
+
+	bool fScored = false;
 	bool fSuccess = false;
 	{
 		StateGuard sg(STGS_SCORED, STGS_INVALID);
 
-		fSuccess = (	enterState(STGS_COMPILING)
+		fScored = (		enterState(STGS_COMPILING)
 					&&	exitState(doCompilation)
 					&&	enterState(STGS_VALIDATING)
-					&&	exitState(doValidation)
+					&&	exitState(doValidation));
+		fSuccess = (	fScored
 					&&	enterState(STGS_SCORING)
 					&&	exitState(doScoring));
 	}
 
+	// Cache only complete scores (those stopped at a bound hold only upper bounds)
+	if (_cacheFitness.isEnabled() && !_fScoreBounded)
+	{
+		FitnessCache::Entry entry;
+		entry._fScored = fScored;
+		entry._fValid = fSuccess;
+		entry._nScore = _statsRecordRate._nScore;
+		entry._nUnits = _statsRecordRate._nUnits;
+		entry._nCost = _statsRecordRate._nCost;
+		entry._nFitness = _statsRecordRate._nFitness;
+		entry._gaTermination = (fSuccess ? STGT_NONE : _gaTermination);
+		entry._grTermination = (fSuccess ? STGR_NONE : _grTermination);
+		if (!fSuccess)
+		{
+			entry._dsTermination = _dsTermination;
+			entry._dsAttempt = _msModifications.getDescription();
+		}
+		_cacheFitness.insert(nKey, entry);
+	}
+
+	return fSuccess;
+}
+
+/*
+ * Function: cacheKey
+ *
+ * Build the fitness cache key for the genome from the hash and length of
+ * the bases of each gene and, for genes with assigned strokes, the acid
+ * range of each stroke.
+ */
+size_t
+Genome::cacheKey()
+{
+	ENTER(GENOME,cacheKey);
+
+	size_t nKey = 0;
+	for (size_t iGene=0; iGene < _vecGenes.size(); ++iGene)
+	{
+		const Gene& gene = _vecGenes[iGene];
+		const Range& rgBases = gene.getRange();
+
+		nKey = FitnessCache::combineKey(nKey, _seqBases.hash(rgBases.getStart(), rgBases.getLength()));
+		nKey = FitnessCache::combineKey(nKey, rgBases.getLength());
+
+		if (gene.hasAssignedStrokes())
+		{
+			const STROKEARRAY& vecStrokes = gene.getStrokes();
+			nKey = FitnessCache::combineKey(nKey, vecStrokes.size());
+			for (size_t iStroke=0; iStroke < vecStrokes.size(); ++iStroke)
+			{
+				const Range& rgAcids = vecStrokes[iStroke].getRange();
+				nKey = FitnessCache::combineKey(nKey, rgAcids.getStart());
+				nKey = FitnessCache::combineKey(nKey, rgAcids.getEnd());
+			}
+		}
+	}
+
+	return nKey;
+}
+
+/*
+ * Function: validateCached
+ *
+ * Replay a cached validation outcome. A success moves the genome to SCORED
+ * with the cached scores, leaving the genes themselves unvalidated until the
+ * genome is accepted (see completeCached); a failure records the cached
+ * termination and leaves the genome INVALID.
+ */
+bool
+Genome::validateCached(const FitnessCache::Entry& entry)
+{
+	ENTER(GENOME,validateCached);
+	ASSERT(isState(STGS_INVALID));
+
+	bool fSuccess = false;
+	{
+		StateGuard sg(STGS_SCORED, STGS_INVALID);
+
+		if (entry._fScored)
+		{
+			_statsRecordRate._nScore = entry._nScore;
+			_statsRecordRate._nUnits = entry._nUnits;
+			_statsRecordRate._nCost = entry._nCost;
+			_statsRecordRate._nFitness = entry._nFitness;
+		}
+
+		if (entry._fValid)
+		{
+			_stats._nScore = entry._nScore;
+			_stats._nUnits = entry._nUnits;
+			_stats._nCost = entry._nCost;
+			_stats._nFitness = entry._nFitness;
+
+			_fScoresCached = true;
+			fSuccess = (	enterState(STGS_VALIDATING)
+						&&	exitState()
+						&&	enterState(STGS_SCORING)
+						&&	exitState());
+		}
+		else
+		{
+			_fScoresCached = false;
+			_gaTermination = entry._gaTermination;
+			_grTermination = entry._grTermination;
+			_dsTermination = entry._dsTermination;
+			if (!entry._dsAttempt.isEmpty())
+				_msModifications.recordDescription(entry._dsAttempt);
+		}
+	}
+
+	return fSuccess;
+}
+
+/*
+ * Function: completeCached
+ *
+ * Validate and score the genes of an accepted genome whose scores came from
+ * the fitness cache.
+ */
+void
+Genome::completeCached()
+{
+	ENTER(GENOME,completeCached);
+	ASSERT(_fScoresCached);
+
+	ImpreciseMode impreciseMode;
+
+	_fScoresCached = false;
+	for (size_t iGene=0; iGene < _vecGenes.size(); ++iGene)
+	{
+		if (	_grfGenesInvalid.test(iGene)
+			&&	!(	_vecGenes[iGene].ensureCompiled()
+				&&	_vecGenes[iGene].ensureValid()
+				&&	_vecGenes[iGene].ensureScore()))
+			THROWRC((RC(ERROR), "Gene %ld failed validation after scoring from the fitness cache", iGene));
+	}
+}
+
+/*
+ * Function: takeSnapshot
+ *
+ * Preserve the validated and scored genes of the mutated genome (see
+ * restoreSnapshot).
+ */
+void
+Genome::takeSnapshot(GenomeSnapshot& gs)
+{
+	ENTER(GENOME,takeSnapshot);
+	ASSERT(isState(STGS_SCORED));
+
+	gs._vecGenes = _vecGenes;
+	gs._grfGenesInvalid = _grfGenesInvalid;
+	gs._fScoresCached = _fScoresCached;
+	gs._msModifications = _msModifications;
+
+	gs._nScore = _statsRecordRate._nScore;
+	gs._nUnits = _statsRecordRate._nUnits;
+	gs._nCost = _statsRecordRate._nCost;
+	gs._nFitness = _statsRecordRate._nFitness;
+}
+
+/*
+ * Function: restoreSnapshot
+ *
+ * Take the genes and scores preserved by the snapshot in place of validating
+ * the genome. The mutations that produced the snapshot must have just been
+ * re-applied (which restores the bases and mutation statistics); the
+ * modifications they recorded are replaced by those preserved by the
+ * snapshot, which include any recorded during validation.
+ *
+ * NOTES:
+ * - The snapshot is consumed
+ */
+bool
+Genome::restoreSnapshot(GenomeSnapshot& gs)
+{
+	ENTER(GENOME,restoreSnapshot);
+	REQUIRENOTDEAD(restoreSnapshot);
+
+	if (!isState(STGS_INVALID))
+		THROWRC((RC(INVALIDSTATE),
+				 "Attempt to restore a genome snapshot while incorrect state (%s)", stateToString()));
+
+	bool fSuccess = false;
+	{
+		StateGuard sg(STGS_SCORED, STGS_INVALID);
+
+		_vecGenes.swap(gs._vecGenes);
+		_grfGenesInvalid = gs._grfGenesInvalid;
+		_fScoresCached = gs._fScoresCached;
+		_msModifications.swap(gs._msModifications);
+
+		_stats._nScore = _statsRecordRate._nScore = gs._nScore;
+		_stats._nUnits = _statsRecordRate._nUnits = gs._nUnits;
+		_stats._nCost = _statsRecordRate._nCost = gs._nCost;
+		_stats._nFitness = _statsRecordRate._nFitness = gs._nFitness;
+
+		fSuccess = (	enterState(STGS_VALIDATING)
+					&&	exitState()
+					&&	enterState(STGS_SCORING)
+					&&	exitState());
+	}
+
 	return fSuccess;
 }
 
@@ -1735,16 +3214,16 @@ Genome::purgeModifications(bool fPreserveAttempts)
 		TFLOW(GENOME,L3,(LLTRACE, "Saving %ld changes to failed change history", _msModifications.length()));
 		ASSERT(_msModifications.length() <= 0 || !EMPTYSTR(_msModifications.toString()))
         if( _rollbackType & RT_ATTEMPT )
-            _vecAttempts.push_back(_msModifications);
+            _ahAttempts.record(_msModifications, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
         if( _rollbackType & RT_CONSIDERATION )
-            _vecConsiderations.push_back(_msModifications);
+            _ahConsiderations.record(_msModifications, _plan.getAttemptHistory(), _plan.getAttemptHistorySize());
 	}
 
 	// Otherwise, delete all history
 	else
 	{
-		_vecAttempts.clear();
-        _vecConsiderations.clear();
+		_ahAttempts.clear();
+        _ahConsiderations.clear();
 	}
 	_msModifications.clear();
 
@@ -1794,11 +3273,11 @@ Genome::rgenLength(size_t cbLength, bool fWholeCodons)
 string&
 Genome::rgenTransversion(size_t iTarget, string& strBases, UNIT nTransversionLikelihood)
 {
-	ASSERT(iTarget >= 0 && iTarget < _strBases.length());
+	ASSERT(iTarget >= 0 && iTarget < _seqBases.length());
 
 	// Perform a transversion
 	Unit pTransversionLikelihood(nTransversionLikelihood);
-	char chBase = _strBases[iTarget];
+	char chBase = _seqBases[iTarget];
 	if (pTransversionLikelihood == 1.0 || pTransversionLikelihood >= RGenerator::getUniform())
 	{
 		strBases = (chBase == Constants::s_chBASET || chBase == Constants::s_chBASEC
@@ -1831,10 +3310,16 @@ Genome::rgenBases(string& strBases, size_t cbLength)
 	ASSERT(cbLength > 0);
 	ASSERT(Constants::s_strBASES.length() == 4);
 	
-	// Generate a string of the requested length
+	// Generate a string of the requested length (drawing the bases in batches)
+	long aryBases[64];
 	strBases.resize(cbLength);
-	for (size_t i=0; i < cbLength; ++i)
-		strBases[i] = Constants::s_strBASES[static_cast<size_t>(RGenerator::getUniform(0L,3L))];
+	for (size_t i=0; i < cbLength; i += ARRAY_LENGTH(aryBases))
+	{
+		size_t cb = min(cbLength - i, ARRAY_LENGTH(aryBases));
+		RGenerator::getUniform(0L, 3L, aryBases, cb);
+		for (size_t ib=0; ib < cb; ++ib)
+			strBases[i+ib] = Constants::s_strBASES[static_cast<size_t>(aryBases[ib])];
+	}
 
 	return strBases;
 }
@@ -1842,18 +3327,16 @@ Genome::rgenBases(string& strBases, size_t cbLength)
 void
 Genome::removeConsideration(size_t iConsideration)
 {
-    ASSERT(iConsideration >= 0 && iConsideration < _vecConsiderations.size() );
-    MODIFICATIONSTACKARRAY::iterator consideration = _vecConsiderations.begin();
-    std::advance(consideration, iConsideration);
-    _vecConsiderations.erase( consideration );
+    ASSERT(iConsideration >= 0 && iConsideration < _ahConsiderations.size() );
+    _ahConsiderations.erase(iConsideration);
 }
 
 std::string ModificationStack::toFullString() const 
 {   
     std::ostringstream ss;
-    for (MODIFICATIONARRAY::const_iterator iter = _vecModifications.begin(); iter != _vecModifications.end(); iter++)
+    for (RECORDARRAY::const_iterator iter = _vecRecords.begin(); iter != _vecRecords.end(); iter++)
     {
-        ss << (*iter)->toString() << "\n";
+        ss << recordToString(*iter) << "\n";
     }
     ss << toString();
     return ss.str();
@@ -1882,6 +3365,9 @@ Genome::testRollback()
 		return true;
 	_fTestingRollback = true;
 
+	// Validate and score under the same error margin as validate
+	ImpreciseMode impreciseMode;
+
 	Unit nFitnessPassing = _nFitnessPassing;
 	ST_GENOMESTATE gsCurrent = _gsCurrent;
 	ST_STATISTICS stats = _stats;
@@ -1902,37 +3388,51 @@ Genome::testRollback()
 	{
 		fSuccess = enterState(STGS_INVALID);
 		if (!fSuccess)
-			TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter INVALID state, state is %s", stateToString()))
+		{
+			TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter INVALID state, state is %s", stateToString()));
+		}
 		else
 		{
 			fSuccess = enterState(STGS_COMPILING);
 			if (!fSuccess)
-				TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter COMPILING state, state is %s", stateToString()))
+			{
+				TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter COMPILING state, state is %s", stateToString()));
+			}
 			else
 			{
 				fSuccess = exitState(doCompilation);
 				if (!fSuccess)
-					TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to exit COMPILING state, state is %s", stateToString()))
+				{
+					TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to exit COMPILING state, state is %s", stateToString()));
+				}
 				else
 				{
 					fSuccess = enterState(STGS_VALIDATING);
 					if (!fSuccess)
-						TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter VALIDATING state, state is %s", stateToString()))
+					{
+						TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter VALIDATING state, state is %s", stateToString()));
+					}
 					else
 					{
 						fSuccess = exitState(doValidation);
 						if (!fSuccess)
-							TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to exit VALIDATING state, state is %s", stateToString()))
+						{
+							TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to exit VALIDATING state, state is %s", stateToString()));
+						}
 						else
 						{
 							fSuccess = enterState(STGS_SCORING);
 							if (!fSuccess)
-								TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter SCORING state, state is %s", stateToString()))
+							{
+								TFLOW(GENOME,L2,(LLTRACE, "Rollback test unable to enter SCORING state, state is %s", stateToString()));
+							}
 							else
 							{
 								fSuccess = exitState(doScoring);
 								if (!fSuccess)
-									TFLOW(GENOME,L2,(LLTRACE, "Rollback test failed to exit SCORING state, state is %s", stateToString()))
+								{
+									TFLOW(GENOME,L2,(LLTRACE, "Rollback test failed to exit SCORING state, state is %s", stateToString()));
+								}
 								else
 								{
 									fSuccess = (_nFitnessPassing == nFitnessPassing);
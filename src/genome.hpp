@@ -6,10 +6,11 @@
  * mutations, and evaluates the contained Scribbles (if any) against the
  * appropriate Han forms (if any).
  *
- * The current implementation supports only one Genome per Stylus instance.
- * This is enforced by making the Genome, essentially, a static object.
+ * The current implementation supports only one Genome per thread. This is
+ * enforced by making the Genome, essentially, a static (thread-local) object.
  * (Using static members intead of a single static object avoids start-up and
- * shut-down issues.)
+ * shut-down issues.) Engines hold the state of genomes not bound to any
+ * thread (see engine.hpp).
  *
  * Stylus, Copyright 2006-2009 Biologic Institute
  * 
@@ -50,9 +51,70 @@ namespace org_biologicinstitute_stylus
         RT_COMBINED = RT_ATTEMPT | RT_CONSIDERATION
     };
 
+	enum ATTEMPTHISTORY
+	{
+		AH_ALL = 0,							///< Retain every attempt
+		AH_NONE,							///< Retain no attempts
+		AH_LAST,							///< Retain the most recent attempts
+		AH_SAMPLE							///< Retain a uniform sample of the attempts
+	};
+
+	/**
+	 * \brief A deferred description of an attempt or termination
+	 *
+	 * Rejected attempts and terminations are recorded far more often than their
+	 * text is read. Rather than formatting the text when recorded, the description
+	 * keeps the file/line, the format, and the arguments (numbers as numbers and
+	 * short strings copied aside) and formats them only when the text is requested.
+	 * The format must outlive the description (in practice, it is a literal).
+	 * Formats exceeding the limits below (too many arguments, long strings, '*'
+	 * widths or precisions, or unusual conversions) are formatted when recorded.
+	 */
+	class Description
+	{
+	public:
+		Description();
+
+		void record(const char* pszFileline, const char* pszFormat, va_list ap);
+		void clear();
+
+		bool isEmpty() const;
+		std::string toString() const;
+
+	private:
+		static const size_t s_cmaxARGUMENTS = 8;
+		static const size_t s_cchmaxSTRINGS = 64;
+		static const size_t s_cchmaxSPECIFICATION = 31;
+
+		union Argument
+		{
+			long long _ll;						///< Integral arguments (and characters)
+			double _n;							///< Floating point arguments
+			const void* _pv;					///< Pointer arguments
+			size_t _iString;					///< Offset of string arguments
+		};
+
+		const char* _pszFileline;				///< File and line of the recording (if any)
+		const char* _pszFormat;					///< Format of the description (NULL if none)
+		Argument _aryArguments[s_cmaxARGUMENTS];
+		size_t _cchStrings;
+		char _aryStrings[s_cchmaxSTRINGS];		///< String arguments (each terminated)
+		std::string _strText;					///< Text formatted when recorded (if the format exceeds the limits)
+
+		static const char* scanConversion(const char* pch, char& chLength);
+		static size_t copyPrefix(char* pszBuffer, size_t cbRemaining, const char* pszFileline);
+	};
+
 	/**
 	 * \brief A stack of modification records
 	 *
+	 * Mutations are held as compact records whose bases live, end-to-end, in a
+	 * single buffer owned by the stack; undoing a record switches on its type.
+	 * Clearing the stack keeps the capacity of both, so recording the mutations
+	 * of successive attempts allocates nothing once the buffers have grown.
+	 * Other modifications (e.g., stroke range changes) remain IModification
+	 * objects. Mutations are described (as text or XML) directly from their
+	 * records.
 	 */
 	class ModificationStack
 	{
@@ -62,9 +124,13 @@ namespace org_biologicinstitute_stylus
 		~ModificationStack();
 		
 		ModificationStack& operator=(const ModificationStack& ms);
+		void swap(ModificationStack& ms);
 
+		const char* recordMutation(MUTATIONTYPE mt, size_t iGeneSource, size_t iGene, size_t iSource, size_t iTarget,
+							const char* pbBases, size_t cbBases, const char* pbBasesAfter = NULL, bool fSilent = false);
 		void recordModification(IModificationSRPtr& srpModification);
-		void recordDescription(const char* pszDescription);
+		void recordDescription(const char* pszFileline, const char* pszFormat, va_list ap);
+		void recordDescription(const Description& dsDescription);
 		
 		void undo();
 
@@ -73,140 +139,246 @@ namespace org_biologicinstitute_stylus
 
 		void clear();
 
+		const Description& getDescription() const;
 		std::string toString() const;
         std::string toFullString() const;
 		void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
 		
 	private:
-		std::string _strDescription;			///< Description of stack (if any)
-		MODIFICATIONARRAY _vecModifications;	///< Stack of modifications
-	};
-	
-	/**
-	 * \brief A record of some kind of mutation
-	 * 
-	 */
-	class MutationModification : public IModification
-	{
-	public:
-		MutationModification(size_t iGene, size_t iTarget, const char* pbBases);
-		virtual ~MutationModification();
-		
-		virtual size_t length() const;
+		struct Record
+		{
+			MUTATIONTYPE _mt;					///< Mutation type (MT_ILLEGAL for other modifications)
+			bool _fSilent;						///< Change was silent
+			size_t _iGeneSource;
+			size_t _iGene;
+			size_t _iSource;
+			size_t _iTarget;
+			size_t _cbBases;
+			size_t _iBases;						///< Offset of the bases (or index of the other modification)
+			size_t _iBasesAfter;				///< Offset of the changed-to bases (changes only)
+		};
+		typedef std::vector<Record> RECORDARRAY;
+
+		Description _dsDescription;				///< Description of stack (if any)
+		RECORDARRAY _vecRecords;				///< Stack of modification records
+		std::string _strBases;					///< Bases of the records (each terminated)
+		MODIFICATIONARRAY _vecModifications;	///< Modifications other than mutations
 
-	protected:
-		size_t _iGene;
-		size_t _iTarget;
-		std::string _strBases;
+		std::string recordToString(const Record& rec) const;
+		void recordToXML(XMLStream& xs, const Record& rec, STFLAGS grfRecordDetail) const;
 	};
-	
+
 	/**
-	 * \brief A record of a base change mutation
+	 * \brief A bounded history of failed attempts (or considerations)
 	 *
+	 * The history retains the modification stacks of the attempts offered to it
+	 * as the plan directs: all of them, none (without copying them), the most
+	 * recent N (overwriting the oldest), or a uniform sample of N (reservoir
+	 * sampling). The sample draws its slots from a hash of the count of attempts
+	 * offered rather than from the genome's random numbers, so retention never
+	 * alters a lineage. Whatever the retention, entries are returned in the
+	 * order offered.
 	 */
-	class ChangeModification : public MutationModification
+	class AttemptHistory
 	{
 	public:
-		ChangeModification(size_t iGene, size_t iTarget, const char* pbBasesBefore, const char* pbBasesAfter, bool fSilent);
-		virtual ~ChangeModification();
+		AttemptHistory();
 
-		virtual void undo();
-		virtual std::string toString() const;
-		virtual void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
+		void record(const ModificationStack& ms, ATTEMPTHISTORY ah, size_t cRetain);
+		void merge(AttemptHistory& ahHistory, ATTEMPTHISTORY ah, size_t cRetain);
+		void erase(size_t iAttempt);
+		void clear();
+		void swap(AttemptHistory& ahHistory);
 
-	protected:
-		bool _fSilent;
-		std::string _strBasesAfter;
-	};
+		bool empty() const;
+		size_t size() const;
+		const ModificationStack& operator[](size_t iAttempt) const;
 
-	/**
-	 * \brief A record of a base copy mutation
-	 *
-	 */
-	class CopyModification : public MutationModification
-	{
-	public:
-		CopyModification(size_t iGene, size_t iSource, size_t iTarget, const char* pbBases);
-		virtual ~CopyModification();
+	private:
+		MODIFICATIONSTACKARRAY _vecAttempts;	///< Retained attempts (in the slots they were given)
+		NUMERICARRAY _vecSequence;				///< Order in which each retained attempt was offered
+		size_t _cOffered;						///< Attempts offered (whether retained or not)
+		size_t _iOldest;						///< Slot to overwrite next when retaining the most recent
 
-		virtual void undo();
-		virtual std::string toString() const;
-		virtual void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
+		mutable NUMERICARRAY _vecOrder;			///< Slots in the order offered (rebuilt when needed)
+		mutable bool _fOrdered;
 
-	protected:
-		size_t _iSource;
+		ModificationStack* reserve(ATTEMPTHISTORY ah, size_t cRetain);
+		void ensureOrder() const;
 	};
-
+	
 	/**
-	 * \brief A record of a base deletion mutation
-	 *
+	 * \brief A helper class to ensure the genome always ends in a valid state
+	 * 
 	 */
-	class DeleteModification : public MutationModification
+	class StateGuard
 	{
 	public:
-		DeleteModification(size_t iGene, size_t iTarget, const char* pbBases);
-		virtual ~DeleteModification();
+		StateGuard(ST_GENOMESTATE gsTarget, ST_GENOMESTATE gsError);
+		~StateGuard();
 
-		virtual void undo();
-		virtual std::string toString() const;
-		virtual void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
+	private:
+		ST_GENOMESTATE _gsTarget;
+		ST_GENOMESTATE _gsError;
 	};
-
+	
 	/**
-	 * \brief A record of a base insertion mutation
+	 * \brief A bounded cache of genome scores
+	 *
+	 * The cache maps a key identifying the content of the genes (a hash of
+	 * their bases and, when assigned, stroke ranges; see Genome::cacheKey) to
+	 * the outcome of validating and scoring them. Entries are discarded
+	 * least-recently-used first. Copies take the size of the cache but not
+	 * its entries.
 	 *
+	 * The key is not confirmed against the content, so genes whose hashes
+	 * collide share an entry; with 64-bit hashes that are also mixed with
+	 * gene lengths, this is not expected to occur in practice.
 	 */
-	class InsertModification : public MutationModification
+	class FitnessCache
 	{
 	public:
-		InsertModification(size_t iGene, size_t iTarget, const char* pbBases);
-		virtual ~InsertModification();
+		struct Entry
+		{
+			bool _fScored;							///< Genes reached scoring (so the scores were set)
+			bool _fValid;							///< Genes validated and scored
+			UNIT _nScore;
+			UNIT _nUnits;
+			UNIT _nCost;
+			UNIT _nFitness;
+			ST_GENOMETERMINATION _gaTermination;	///< Failing action (if not valid)
+			ST_GENOMEREASON _grTermination;			///< Failing action reason (if not valid)
+			Description _dsTermination;
+			Description _dsAttempt;					///< Description recorded for the failed attempt
+		};
 
-		virtual void undo();
-		virtual std::string toString() const;
-		virtual void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
-	};
+		FitnessCache();
+		FitnessCache(const FitnessCache& fc);
 
-	/**
-	 * \brief A record of a base transposition mutation
-	 *
-	 */
-	class TransposeModification : public MutationModification
-	{
-	public:
-		TransposeModification(size_t iGeneSource, size_t iGeneTarget, size_t iSource, size_t iTarget, const char* pbBases);
-		virtual ~TransposeModification();
+		FitnessCache& operator=(const FitnessCache& fc);
+		void swap(FitnessCache& fc);
+
+		bool isEnabled() const;
+		size_t getSize() const;
+		void setSize(size_t cEntries);
 
-		virtual void undo();
-		virtual std::string toString() const;
-		virtual void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
+		const Entry* find(size_t nKey);
+		void insert(size_t nKey, const Entry& entry);
+		void merge(FitnessCache& fc);
 
-	protected:
-		size_t _iGeneSource;
-		size_t _iSource;
+		void clear();
+
+		static size_t combineKey(size_t nKey, size_t nValue);
+
+	private:
+		typedef std::pair<size_t, Entry> KEYENTRY;
+		typedef std::list<KEYENTRY> ENTRYLIST;
+		typedef std::unordered_map<size_t, ENTRYLIST::iterator> ENTRYMAP;
+
+		size_t _cEntries;						///< Maximum number of entries (zero disables the cache)
+		ENTRYLIST _lstEntries;					///< Entries, most recently used first
+		ENTRYMAP _mapEntries;					///< Entries by key
+
+		void insert(ENTRYLIST& lstEntries, ENTRYLIST::iterator itEntry);
+		void evict();
 	};
 
 	/**
-	 * \brief A helper class to ensure the genome always ends in a valid state
-	 * 
+	 * \brief The bases of a genome held as a sequence of shared chunks
+	 *
+	 * Bases are split across chunks of at most s_cbMAXCHUNK bases. Locating a
+	 * base is a binary search over the chunk starts, and inserting or erasing
+	 * bases moves only the bases of the chunks touched (rather than the whole
+	 * tail of the genome). Chunks are shared between copies and copied only
+	 * when changed, so copying a sequence (e.g., into a genome context) copies
+	 * just the chunk references.
+	 *
+	 * Code needing contiguous bases (e.g., to decode codons) takes a view of a
+	 * range; views spanning chunks are assembled in a scratch buffer valid until
+	 * the next view or change. The flattened string is built on demand and kept
+	 * until the next change.
+	 *
+	 * Each chunk keeps a polynomial hash of its bases, recomputed by the
+	 * change that touches it (and so never while the chunk is shared), so
+	 * hashing a range reads the hash of each whole chunk and hashes only the
+	 * partial chunks at either end. The hash depends only on the bases, not
+	 * on how they are split across chunks.
 	 */
-	class StateGuard
+	class BaseSequence
 	{
 	public:
-		StateGuard(ST_GENOMESTATE gsTarget, ST_GENOMESTATE gsError);
-		~StateGuard();
+		BaseSequence();
+		BaseSequence(const BaseSequence& bs);
+
+		BaseSequence& operator=(const BaseSequence& bs);
+		BaseSequence& operator=(const std::string& strBases);
+		bool operator==(const BaseSequence& bs) const;
+		void swap(BaseSequence& bs);
+
+		size_t length() const;
+		bool empty() const;
+
+		char operator[](size_t iBase) const;
+		const char* view(size_t iBase, size_t cbBases) const;
+		std::string substr(size_t iBase, size_t cbBases) const;
+		void appendTo(std::string& str, size_t iBase, size_t cbBases) const;
+		int compare(size_t iBase, size_t cbBases, const std::string& strBases) const;
+		size_t hash(size_t iBase, size_t cbBases) const;
+		const std::string& str() const;
+
+		void replace(size_t iBase, const char* pbBases, size_t cbBases);
+		void insert(size_t iBase, const char* pbBases, size_t cbBases);
+		void erase(size_t iBase, size_t cbBases);
+		void clear();
 
 	private:
-		ST_GENOMESTATE _gsTarget;
-		ST_GENOMESTATE _gsError;
+		static const size_t s_cbMAXCHUNK = 1024;	///< Largest chunk (larger chunks split in halves)
+		static const size_t s_cbMINCHUNK = 128;		///< Smallest chunk kept apart from its neighbors
+		static const size_t s_nHASHBASE = 131;		///< Multiplier of the polynomial hash
+
+		struct Chunk
+		{
+			std::string _strBases;
+			size_t _nHash;							///< Hash of the bases (if _fHashed)
+			size_t _nScale;							///< s_nHASHBASE raised to the number of bases (if _fHashed)
+			bool _fHashed;
+
+			Chunk(const std::string& strBases, size_t iBase, size_t cbBases);
+			Chunk(const Chunk& chunk);
+
+			void rehash();
+		};
+
+		typedef std::shared_ptr<Chunk> CHUNK;
+		typedef std::vector<CHUNK> CHUNKARRAY;
+
+		CHUNKARRAY _vecChunks;					///< Chunks of bases, in order
+		NUMERICARRAY _vecStarts;				///< Index of the first base of each chunk
+		size_t _cbBases;						///< Total number of bases
+
+		mutable std::string _strView;			///< Bases of the last view spanning chunks
+		mutable std::string _strFlat;			///< Flattened bases (if _fFlat)
+		mutable bool _fFlat;
+
+		size_t findChunk(size_t iBase) const;
+		std::string& ownChunk(size_t iChunk);
+		void splitChunk(size_t iChunk);
+		void balanceChunk(size_t iChunk);
+		void hashChunks();
+
+		void invalidate();
 	};
-	
+
 	/**
 	 * \brief A codon table that maps a codon to the associated ACIDTYPE (vector)
 	 * 
 	 * The codon table is a map from a three character codon into the corresponding
 	 * acid-type. The map is in T, C, A, G order; that is, TTT is the first codon
 	 * and GGG is the last.
+	 *
+	 * Each base maps through a table to its two-bit index, so a codon index is
+	 * the three indexes packed into six bits and decoding a run of codons is a
+	 * pair of table lookups per base and codon.
 	 * 
 	 * When writing XML, the codon table will only generate content if what it
 	 * contains is not the default codon table and then only for entries that
@@ -221,6 +393,7 @@ namespace org_biologicinstitute_stylus
 		void reset();
 		
 		ACIDTYPE codonToType(const char* pszCodon);
+		void codonsToTypes(const char* pbBases, size_t cCodons, ACIDTYPE* pAcids);
 		
 		void toXML(XMLStream& xs, STFLAGS grfRecordDetail) const;
 
@@ -228,6 +401,7 @@ namespace org_biologicinstitute_stylus
 		static const char* s_aryCodonToName[Constants::s_nmaxCODONS];
 		static const std::string s_strUUID;
 		static const ACIDTYPE s_mapCodonToType[Constants::s_nmaxCODONS];
+		static const unsigned char s_mapBaseToIndex[UCHAR_MAX+1];
 
 		std::string _strUUID;
 		std::string _strAuthor;
@@ -238,23 +412,25 @@ namespace org_biologicinstitute_stylus
 		static size_t codonToIndex(const char* pszCodon);
 	};
 	
+	typedef std::vector<ST_STATISTICS> STATISTICSARRAY;
+
 	/**
 	 * \brief The Stylus Genome object
 	 *
-	 * The Genome is a singleton object that, after loading, holds and evaluates genes.
-	 * Its singleton nature is enforced by making all data members static.
+	 * The Genome is a per-thread singleton object that, after loading, holds and
+	 * evaluates genes. Its singleton nature is enforced by making all data members
+	 * static and thread-local.
 	 */
 	class Genome
 	{
+		friend class Engine;
+		friend class GenomeContext;
 		friend class ModificationStack;
 		
-		friend class ChangeModification;
-		friend class CopyModification;
-		friend class DeleteModification;
-		friend class InsertModification;
-		friend class TransposeModification;
 		
 		friend class Plan;
+		friend class Population;
+		friend class Speculation;
         friend class MutationSelector;
 		friend class Step;
 		
@@ -266,6 +442,8 @@ namespace org_biologicinstitute_stylus
 		static void initialize();
 		static void terminate();
 
+		static void exchangeContext(GenomeContext& gc);
+
 		/**
 		 * \brief Core Genome methods
 		 *
@@ -281,6 +459,7 @@ namespace org_biologicinstitute_stylus
 		static void setRecordRate(size_t cRecordRate, STFLAGS grfRecordDetail, const char* pszRecordDirectory, bool fRecordHistory);
 
 		static void executePlan(const char* pxmlPlan, size_t iTrial, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t cStatusRate);
+		static void evaluateMutations(const ST_MUTATION* aryMutations, size_t cMutations, ST_EVALRESULT* aryResults);
 		//@}
 
 		static void recordModification(IModification* pModification);
@@ -293,6 +472,7 @@ namespace org_biologicinstitute_stylus
 		 */
 		static void recordAttempt(const char* pszFileline, ST_TRACEREGION tr, const char* pszFormat, ...) throw();
 		static void recordTermination(const char* pszFileline, ST_GENOMETERMINATION ga, ST_GENOMEREASON gr, const char* pszFormat, ...) throw();
+		static void recordTermination(ST_GENOMETERMINATION ga, ST_GENOMEREASON gr, const Description& dsTermination);
 		static void getTermination(ST_GENOMETERMINATION* pgt, ST_GENOMEREASON* pgr, char* pszTermination, size_t* pcchTermination);
 
 		static Gene& getGeneById(size_t id);
@@ -304,14 +484,18 @@ namespace org_biologicinstitute_stylus
 		static bool isRollbackAllowed();
 		
 		static ACIDTYPE codonToType(const char* pszCodon);
+		static void codonsToTypes(const char* pbBases, size_t cCodons, ACIDTYPE* pAcids);
 		
 		static const std::string& getBases();
+		static const BaseSequence& getBaseSequence();
 		static UNIT getGeneScore(size_t iGene = 1);
 		static UNIT getGeneUnits(size_t iGene = 1);
 		static UNIT getCost();
 		static UNIT getFitness();
 		static UNIT getScore();
 		static void getStatistics(ST_STATISTICS* pStatistics);
+		static size_t getLineages();
+		static void getLineageStatistics(size_t iLineage, ST_STATISTICS* pStatistics);
 		static size_t getTrial();
 		static size_t getTrialAttempts();
 		
@@ -324,52 +508,67 @@ namespace org_biologicinstitute_stylus
         static void setRollbackType(ROLLBACKTYPE rollback_type);
         static void removeConsideration(size_t iConsideration);
 
+		static void setScoreBound(UNIT nBound, bool fFitness);
+		static void clearScoreBound();
+
         static void setMutationCallback(ST_PFNSTATUS pfnStatus);
         static const char * getMutationDescription();
+
+		static void takeSnapshot(GenomeSnapshot& gs);
+		static bool restoreSnapshot(GenomeSnapshot& gs);
   	private:
 		static const char* s_aryGENOMESTATES[STGS_MAX];
+		static const size_t s_cminWORKEREVALUATIONS = 16;	///< Fewest evaluations worth handing to a worker
 		
 		//--------------------------------------------------------------------------------
 		// General properties
 		//--------------------------------------------------------------------------------
-		static std::string _strAuthor;			///< Author name string (may be empty)
-		static CodonTable _ct;					///< Codon table for the bases
-		static std::string _strBases;			///< String of T, C, A, and G
-		static utime _tLoaded;					///< Time at when the genome was loaded
+		static thread_local std::string _strAuthor;			///< Author name string (may be empty)
+		static thread_local CodonTable _ct;					///< Codon table for the bases
+		static thread_local BaseSequence _seqBases;			///< Sequence of T, C, A, and G
+		static thread_local utime _tLoaded;					///< Time at when the genome was loaded
 
-		static std::string _strUUID;			///< Genome universally unique ID
-		static std::string _strStrain;			///< User-supplied strain identifier (unused and uninterpreted)
-		static std::string _strAncestors;		///< User-supplied ancestor identifiers (unused and uninterpreted)
+		static thread_local std::string _strUUID;			///< Genome universally unique ID
+		static thread_local std::string _strStrain;			///< User-supplied strain identifier (unused and uninterpreted)
+		static thread_local std::string _strAncestors;		///< User-supplied ancestor identifiers (unused and uninterpreted)
 
-		static bool _fReady;					///< Genome is ready for use
-        static ROLLBACKTYPE _rollbackType;      ///< Current rollback type
+		static thread_local bool _fReady;					///< Genome is ready for use
+        static thread_local ROLLBACKTYPE _rollbackType;      ///< Current rollback type
 		
-		static Plan _plan;						///< Current plan
+		static thread_local Plan _plan;						///< Current plan
+
+		static thread_local ST_STATISTICS _stats;			///< Statistics since load
+		static thread_local ST_STATISTICS _statsRecordRate;	///< Statistics since last written
+		static thread_local STATISTICSARRAY _vecLineageStatistics;	///< Statistics of each lineage from the last population
 
-		static ST_STATISTICS _stats;			///< Statistics since load
-		static ST_STATISTICS _statsRecordRate;	///< Statistics since last written
+		static thread_local size_t _cRecordRate;
+		static thread_local STFLAGS _grfRecordDetail;
+		static thread_local std::string _strRecordDirectory;
 
-		static size_t _cRecordRate;
-		static STFLAGS _grfRecordDetail;
-		static std::string _strRecordDirectory;
+		static thread_local size_t _fRecordHistory;
 
-		static size_t _fRecordHistory;
+		static thread_local bool _fGenesAssigned;			///< Flag indicating if genes were assigned or discovered
+		static thread_local GENEARRAY _vecGenes;				///< Array of genes within the genome
+		static thread_local std::bitset<s_maxGENES> _grfGenesInvalid;	///< Bit-flags indicating invalid genes
 
-		static bool _fGenesAssigned;			///< Flag indicating if genes were assigned or discovered
-		static GENEARRAY _vecGenes;				///< Array of genes within the genome
-		static std::bitset<s_maxGENES> _grfGenesInvalid;	///< Bit-flags indicating invalid genes
+		static thread_local FitnessCache _cacheFitness;		///< Scores of recently validated genomes
+		static thread_local bool _fScoresCached;			///< Genome scores were taken from the cache (genes are not yet validated)
 
-		static ModificationStack _msModifications;	///< Stack of modifications
-		static MODIFICATIONSTACKARRAY _vecAttempts;	///< Stack of failed attempts (each as a ModificationStack)
-		static MODIFICATIONSTACKARRAY _vecConsiderations;	///< Stack of considerations (each as a ModificationStack)
+		static thread_local UNIT _nScoreBound;				///< Score (or fitness) below which scoring may stop (zero disables, see setScoreBound)
+		static thread_local bool _fBoundFitness;			///< The score bound applies to fitness
+		static thread_local bool _fScoreBounded;			///< Scoring last stopped at the bound (the scores are upper bounds)
 
-		static ST_GENOMESTATE _gsCurrent;			///< Current genome state
+		static thread_local ModificationStack _msModifications;	///< Stack of modifications
+		static thread_local AttemptHistory _ahAttempts;			///< History of failed attempts (each as a ModificationStack)
+		static thread_local AttemptHistory _ahConsiderations;	///< History of considerations (each as a ModificationStack)
+
+		static thread_local ST_GENOMESTATE _gsCurrent;			///< Current genome state
 		
-		static ST_GENOMETERMINATION _gaTermination;	///< Last failed action
-		static ST_GENOMEREASON _grTermination;		///< Reason code associated with last failed action
-		static std::string _strTermination;			///< Human-readable string describing the action
-        static ST_PFNSTATUS _mutationCallback;
-        static std::string _mutationFullString;
+		static thread_local ST_GENOMETERMINATION _gaTermination;	///< Last failed action
+		static thread_local ST_GENOMEREASON _grTermination;		///< Reason code associated with last failed action
+		static thread_local Description _dsTermination;			///< Human-readable description of the action
+        static thread_local ST_PFNSTATUS _mutationCallback;
+        static thread_local std::string _mutationFullString;
 
 		//--------------------------------------------------------------------------------
 		// Internal Methods
@@ -392,6 +591,10 @@ namespace org_biologicinstitute_stylus
 		static bool doScoring();
 		static bool doSpawn();
 		static bool doValidation();
+
+		static size_t cacheKey();
+		static bool validateCached(const FitnessCache::Entry& entry);
+		static void completeCached();
 		
 		enum RECORDTYPE
 		{
@@ -401,6 +604,7 @@ namespace org_biologicinstitute_stylus
 		};
 		static void record(RECORDTYPE rt);
 		static void recordHistory(RECORDTYPE rt);
+		static void recordPlan(RECORDTYPE rt);
 		static bool validate(bool fPreserveErrors = false);
         static bool rollback();
         static bool recordStatistics(bool fPreserveErrors = false);
@@ -420,30 +624,63 @@ namespace org_biologicinstitute_stylus
 		static void undoStatistics(ST_STATISTICS & stats, MUTATIONTYPE mt, size_t cbBases, bool fSilent);
         static void undoAttempts(ST_ATTEMPTS & attempts, size_t cbBases);
 
+		static void evaluateMutation(Mutation& mt, ST_EVALRESULT& er);
+
 		static bool handleChange(const Mutation& mt, bool fPreserveGenes, bool fRejectSilent);
 		static bool handleCopy(const Mutation& mt, bool fPreserveGenes);
 		static bool handleDelete(const Mutation& mt, bool fPreserveGenes);
 		static bool handleInsert(const Mutation& mt, bool fPreserveGenes);
 		static bool handleTranspose(const Mutation& mt, bool fPreserveGenes);
 
-		static void changeBases(size_t iGene, size_t iTarget, const std::string& strBases, bool fSilent);
+		static void changeBases(size_t iGene, size_t iTarget, const char* pbBases, size_t cbBases, bool fSilent);
 		static void deleteBases(size_t iGene, size_t iTarget, size_t cbBases);
-		static void insertBases(size_t iGene, size_t iTarget, const std::string& strBases);
+		static void insertBases(size_t iGene, size_t iTarget, const char* pbBases, size_t cbBases);
 
 		static void purgeModifications(bool fPreserveAttempts = false);
 
+		static void copyContext(GenomeContext& gc);
+		static void cloneContext(GenomeContext& gc);
+		static void adoptContext(const GenomeContext& gc, size_t iLineage);
+		static void adoptContext(GenomeContext& gc, const ST_STATISTICS& stats, const ST_STATISTICS& statsRecordRate);
+		static void mergeContext(GenomeContext& gc, const ST_STATISTICS& stats, const ST_STATISTICS& statsRecordRate);
+		static void mergeStatistics(ST_STATISTICS& stats, const ST_STATISTICS& statsBefore, const ST_STATISTICS& statsAfter);
+		static void mergeAttempts(ST_ATTEMPTS& attempts, const ST_ATTEMPTS& attemptsBefore, const ST_ATTEMPTS& attemptsAfter);
+
 		static size_t rgenIndex(const Range& rgBases, bool fInFrame = false);
 		static size_t rgenLength(size_t cbLength, bool fWholeCodons = false);
 		static std::string& rgenTransversion(size_t iTarget, std::string& strBases, UNIT nTransversionLikelihood);
 		static std::string& rgenBases(std::string& strBases, size_t cbLength);
 
 #ifdef ST_DEBUG
-		static Unit _nFitnessPassing;
-		static bool _fTestingRollback;
+		static thread_local Unit _nFitnessPassing;
+		static thread_local bool _fTestingRollback;
 		static bool testRollback();
 #endif
 	};
 
+	/**
+	 * \brief The validated and scored genes of a mutated genome
+	 *
+	 * A snapshot preserves the result of validating mutations across their
+	 * rollback. Re-applying the same mutations and then restoring the snapshot
+	 * returns the genome to the state validation produced without repeating it.
+	 */
+	class GenomeSnapshot
+	{
+		friend class Genome;
+
+	private:
+		GENEARRAY _vecGenes;
+		std::bitset<Genome::s_maxGENES> _grfGenesInvalid;
+		bool _fScoresCached;
+		ModificationStack _msModifications;		///< Modifications made by the mutations and validation
+
+		UNIT _nScore;
+		UNIT _nUnits;
+		UNIT _nCost;
+		UNIT _nFitness;
+	};
+
 #define THROWIFEXECUTING(x)		{ if (_plan.isExecuting()) THROWRC((RC(INVALIDSTATE), "Illegal nested call to " ST_STRINGIFY(x))); }
 
 #define REQUIREALIVE(x)			{ if (!isState(STGS_ALIVE)) THROWRC((RC(INVALIDSTATE), "Illegal call to " ST_STRINGIFY(x) " while in state %s", stateToString())); }
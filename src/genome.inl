@@ -20,6 +20,17 @@
 using namespace std;
 using namespace stylus;
 
+//--------------------------------------------------------------------------------
+//
+// Description
+//
+//--------------------------------------------------------------------------------
+inline Description::Description() : _pszFileline(NULL), _pszFormat(NULL), _cchStrings(0) {}
+
+inline void Description::clear() { _pszFileline = NULL; _pszFormat = NULL; _cchStrings = 0; _strText.clear(); }
+
+inline bool Description::isEmpty() const { return !VALID(_pszFormat) && _strText.empty(); }
+
 //--------------------------------------------------------------------------------
 //
 // ModificationStack
@@ -31,45 +42,111 @@ inline ModificationStack::~ModificationStack() { clear(); }
 
 inline ModificationStack& ModificationStack::operator=(const ModificationStack& cs)
 {
-	_strDescription = cs._strDescription;
+	_dsDescription = cs._dsDescription;
+	_vecRecords = cs._vecRecords;
+	_strBases = cs._strBases;
 	_vecModifications = cs._vecModifications;
 	return *this;
 }
 
+inline void ModificationStack::swap(ModificationStack& ms)
+{
+	std::swap(_dsDescription, ms._dsDescription);
+	_vecRecords.swap(ms._vecRecords);
+	_strBases.swap(ms._strBases);
+	_vecModifications.swap(ms._vecModifications);
+}
+
+inline const char* ModificationStack::recordMutation(MUTATIONTYPE mt, size_t iGeneSource, size_t iGene, size_t iSource, size_t iTarget,
+											  const char* pbBases, size_t cbBases, const char* pbBasesAfter, bool fSilent)
+{
+	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
+	ASSERT(mt != MT_ILLEGAL);
+	ASSERT(VALID(pbBases));
+	ASSERT(mt != MT_CHANGE || VALID(pbBasesAfter));
+
+	Record rec = { mt, fSilent, iGeneSource, iGene, iSource, iTarget, cbBases, _strBases.length(), 0 };
+	_strBases.append(pbBases, cbBases).push_back('\0');
+	if (mt == MT_CHANGE)
+	{
+		rec._iBasesAfter = _strBases.length();
+		_strBases.append(pbBasesAfter, cbBases).push_back('\0');
+	}
+	_vecRecords.push_back(rec);
+	return _strBases.c_str() + rec._iBases;
+}
+
 inline void ModificationStack::recordModification(IModificationSRPtr& srpModification)
 {
 	ASSERT(VALIDSP(srpModification));
+	Record rec = { MT_ILLEGAL, false, 0, 0, 0, 0, 0, _vecModifications.size(), 0 };
+	_vecRecords.push_back(rec);
 	_vecModifications.push_back(srpModification);
 }
-inline void ModificationStack::recordDescription(const char* pszDescription)
+inline void ModificationStack::recordDescription(const char* pszFileline, const char* pszFormat, va_list ap)
 {
-	ASSERT(VALID(pszDescription));
-	_strDescription = pszDescription;
+	ASSERT(VALID(pszFormat));
+	_dsDescription.record(pszFileline, pszFormat, ap);
 }
+inline void ModificationStack::recordDescription(const Description& dsDescription) { _dsDescription = dsDescription; }
 
-inline bool ModificationStack::isEmpty() const { return (_vecModifications.size() <= 0); }
-inline size_t ModificationStack::length() const { return _vecModifications.size(); }
+inline bool ModificationStack::isEmpty() const { return (_vecRecords.size() <= 0); }
+inline size_t ModificationStack::length() const { return _vecRecords.size(); }
 
-inline void ModificationStack::clear() { _strDescription.clear(); _vecModifications.clear(); }
+inline void ModificationStack::clear()
+{
+	_dsDescription.clear();
+	_vecRecords.clear();
+	_strBases.clear();
+	_vecModifications.clear();
+}
 
-inline std::string ModificationStack::toString() const { return std::string(_strDescription); }
+inline const Description& ModificationStack::getDescription() const { return _dsDescription; }
+inline std::string ModificationStack::toString() const { return _dsDescription.toString(); }
 
 //--------------------------------------------------------------------------------
 //
-// MutationModification
-// ChangeModification, CopyModification, DeleteModification, InsertModification, TransposeModification
+// AttemptHistory
 //
 //--------------------------------------------------------------------------------
-inline MutationModification::MutationModification(size_t iGene, size_t iTarget, const char* pbBases) :
-	_iGene(iGene), _iTarget(iTarget), _strBases(pbBases) {}
-inline MutationModification::~MutationModification() {}
-inline size_t MutationModification::length() const { return _strBases.length(); }
+inline AttemptHistory::AttemptHistory() : _cOffered(0), _iOldest(0), _fOrdered(true) {}
 
-inline ChangeModification::~ChangeModification() {}
-inline CopyModification::~CopyModification() {}
-inline DeleteModification::~DeleteModification() {}
-inline InsertModification::~InsertModification() {}
-inline TransposeModification::~TransposeModification() {}
+inline void AttemptHistory::record(const ModificationStack& ms, ATTEMPTHISTORY ah, size_t cRetain)
+{
+	ModificationStack* pms = reserve(ah, cRetain);
+	if (VALID(pms))
+		*pms = ms;
+}
+
+inline void AttemptHistory::clear()
+{
+	_vecAttempts.clear();
+	_vecSequence.clear();
+	_cOffered = 0;
+	_iOldest = 0;
+	_vecOrder.clear();
+	_fOrdered = true;
+}
+
+inline void AttemptHistory::swap(AttemptHistory& ahHistory)
+{
+	_vecAttempts.swap(ahHistory._vecAttempts);
+	_vecSequence.swap(ahHistory._vecSequence);
+	std::swap(_cOffered, ahHistory._cOffered);
+	std::swap(_iOldest, ahHistory._iOldest);
+	_vecOrder.swap(ahHistory._vecOrder);
+	std::swap(_fOrdered, ahHistory._fOrdered);
+}
+
+inline bool AttemptHistory::empty() const { return _vecAttempts.empty(); }
+inline size_t AttemptHistory::size() const { return _vecAttempts.size(); }
+
+inline const ModificationStack& AttemptHistory::operator[](size_t iAttempt) const
+{
+	ASSERT(iAttempt < _vecAttempts.size());
+	ensureOrder();
+	return _vecAttempts[_vecOrder[iAttempt]];
+}
 
 //--------------------------------------------------------------------------------
 //
@@ -84,6 +161,118 @@ inline StateGuard::~StateGuard()
 		Genome::enterState(_gsError);
 }
 
+//--------------------------------------------------------------------------------
+//
+// FitnessCache
+//
+//--------------------------------------------------------------------------------
+inline FitnessCache::FitnessCache() : _cEntries(0) {}
+inline FitnessCache::FitnessCache(const FitnessCache& fc) : _cEntries(0) { operator=(fc); }
+
+inline FitnessCache& FitnessCache::operator=(const FitnessCache& fc)
+{
+	clear();
+	_cEntries = fc._cEntries;
+	return *this;
+}
+
+inline void FitnessCache::swap(FitnessCache& fc)
+{
+	std::swap(_cEntries, fc._cEntries);
+	_lstEntries.swap(fc._lstEntries);
+	_mapEntries.swap(fc._mapEntries);
+}
+
+inline bool FitnessCache::isEnabled() const { return (_cEntries > 0); }
+inline size_t FitnessCache::getSize() const { return _cEntries; }
+inline void FitnessCache::setSize(size_t cEntries) { _cEntries = cEntries; evict(); }
+
+inline void FitnessCache::clear() { _lstEntries.clear(); _mapEntries.clear(); }
+
+inline size_t FitnessCache::combineKey(size_t nKey, size_t nValue)
+{
+	return nKey ^ (nValue + 0x9e3779b97f4a7c15ULL + (nKey << 6) + (nKey >> 2));
+}
+
+//--------------------------------------------------------------------------------
+//
+// BaseSequence
+//
+//--------------------------------------------------------------------------------
+inline BaseSequence::Chunk::Chunk(const std::string& strBases, size_t iBase, size_t cbBases) :
+	_strBases(strBases, iBase, cbBases), _nHash(0), _nScale(1), _fHashed(false) {}
+inline BaseSequence::Chunk::Chunk(const Chunk& chunk) :
+	_strBases(chunk._strBases), _nHash(0), _nScale(1), _fHashed(false) {}
+
+inline BaseSequence::BaseSequence() : _cbBases(0), _fFlat(false) {}
+inline BaseSequence::BaseSequence(const BaseSequence& bs) :
+	_vecChunks(bs._vecChunks), _vecStarts(bs._vecStarts), _cbBases(bs._cbBases), _fFlat(false) {}
+
+inline BaseSequence& BaseSequence::operator=(const BaseSequence& bs)
+{
+	_vecChunks = bs._vecChunks;
+	_vecStarts = bs._vecStarts;
+	_cbBases = bs._cbBases;
+	invalidate();
+	return *this;
+}
+
+inline bool BaseSequence::operator==(const BaseSequence& bs) const
+{
+	return (_cbBases == bs._cbBases && compare(0, _cbBases, bs.str()) == 0);
+}
+
+inline void BaseSequence::swap(BaseSequence& bs)
+{
+	_vecChunks.swap(bs._vecChunks);
+	_vecStarts.swap(bs._vecStarts);
+	std::swap(_cbBases, bs._cbBases);
+	_strView.swap(bs._strView);
+	_strFlat.swap(bs._strFlat);
+	std::swap(_fFlat, bs._fFlat);
+}
+
+inline size_t BaseSequence::length() const { return _cbBases; }
+inline bool BaseSequence::empty() const { return (_cbBases == 0); }
+
+inline char BaseSequence::operator[](size_t iBase) const
+{
+	size_t iChunk = findChunk(iBase);
+	return _vecChunks[iChunk]->_strBases[iBase - _vecStarts[iChunk]];
+}
+
+inline std::string BaseSequence::substr(size_t iBase, size_t cbBases) const
+{
+	ASSERT(iBase <= _cbBases);
+	std::string str;
+	appendTo(str, iBase, std::min(cbBases, _cbBases - iBase));
+	return str;
+}
+
+inline void BaseSequence::clear()
+{
+	_vecChunks.clear();
+	_vecStarts.clear();
+	_cbBases = 0;
+	invalidate();
+}
+
+inline size_t BaseSequence::findChunk(size_t iBase) const
+{
+	ASSERT(iBase < _cbBases);
+	return (std::upper_bound(_vecStarts.begin(), _vecStarts.end(), iBase) - _vecStarts.begin()) - 1;
+}
+
+inline std::string& BaseSequence::ownChunk(size_t iChunk)
+{
+	if (_vecChunks[iChunk].use_count() > 1)
+		_vecChunks[iChunk] = std::make_shared<Chunk>(*_vecChunks[iChunk]);
+	_vecChunks[iChunk]->_fHashed = false;
+	return _vecChunks[iChunk]->_strBases;
+}
+
+inline void BaseSequence::invalidate() { _fFlat = false; }
+
 //--------------------------------------------------------------------------------
 //
 // CodonTable
@@ -99,24 +288,18 @@ inline void CodonTable::reset()
 
 inline ACIDTYPE CodonTable::codonToType(const char* pszCodon) { return _mapCodonToType[codonToIndex(pszCodon)]; }
 
+inline void CodonTable::codonsToTypes(const char* pbBases, size_t cCodons, ACIDTYPE* pAcids)
+{
+	for (ACIDTYPE* pAcidsEnd = pAcids + cCodons; pAcids < pAcidsEnd; pbBases += Codon::s_cchCODON, ++pAcids)
+		*pAcids = _mapCodonToType[codonToIndex(pbBases)];
+}
+
 inline size_t CodonTable::codonToIndex(const char* pszCodon)
 {
 	ASSERT(Codon::s_cchCODON <= ::strlen(pszCodon));
-	size_t iCodon = 0;
 
-	for (size_t i=0; i < Codon::s_cchCODON; i += 1, pszCodon += 1)
-	{
-		iCodon *= 4;
-		iCodon += (*pszCodon == Constants::s_chBASET
-				   ? 0
-				   : (*pszCodon == Constants::s_chBASEC
-					  ? 1
-					  : (*pszCodon == Constants::s_chBASEA
-						 ? 2
-						 : 3)));
-	}
-	
-	return iCodon;
+	const unsigned char* pbCodon = reinterpret_cast<const unsigned char*>(pszCodon);
+	return ((s_mapBaseToIndex[pbCodon[0]] << 4) | (s_mapBaseToIndex[pbCodon[1]] << 2) | s_mapBaseToIndex[pbCodon[2]]);
 }
 
 //--------------------------------------------------------------------------------
@@ -140,14 +323,18 @@ inline const char* Genome::stateToString(ST_GENOMESTATE gs) { return s_aryGENOME
 inline bool Genome::isRollbackAllowed() { return _fReady; }
 
 inline ACIDTYPE Genome::codonToType(const char* pszCodon) { return _ct.codonToType(pszCodon); }
+inline void Genome::codonsToTypes(const char* pbBases, size_t cCodons, ACIDTYPE* pAcids) { _ct.codonsToTypes(pbBases, cCodons, pAcids); }
 
-inline const std::string& Genome::getBases() { return _strBases; }
+inline const std::string& Genome::getBases() { return _seqBases.str(); }
+inline const BaseSequence& Genome::getBaseSequence() { return _seqBases; }
 inline UNIT Genome::getGeneScore(size_t iGene) { return _stats._nScore; }
 inline UNIT Genome::getGeneUnits(size_t iGene) { return _stats._nUnits; }
 inline UNIT Genome::getCost() { return _stats._nCost; }
 inline UNIT Genome::getFitness() { return _stats._nFitness; }
 inline UNIT Genome::getScore() { return _stats._nScore; }
 inline void Genome::getStatistics(ST_STATISTICS* pStatistics) { ASSERT(VALID(pStatistics)); ::memcpy(pStatistics, &_stats, sizeof(ST_STATISTICS)); }
+inline size_t Genome::getLineages() { return _vecLineageStatistics.size(); }
+inline void Genome::getLineageStatistics(size_t iLineage, ST_STATISTICS* pStatistics) { ASSERT(VALID(pStatistics)); ASSERT(iLineage < _vecLineageStatistics.size()); ::memcpy(pStatistics, &_vecLineageStatistics[iLineage], sizeof(ST_STATISTICS)); }
 inline size_t Genome::getTrial() { return _stats._iTrialCurrent; }
 inline size_t Genome::getTrialAttempts() { return _stats._cTrialAttempts; }
 
@@ -155,6 +342,8 @@ inline const Plan& Genome::getPlan() { return _plan; }
 		
 inline bool Genome::isLoaded() { return (_tLoaded != 0); }
 inline void Genome::setRollbackType(ROLLBACKTYPE rt) { _rollbackType = rt; }
+inline void Genome::setScoreBound(UNIT nBound, bool fFitness) { _nScoreBound = nBound; _fBoundFitness = fFitness; }
+inline void Genome::clearScoreBound() { _nScoreBound = 0; _fBoundFitness = false; }
 
 inline bool Genome::isRecording() { return (_grfRecordDetail != STRD_NONE && _strRecordDirectory.length() > 0); }
 inline bool Genome::isRecordingTrial() { return (_fReady && _cRecordRate && (getTrial() % _cRecordRate) == 0); }
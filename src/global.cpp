@@ -44,7 +44,8 @@ static const char s_szTIMEFORMAT[] = "%Y-%m-%dT%H:%M:%S.";
 static const char s_achNUMBERS[] = "0123456789";
 static const long long s_nUSECPERSEC = 1000000;
 
-static char s_achBuffer[Constants::s_cbmaxBUFFER];
+static thread_local char s_achBuffer[Constants::s_cbmaxBUFFER];
+static mutex s_mutexLog;
 
 extern "C"
 {
@@ -149,6 +150,7 @@ extern "C"
 		LOGINFO((LLINFO, "Stylus terminating - %s", Globals::s_szVersion));
 		Globals::setInitialized(false);
 
+		WorkerPool::stop();
 		Genome::terminate();
 		RGenerator::terminate();
 		XMLDocument::terminate();
@@ -671,6 +673,44 @@ extern "C"
 		EXITPUBLIC(GLOBAL,stGetStatistics);
 	}
 
+	/*
+	 * Function: stGetLineages
+	 *
+	 */
+	ST_RETCODE stGetLineages(size_t* pcLineages)
+	{
+		ENTERPUBLIC(GLOBAL,stGetLineages);
+		RETURN_NOTINITIALIZED();
+
+		if (!VALID(pcLineages))
+			RETURN_BADARGS();
+
+		*pcLineages = Genome::getLineages();
+
+		RETURN_SUCCESS();
+		
+		EXITPUBLIC(GLOBAL,stGetLineages);
+	}
+
+	/*
+	 * Function: stGetLineageStatistics
+	 *
+	 */
+	ST_RETCODE stGetLineageStatistics(size_t iLineage, ST_STATISTICS* pStatistics)
+	{
+		ENTERPUBLIC(GLOBAL,stGetLineageStatistics);
+		RETURN_NOTINITIALIZED();
+
+		if (!VALID(pStatistics) || iLineage >= Genome::getLineages())
+			RETURN_BADARGS();
+
+		Genome::getLineageStatistics(iLineage, pStatistics);
+
+		RETURN_SUCCESS();
+		
+		EXITPUBLIC(GLOBAL,stGetLineageStatistics);
+	}
+
 	/*
 	 * Function: stGetGenomeState
 	 *
@@ -709,6 +749,26 @@ extern "C"
 		EXITPUBLIC(GLOBAL,stGetGenomeTermination);
 	}
 
+	/*
+	 * Function: stEvaluateMutations
+	 *
+	 */
+	ST_RETCODE
+	stEvaluateMutations(const ST_MUTATION* aryMutations, size_t cMutations, ST_EVALRESULT* aryResults)
+	{
+		ENTERPUBLIC(GLOBAL,stEvaluateMutations);
+		RETURN_NOTINITIALIZED();
+
+		if (cMutations > 0 && (!VALID(aryMutations) || !VALID(aryResults)))
+			RETURN_BADARGS();
+
+		if (cMutations > 0)
+			Genome::evaluateMutations(aryMutations, cMutations, aryResults);
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stEvaluateMutations);
+	}
+
     ST_RETCODE stSetSeed(const char * seed)
     {
 		ENTERPUBLIC(GLOBAL,stSetSeed);
@@ -719,6 +779,121 @@ extern "C"
         RETURN_SUCCESS();
 		EXITPUBLIC(GLOBAL,stSetSeed);
     }
+
+	/*
+	 * Function: stSetThreads
+	 *
+	 */
+	ST_RETCODE
+	stSetThreads(size_t cThreads)
+	{
+		ENTERPUBLIC(GLOBAL,stSetThreads);
+		RETURN_NOTINITIALIZED();
+
+		Globals::setThreads(cThreads);
+		WorkerPool::start(Globals::getThreadCount());
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stSetThreads);
+	}
+
+	/*
+	 * Function: stGetThreads
+	 *
+	 */
+	ST_RETCODE
+	stGetThreads(size_t* pcThreads)
+	{
+		ENTERPUBLIC(GLOBAL,stGetThreads);
+		RETURN_NOTINITIALIZED();
+
+		if (!VALID(pcThreads))
+			RETURN_BADARGS();
+
+		*pcThreads = Globals::getThreads();
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stGetThreads);
+	}
+
+	/*
+	 * Function: stCreateEngine
+	 *
+	 */
+	ST_RETCODE
+	stCreateEngine(ST_HENGINE* phEngine)
+	{
+		ENTERPUBLIC(GLOBAL,stCreateEngine);
+		RETURN_NOTINITIALIZED();
+
+		if (!VALID(phEngine))
+			RETURN_BADARGS();
+
+		*phEngine = reinterpret_cast<ST_HENGINE>(::new Engine());
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stCreateEngine);
+	}
+
+	/*
+	 * Function: stDestroyEngine
+	 *
+	 */
+	ST_RETCODE
+	stDestroyEngine(ST_HENGINE hEngine)
+	{
+		ENTERPUBLIC(GLOBAL,stDestroyEngine);
+		RETURN_NOTINITIALIZED();
+
+		Engine* pEngine = reinterpret_cast<Engine*>(hEngine);
+		if (!VALID(pEngine))
+			RETURN_BADARGS();
+
+		if (pEngine == Engine::getBound())
+			Engine::bind(NULL);
+		else if (pEngine->isBound())
+			RETURN_RC(INVALIDSTATE);
+
+		::delete pEngine;
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stDestroyEngine);
+	}
+
+	/*
+	 * Function: stSetEngine
+	 *
+	 */
+	ST_RETCODE
+	stSetEngine(ST_HENGINE hEngine)
+	{
+		ENTERPUBLIC(GLOBAL,stSetEngine);
+		RETURN_NOTINITIALIZED();
+
+		Engine::bind(reinterpret_cast<Engine*>(hEngine));
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stSetEngine);
+	}
+
+	/*
+	 * Function: stGetEngine
+	 *
+	 */
+	ST_RETCODE
+	stGetEngine(ST_HENGINE* phEngine)
+	{
+		ENTERPUBLIC(GLOBAL,stGetEngine);
+		RETURN_NOTINITIALIZED();
+
+		if (!VALID(phEngine))
+			RETURN_BADARGS();
+
+		*phEngine = reinterpret_cast<ST_HENGINE>(Engine::getBound());
+		RETURN_SUCCESS();
+
+		EXITPUBLIC(GLOBAL,stGetEngine);
+	}
 }
 
 /*
@@ -940,7 +1115,14 @@ static const char* s_aryGROUPSCOREMODE[GSM_MAX] =
 	"minimum"
 };
 
+static const char* s_arySTROKEORIENTATIONMODE[SOM_MAX] =
+{
+	"endpoints",
+	"deviation"
+};
+
 bool Globals::_fInitialized = false;
+thread_local bool Globals::_fThreadInitialized = false;
 bool Globals::_fSupplied = false;
 		
 ST_LOGLEVEL Globals::_ll = STLL_INFO;
@@ -950,14 +1132,17 @@ std::ofstream Globals::_logFile;
 
 STFLAGS Globals::_grfTR = 0;
 ST_TRACELEVEL Globals::_tl[STTC_MAX] = { STTL_NONE, STTL_NONE };
-size_t Globals::_cTraceindents = 0;
+thread_local size_t Globals::_cTraceindents = 0;
 size_t Globals::_iTrialTrace = numeric_limits<size_t>::max();
 size_t Globals::_iAttemptTrace = numeric_limits<size_t>::max();
-bool Globals::_fAtTraceTrialOrAttempt = false;
+thread_local bool Globals::_fAtTraceTrialOrAttempt = false;
 
 STFLAGS Globals::_grfTF = 0;
 
+size_t Globals::_cThreads = 1;
+
 GROUPSCOREMODE Globals::_gsm = GSM_MINIMUM;
+STROKEORIENTATIONMODE Globals::_som = SOM_DEVIATION;
 
 Unit Globals::_aryGenomeWeights[SC_GENOMEMAX] =
 	{
@@ -984,6 +1169,25 @@ Unit Globals::_aryGroupSetpoints[SC_GROUPMAX] =
 		Unit(0.0), Unit(0.0), Unit(0.0), Unit(0.0), Unit(0.0), Unit(0.0), Unit(0.0)
 	};
 	
+/*
+ * Function: initializeThread
+ *
+ */
+void
+Globals::initializeThread()
+{
+	ENTER(GLOBAL,initializeThread);
+
+	if (_fThreadInitialized)
+		return;
+
+	XMLDocument::initializeThread();
+	RGenerator::initializeThread();
+	Genome::initialize();
+
+	_fThreadInitialized = true;
+}
+
 /*
  * Function: load
  * 
@@ -1017,6 +1221,14 @@ Globals::load(const char* pxmlGlobals)
 				_gsm = static_cast<GROUPSCOREMODE>(iGSM);
 		}
 	}
+	if (spxd->getAttribute(pxn, xmlTag(XT_STROKEORIENTATION), str))
+	{
+		for (size_t iSOM=SOM_ENDPOINTS; iSOM < SOM_MAX; iSOM += 1)
+		{
+			if (str == s_arySTROKEORIENTATIONMODE[iSOM])
+				_som = static_cast<STROKEORIENTATIONMODE>(iSOM);
+		}
+	}
 	
 	// Find and load weights
 	spxpo = spxd->evalXPath(spxpc.get(), xmlXPath(XP_WEIGHTGENOME));
@@ -1245,6 +1457,8 @@ Globals::log(ST_LOGLEVEL ll, const char* pszFileline, const char* pszFormat, ...
 	::vsnprintf(pszMsg, cbRemaining, pszFormat, ap);
 
 EXIT:
+	lock_guard<mutex> lock(s_mutexLog);
+
 	if (_grfLogOptions & STLO_USESTDOUT)
 		cout << s_achBuffer << endl;
 
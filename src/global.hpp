@@ -178,7 +178,7 @@
 #define RETURN_ERROR()			{ RETURN_RC(ERROR); }
 #define RETURN_BADARGS()		{ RETURN_RC(BADARGUMENTS); }
 #define RETURN_IFERROR(x)		{ rc = (x); if (ST_ISERROR(rc)) goto EXIT; }
-#define	RETURN_NOTINITIALIZED()	{ if (!Globals::isInitialized()) RETURN_RC(NOTINITIALIZED); }
+#define	RETURN_NOTINITIALIZED()	{ if (!Globals::isInitialized()) RETURN_RC(NOTINITIALIZED); Globals::initializeThread(); }
 #define RETURN_IFDEAD()			{ if (Genome::isState(STGS_DEAD)) RETURN_RC(INVALIDSTATE); }
 
 namespace org_biologicinstitute_stylus
@@ -284,6 +284,18 @@ namespace org_biologicinstitute_stylus
 		GSM_MAX
 	};
 	
+	/**
+	 * \brief Different ways of choosing the Han stroke orientation (forward or reverse) to score against
+	 * 
+	 */
+	enum STROKEORIENTATIONMODE
+	{
+		SOM_ENDPOINTS = 0,			///< Take the orientation closest at the stroke end points
+		SOM_DEVIATION,				///< Take the orientation with the smaller maximum deviation (default)
+		
+		SOM_MAX
+	};
+	
 	/**
 	 * \brief All global variables
 	 *
@@ -299,6 +311,11 @@ namespace org_biologicinstitute_stylus
 		static bool isInitialized();
 		static void setInitialized(bool fInitialized);
 
+		/// Establish, on its first call into Stylus, the default state (Genome,
+		/// random generator, and libxml2 settings) of the calling thread; the
+		/// thread calling stInitialize receives its state there
+		static void initializeThread();
+
 		static void load(const char* pxmlGlobals);
 		static void toXML(XMLStream& xs);
 		static bool isSupplied();
@@ -360,8 +377,20 @@ namespace org_biologicinstitute_stylus
 		/// Decrease trace indentation
 		static void traceOut() throw();
 		///@}
+
+		/**
+		 * \brief Worker thread methods
+		 * \remarks
+		 * - A thread count of zero uses one thread per hardware core
+		 */
+		//{@
+		static void setThreads(size_t cThreads);
+		static size_t getThreads();
+		static size_t getThreadCount();
+		//@}
 		
 		static bool isGroupScoreMode(GROUPSCOREMODE gsm);
+		static bool isStrokeOrientationMode(STROKEORIENTATIONMODE som);
 		
 		static UNIT getGenomeWeight(SCORECOMPONENT sc);
 
@@ -373,6 +402,7 @@ namespace org_biologicinstitute_stylus
 
 	private:
 		static bool _fInitialized;
+		static thread_local bool _fThreadInitialized;	///< Calling thread has its default state
 		static bool _fSupplied;
 	
         static std::ofstream _logFile;
@@ -382,14 +412,17 @@ namespace org_biologicinstitute_stylus
 
 		static STFLAGS _grfTR;
 		static ST_TRACELEVEL _tl[STTC_MAX];
-		static size_t _cTraceindents;
+		static thread_local size_t _cTraceindents;
 		static size_t _iTrialTrace;				///< Trial at which to begin tracing
 		static size_t _iAttemptTrace;			///< Trial attempt at which to begin tracing
-		static bool _fAtTraceTrialOrAttempt;
+		static thread_local bool _fAtTraceTrialOrAttempt;
 
 		static STFLAGS _grfTF;
 
+		static size_t _cThreads;
+
 		static GROUPSCOREMODE _gsm;
+		static STROKEORIENTATIONMODE _som;
 		
 		static Unit _aryGenomeWeights[SC_GENOMEMAX];
 		
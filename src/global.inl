@@ -34,7 +34,7 @@ inline string& stylus::terminatePath(std::string& strPath)
 //
 //--------------------------------------------------------------------------------
 inline bool Globals::isInitialized() { return _fInitialized; }
-inline void Globals::setInitialized(bool fInitialized) { _fInitialized = fInitialized; }
+inline void Globals::setInitialized(bool fInitialized) { _fInitialized = _fThreadInitialized = fInitialized; }
 
 inline bool Globals::isSupplied() { return _fSupplied; }
 
@@ -50,6 +50,10 @@ inline STFLAGS Globals::getLogOptions() { return _grfLogOptions; }
 inline void Globals::setLogRate(size_t cLogRate) { _cLogRate = cLogRate; }
 inline size_t Globals::getLogRate() { return _cLogRate; }
 
+inline void Globals::setThreads(size_t cThreads) { _cThreads = cThreads; }
+inline size_t Globals::getThreads() { return _cThreads; }
+inline size_t Globals::getThreadCount() { return (_cThreads > 0 ? _cThreads : max<size_t>(std::thread::hardware_concurrency(), 1)); }
+
 inline void Globals::setTraceRegions(STFLAGS grfTR) { _grfTR = grfTR; }
 inline STFLAGS Globals::getTraceRegions() { return _grfTR; }
 
@@ -76,6 +80,7 @@ inline void Globals::traceIn() throw() { _cTraceindents++; }
 inline void Globals::traceOut() throw() { if (_cTraceindents > 0) _cTraceindents--; }
 
 inline bool Globals::isGroupScoreMode(GROUPSCOREMODE gsm) { ASSERT(gsm < GSM_MAX); return (_gsm == gsm); }
+inline bool Globals::isStrokeOrientationMode(STROKEORIENTATIONMODE som) { ASSERT(som < SOM_MAX); return (_som == som); }
 
 inline UNIT Globals::getGenomeWeight(SCORECOMPONENT sc) { ASSERT(sc < SC_GENOMEMAX); return _aryGenomeWeights[sc]; }
 
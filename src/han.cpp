@@ -69,6 +69,46 @@ HDimensions::load(XMLDocument* pxd, xmlNodePtr pxn)
 	_rectBounds.load(pxd, pxnBounds);
 }
 
+//--------------------------------------------------------------------------------
+//
+// HPath
+//
+//--------------------------------------------------------------------------------
+
+/*
+ * Function: set
+ *
+ */
+void
+HPath::set(const HPath& hp)
+{
+	_vecX = hp._vecX;
+	_vecY = hp._vecY;
+	_vecDistances = hp._vecDistances;
+}
+
+/*
+ * Function: set
+ *
+ */
+void
+HPath::set(const HPOINTARRAY& vecHPoints)
+{
+	ASSERT(!vecHPoints.empty());
+
+	_vecX.resize(vecHPoints.size()+1);
+	_vecY.resize(vecHPoints.size()+1);
+	_vecDistances.resize(vecHPoints.size()+1);
+
+	for (size_t iHPoint=0; iHPoint <= vecHPoints.size(); ++iHPoint)
+	{
+		const HPoint& hpt = vecHPoints[min<size_t>(iHPoint, vecHPoints.size()-1)];
+		_vecX[iHPoint] = hpt.x();
+		_vecY[iHPoint] = hpt.y();
+		_vecDistances[iHPoint] = hpt.getDistance();
+	}
+}
+
 //--------------------------------------------------------------------------------
 //
 // HStroke
@@ -86,6 +126,9 @@ HStroke::set(const HStroke& hs)
 
 	_vecPointsForward = hs._vecPointsForward;
 	_vecPointsReverse = hs._vecPointsReverse;
+
+	_pathForward = hs._pathForward;
+	_pathReverse = hs._pathReverse;
 }
 
 /*
@@ -120,6 +163,10 @@ HStroke::load(XMLDocument* pxd, xmlNodePtr pxnStroke)
 		THROWRC((RC(XMLERROR), "Illegal number of reverse point elements"));
 
 	loadFromXML<HPOINTARRAY>(_vecPointsReverse, pxd, spxpo->nodesetval->nodeNr, spxpo->nodesetval->nodeTab);
+
+	// Lay out both sets of points for scoring
+	_pathForward.set(_vecPointsForward);
+	_pathReverse.set(_vecPointsReverse);
 }
 
 //--------------------------------------------------------------------------------
@@ -215,6 +262,7 @@ HOverlap::load(XMLDocument* pxd, xmlNodePtr pxnOverlap)
 
 string Han::s_strScope;
 vector<Han*> Han::s_vecHan;
+shared_timed_mutex Han::s_mutexHan;
 
 /*
  * Function: deleteHan
@@ -245,6 +293,7 @@ void
 Han::terminate()
 {
 	ENTER(HAN,terminate);
+	unique_lock<shared_timed_mutex> lock(s_mutexHan);
 	for_each(s_vecHan.begin(), s_vecHan.end(), deleteHan);
 }
 
@@ -262,6 +311,21 @@ Han::setScope(const char* pszScope)
 	terminatePath(s_strScope);
 }
 
+/*
+ * Function: findDefinition
+ *
+ */
+const Han*
+Han::findDefinition(const string& strUnicode)
+{
+	for (size_t iHan=0; iHan < s_vecHan.size(); ++iHan)
+	{
+		if (*s_vecHan[iHan] == strUnicode)
+			return s_vecHan[iHan];
+	}
+	return NULL;
+}
+
 /*
  * Function: getDefinition
  *
@@ -272,19 +336,17 @@ Han::getDefinition(const string& strUnicode)
 	ENTER(HAN,getDefinition);
 	ASSERT(!EMPTYSTR(strUnicode));
 
-	const Han* pHan = NULL;
-
 	// Return a reference if the Han defintion is already loaded
-	for (size_t iHan=0; iHan < s_vecHan.size(); ++iHan)
 	{
-		if (*s_vecHan[iHan] == strUnicode)
-		{
-			pHan = s_vecHan[iHan];
-			break;
-		}
+		shared_lock<shared_timed_mutex> lock(s_mutexHan);
+		const Han* pHan = findDefinition(strUnicode);
+		if (VALID(pHan))
+			return *pHan;
 	}
 
-	// Otherwise load the defintion from the passed URL
+	// Otherwise load the defintion from the passed URL (unless another engine did so first)
+	unique_lock<shared_timed_mutex> lock(s_mutexHan);
+	const Han* pHan = findDefinition(strUnicode);
 	if (!VALID(pHan))
 	{
 		ASSERT(strUnicode.length() >= 4);
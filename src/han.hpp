@@ -51,6 +51,41 @@ namespace org_biologicinstitute_stylus
 		Rectangle _rectBounds;					///< Bounds of the element
 	};
 
+	/**
+	 * \brief HPath class
+	 *
+	 * The points of a Han stroke, in one direction, held as separate coordinate
+	 * and distance arrays (see Stroke::calcScore).
+	 *
+	 * \remarks
+	 * - The final point is repeated once so that the point following any point may
+	 *   be read without first checking for the end of the path
+	 */
+	class HPath
+	{
+	public:
+		HPath();
+		HPath(const HPath& hp);
+
+		HPath& operator=(const HPath& hp);
+
+		void set(const HPath& hp);
+		void set(const HPOINTARRAY& vecHPoints);
+
+		size_t size() const;
+
+		const UNITARRAY& getX() const;
+		const UNITARRAY& getY() const;
+		const UNITARRAY& getDistances() const;
+
+		HPoint getPoint(size_t iHPoint) const;
+
+	private:
+		UNITARRAY _vecX;						///< Point x-coordinates (including the repeated final point)
+		UNITARRAY _vecY;						///< Point y-coordinates (including the repeated final point)
+		UNITARRAY _vecDistances;				///< Point fractional distances (including the repeated final point)
+	};
+
 	/**
 	 * \brief HStroke class
 	 *
@@ -71,9 +106,15 @@ namespace org_biologicinstitute_stylus
 		const HPOINTARRAY& getPointsForward() const;
 		const HPOINTARRAY& getPointsReverse() const;
 
+		const HPath& getPathForward() const;
+		const HPath& getPathReverse() const;
+
 	private:
 		HPOINTARRAY _vecPointsForward;			///< Stroke points moving forward
 		HPOINTARRAY _vecPointsReverse;			///< Stroke points moving in reverse
+
+		HPath _pathForward;						///< Stroke points moving forward (as arrays)
+		HPath _pathReverse;						///< Stroke points moving in reverse (as arrays)
 	};
 
 	/**
@@ -200,8 +241,11 @@ namespace org_biologicinstitute_stylus
 		const HGroup& mapStrokeToGroup(size_t iStroke) const;
 
 	private:
+		static const Han* findDefinition(const std::string& strUnicode);
+
 		static std::string s_strScope;			///< URL from which to obtain Han definitions
 		static std::vector<Han*> s_vecHan;		///< An array of loaded Han definitions
+		static std::shared_timed_mutex s_mutexHan;	///< Guards s_vecHan across engines (shared for lookups)
 
 		std::string _strUUID;
 		std::string _strUnicode;
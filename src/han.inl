@@ -46,6 +46,28 @@ inline HGroup& HGroup::operator=(const HGroup& hg) { set(hg); return *this; }
 inline const Point& HGroup::getWeightedCenter() const { return _ptWeightedCenter; }
 inline const NUMERICARRAY& HGroup::getStrokes() const { return _vecStrokes; }
 
+//--------------------------------------------------------------------------------
+//
+// HPath
+//
+//--------------------------------------------------------------------------------
+inline HPath::HPath() {}
+inline HPath::HPath(const HPath& hp) { *this = hp; }
+
+inline HPath& HPath::operator=(const HPath& hp) { set(hp); return *this; }
+
+inline size_t HPath::size() const { return (_vecX.empty() ? 0 : _vecX.size()-1); }
+
+inline const UNITARRAY& HPath::getX() const { return _vecX; }
+inline const UNITARRAY& HPath::getY() const { return _vecY; }
+inline const UNITARRAY& HPath::getDistances() const { return _vecDistances; }
+
+inline HPoint HPath::getPoint(size_t iHPoint) const
+{
+	ASSERT(iHPoint < size());
+	return HPoint(_vecX[iHPoint], _vecY[iHPoint], _vecDistances[iHPoint]);
+}
+
 //--------------------------------------------------------------------------------
 //
 // HStroke
@@ -59,6 +81,9 @@ inline HStroke& HStroke::operator=(const HStroke& hs) { set(hs); return *this; }
 inline const HPOINTARRAY& HStroke::getPointsForward() const { return _vecPointsForward; }
 inline const HPOINTARRAY& HStroke::getPointsReverse() const { return _vecPointsReverse; }
 
+inline const HPath& HStroke::getPathForward() const { return _pathForward; }
+inline const HPath& HStroke::getPathReverse() const { return _pathReverse; }
+
 //--------------------------------------------------------------------------------
 //
 // HOverlap
@@ -60,8 +60,10 @@ namespace org_biologicinstitute_stylus
 	 * - The acids are ordered by DIRECTION (see above)
 	 * - Each major axis supports Short, Medium, and Long vectors;
 	 *   Each minor axis supports Short and Medium vectors
+	 * - Acids are held in a single byte so that the acid arrays of long
+	 *   genes stay compact
 	 */
-	enum ACIDTYPE
+	enum ACIDTYPE : unsigned char
 	{
 		ACID_STP = 0,
 
@@ -96,39 +98,60 @@ namespace org_biologicinstitute_stylus
 		ACID_MAX
 	};
 
+	/**
+	 * \brief Lattice step (vector length along one axis) enumeration
+	 * \remarks
+	 * - Major axis vectors step by their Short, Medium, or Long length;
+	 *   minor axis vectors step by the Short or Medium diagonal step along each axis
+	 * - No integer combination of these lengths is zero (other than all zeros)
+	 */
+	enum LATTICESTEP
+	{
+		LS_SHORT = 0,
+		LS_MEDIUM,
+		LS_LONG,
+		LS_SHORTDIAGONAL,
+		LS_MEDIUMDIAGONAL,
+
+		LS_MAX
+	};
+
 	class Acid;
-	class ChangeModification;
+	class AttemptHistory;
+	class BaseSequence;
 	class Codon;
 	class CodonTable;
 	class Constants;
-	class CopyModification;
 	class CostTrialCondition;
-	class DeleteModification;
+	class Description;
+	class Engine;
 	class Error;
 	class EventStack;
 	class FitnessTrialCondition;
 	class Gene;
 	class Genome;
+	class GenomeContext;
+	class GenomeSnapshot;
 	class Globals;
 	class Group;
 	class Han;
 	class HDimensions;
 	class HGroup;
 	class HOverlap;
+	class HPath;
 	class HStroke;
 	class IModification;
 	class IModificationStack;
 	class IndexRange;
-	class InsertModification;
 	class IRandom;
+	class LatticePoint;
 	class Line;
+	class LineCrossing;
 	class LineEvent;
 	class LineStack;
 	class ModificationStack;
 	class Mutation;
-	class MutationModification;
 	class MutationTrialCondition;
-	class MutationModification;
     class MutationSelector;
     class MutationSource;
 	class MutationsPerAttempt;
@@ -138,6 +161,7 @@ namespace org_biologicinstitute_stylus
 	class PlanScope;
 	class Point;
 	class PointDistance;
+	class Population;
 	class RandomC;
 	class Range;
 	class Rectangle;
@@ -157,7 +181,6 @@ namespace org_biologicinstitute_stylus
 #ifdef ST_TRACE
 	class TIndent;
 #endif
-	class TransposeModification;
 	class Unit;
 	class XMLDocument;
 	class XMLStream;
@@ -167,6 +190,7 @@ namespace org_biologicinstitute_stylus
 	typedef long long utime;		///< 64-bit time in microseconds since January 1, 1970
 	
 	typedef std::vector<unsigned int> UINTARRAY;
+	typedef std::vector<unsigned char> COHERENCEARRAY;
 	typedef std::vector<size_t> NUMERICMAP;
 	typedef std::vector<size_t> NUMERICARRAY;
 
@@ -177,6 +201,7 @@ namespace org_biologicinstitute_stylus
 
 	typedef std::vector<Point> POINTARRAY;
 	typedef std::vector<PointDistance> POINTDISTANCEARRAY;
+	typedef std::vector<LatticePoint> LATTICEPOINTARRAY;
 	
 	typedef std::vector<TrialValue> TRIALVALUEARRAY;
 	
@@ -188,6 +213,8 @@ namespace org_biologicinstitute_stylus
 	typedef std::vector<IModificationSRPtr> MODIFICATIONARRAY;
 	typedef std::vector<ModificationStack> MODIFICATIONSTACKARRAY;
 
+	typedef smartref_ptr<GenomeSnapshot> GenomeSnapshotSRPtr;
+
 	typedef std::vector<ACIDTYPE> ACIDTYPEARRAY;
 
 	typedef std::vector<StrokeRange> STROKERANGEARRAY;
@@ -206,6 +233,7 @@ namespace org_biologicinstitute_stylus
 
 	typedef Overlap<size_t> STROKEOVERLAP;
 	typedef std::set<STROKEOVERLAP> STROKEOVERLAPS;
+	typedef std::vector<LineCrossing> LINECROSSINGARRAY;
 }
 #include "stylus.h"
 
@@ -225,9 +253,12 @@ namespace org_biologicinstitute_stylus
 #include "plan.hpp"
 #include "random.hpp"
 #include "randomc.hpp"
+#include "philox.hpp"
+#include "engine.hpp"
 
 #include "global.inl"
 #include "codon.inl"
+#include "engine.inl"
 #include "error.inl"
 #include "gene.inl"
 #include "genome.inl"
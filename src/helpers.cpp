@@ -56,9 +56,9 @@ Range::toString(bool fAsPair) const
 //
 //--------------------------------------------------------------------------------
 
-UNIT Unit::s_nNegativeZero = 0;
-UNIT Unit::s_nPositiveZero = 0;
-bool Unit::s_fImprecisionMode = false;
+thread_local UNIT Unit::s_nNegativeZero = 0;
+thread_local UNIT Unit::s_nPositiveZero = 0;
+thread_local bool Unit::s_fImprecisionMode = false;
 
 void Unit::logConstants()
 {
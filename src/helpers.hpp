@@ -165,9 +165,9 @@ namespace org_biologicinstitute_stylus
         static void beginImpreciseMode();
         static void endImpreciseMode();
 
-		static UNIT s_nNegativeZero;
-		static UNIT s_nPositiveZero;
-        static bool s_fImprecisionMode;
+		static thread_local UNIT s_nNegativeZero;
+		static thread_local UNIT s_nPositiveZero;
+        static thread_local bool s_fImprecisionMode;
 
 		UNIT _n;
 
@@ -181,6 +181,8 @@ namespace org_biologicinstitute_stylus
         ~ImpreciseMode();
     };
 
+	typedef std::vector<UNIT> UNITARRAY;	///< Array of plain values (such as coordinates laid out for scoring)
+
 	/**
 	 * \Brief Point class
 	 *
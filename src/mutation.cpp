@@ -39,402 +39,208 @@ ModificationStack::undo()
 {
 	ENTER(GENOME,undo);
 	
-	for (MODIFICATIONARRAY::reverse_iterator ritModification = _vecModifications.rbegin();
-		ritModification != _vecModifications.rend();
-		++ritModification)
+	for (RECORDARRAY::reverse_iterator ritRecord = _vecRecords.rbegin();
+		ritRecord != _vecRecords.rend();
+		++ritRecord)
 	{
-		TDATA(GENOME,L3,(LLTRACE, "Removing modification %s", (*ritModification)->toString().c_str()));
-		(*ritModification)->undo();
-	}
-	TFLOW(GENOME,L3,(LLTRACE, "Removed the effect of %ld modifications", _vecModifications.size()));	
-}
-
-/*
- * Function: toXML
- *
- */
-void
-ModificationStack::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
-{
-	for (size_t iModification=0; iModification < _vecModifications.size(); ++iModification)
-		_vecModifications[iModification]->toXML(xs, grfRecordDetail);
-}
-
-//--------------------------------------------------------------------------------
-//
-// ChangeModification
-//
-//--------------------------------------------------------------------------------
-
-/*
- * Function: ChangeModification
- *
- */
-ChangeModification::ChangeModification(size_t iGene, size_t iTarget, const char* pbBasesBefore, const char* pbBasesAfter, bool fSilent) :
-	MutationModification(iGene, iTarget, pbBasesBefore), _strBasesAfter(pbBasesAfter)
-{
-	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
-	_fSilent = fSilent;
-	Genome::changeBases(_iGene, _iTarget, _strBasesAfter, _fSilent);
-}
+		const Record& rec = *ritRecord;
+		const char* pbBases = _strBases.c_str() + rec._iBases;
 
-/*
- * Function: undo
- *
- */
-void ChangeModification::undo()
-{
-	ENTER(GENOME,undo);
-	
-	ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
-
-	if (Genome::isState(STGS_ROLLBACK))
-		Genome::undoStatistics(MT_CHANGE, _strBases.length(), _fSilent);
+		TDATA(GENOME,L3,(LLTRACE, "Removing modification %s", recordToString(rec).c_str()));
 
-	Genome::changeBases(_iGene, _iTarget, _strBases, _fSilent);
-}
-
-/*
- * Function: toString
- *
- */
-string
-ChangeModification::toString() const
-{
-	ENTER(MUTATION,toString);
+		if (rec._mt == MT_ILLEGAL)
+		{
+			_vecModifications[rec._iBases]->undo();
+			continue;
+		}
 
-	ostringstream ostr;
+		ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
 
-	ostr << "Change mutation at "
-	 	<< (_iTarget+1)
-		<< " from "
-		<< _strBases
-		<< " to "
-		<< _strBasesAfter;
+		if (Genome::isState(STGS_ROLLBACK))
+			Genome::undoStatistics(rec._mt, rec._cbBases, rec._fSilent);
 
-	return ostr.str();
+		switch (rec._mt)
+		{
+		case MT_CHANGE:
+			Genome::changeBases(rec._iGene, rec._iTarget, pbBases, rec._cbBases, rec._fSilent);
+			break;
+
+		case MT_COPY:
+		case MT_INSERT:
+			Genome::deleteBases(rec._iGene, rec._iTarget, rec._cbBases);
+			break;
+
+		case MT_DELETE:
+			Genome::insertBases(rec._iGene, rec._iTarget, pbBases, rec._cbBases);
+			break;
+
+		case MT_TRANSPOSE:
+			Genome::deleteBases(rec._iGene, rec._iTarget, rec._cbBases);
+			Genome::insertBases(rec._iGeneSource, rec._iSource, pbBases, rec._cbBases);
+			break;
+
+		default:
+			ASSERT(false);
+			break;
+		}
+	}
+	TFLOW(GENOME,L3,(LLTRACE, "Removed the effect of %ld modifications", _vecRecords.size()));	
 }
 
 /*
- * Function: ChangeModification
+ * Function: toXML
  *
  */
 void
-ChangeModification::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
-{
-	ENTER(GENOME,toXML);
-	
-	xs.openStart(xmlTag(XT_CHANGED));
-	xs.writeAttribute(xmlTag(XT_TARGETINDEX), (_iTarget+1));
-	xs.writeAttribute(xmlTag(XT_COUNTBASES), _strBases.length());
-	xs.writeAttribute(xmlTag(XT_BASES), _strBases);
-	xs.writeAttribute(xmlTag(XT_BASESAFTER), _strBasesAfter);
-	xs.closeStart(false);
-}
-
-//--------------------------------------------------------------------------------
-//
-// CopyModification
-//
-//--------------------------------------------------------------------------------
-
-/*
- * Function: CopyModification
- *
- */
-CopyModification::CopyModification(size_t iGene, size_t iSource, size_t iTarget, const char* pbBases) :
-	MutationModification(iGene, iTarget, pbBases), _iSource(iSource)
-{
-	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
-	Genome::insertBases(_iGene, _iTarget, _strBases);
-}
-
-/*
- * Function: undo
- *
- */
-void CopyModification::undo()
+ModificationStack::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
 {
-	ENTER(GENOME,undo);
-	
-	ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
-
-	if (Genome::isState(STGS_ROLLBACK))
-		Genome::undoStatistics(MT_COPY, _strBases.length(), false);
-
-	Genome::deleteBases(_iGene, _iTarget, _strBases.length());
+	for (size_t iRecord=0; iRecord < _vecRecords.size(); ++iRecord)
+		recordToXML(xs, _vecRecords[iRecord], grfRecordDetail);
 }
 
 /*
- * Function: toString
+ * Function: recordToString
  *
  */
 string
-CopyModification::toString() const
+ModificationStack::recordToString(const Record& rec) const
 {
-	ENTER(MUTATION,toString);
-
-	ostringstream ostr;
-
-	ostr << "Copy mutation from "
-		<< (_iSource+1)
-		<< " to "
-		<< (_iTarget+1)
-		<< " of "
-		<< _strBases.length()
-		<< " bases ("
-		<< _strBases
-		<< ")";
-
-	return ostr.str();
-}
-
-/*
- * Function: CopyModification
- *
- */
-void
-CopyModification::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
-{
-	ENTER(GENOME,toXML);
-	
-	xs.openStart(xmlTag(XT_COPIED));
-	xs.writeAttribute(xmlTag(XT_SOURCEINDEX), (_iSource+1));
-	xs.writeAttribute(xmlTag(XT_TARGETINDEX), (_iTarget+1));
-	xs.writeAttribute(xmlTag(XT_COUNTBASES), _strBases.length());
-	xs.writeAttribute(xmlTag(XT_BASES), _strBases);
-	xs.closeStart(false);
-}
+	ENTER(MUTATION,recordToString);
 
-//--------------------------------------------------------------------------------
-//
-// DeleteModification
-//
-//--------------------------------------------------------------------------------
-
-/*
- * Function: DeleteModification
- *
- */
-DeleteModification::DeleteModification(size_t iGene, size_t iTarget, const char* pbBases) :
-	MutationModification(iGene, iTarget, pbBases)
-{
-	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
-	Genome::deleteBases(_iGene, _iTarget, _strBases.length());
-}
-
-/*
- * Function: undoChange
- *
- */
-void DeleteModification::undo()
-{
-	ENTER(GENOME,undo);
-	
-	ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
-
-	if (Genome::isState(STGS_ROLLBACK))
-		Genome::undoStatistics(MT_DELETE, _strBases.length(), false);
-
-	Genome::insertBases(_iGene, _iTarget, _strBases);
-}
-
-/*
- * Function: toString
- *
- */
-string
-DeleteModification::toString() const
-{
-	ENTER(MUTATION,toString);
+	if (rec._mt == MT_ILLEGAL)
+		return _vecModifications[rec._iBases]->toString();
 
+	const char* pbBases = _strBases.c_str() + rec._iBases;
 	ostringstream ostr;
 
-	ostr << "Delete mutation from "
-		<< (_iTarget+1)
-		<< " of "
-		<< _strBases.length()
-		<< " bases ("
-		<< _strBases
-		<< ")";
-
-	return ostr.str();
-}
-
-/*
- * Function: DeleteModification
- *
- */
-void
-DeleteModification::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
-{
-	ENTER(GENOME,toXML);
-	
-	xs.openStart(xmlTag(XT_DELETED));
-	xs.writeAttribute(xmlTag(XT_TARGETINDEX), (_iTarget+1));
-	xs.writeAttribute(xmlTag(XT_COUNTBASES), _strBases.length());
-	xs.writeAttribute(xmlTag(XT_BASES), _strBases);
-	xs.closeStart(false);
-}
-
-//--------------------------------------------------------------------------------
-//
-// InsertModification
-//
-//--------------------------------------------------------------------------------
-
-/*
- * Function: InsertModification
- *
- */
-InsertModification::InsertModification(size_t iGene, size_t iTarget, const char* pbBases) :
-	MutationModification(iGene, iTarget, pbBases)
-{
-	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
-	Genome::insertBases(_iGene, _iTarget, _strBases);
-}
-
-/*
- * Function: undoChange
- *
- */
-void InsertModification::undo()
-{
-	ENTER(GENOME,undo);
-	
-	ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
+	switch (rec._mt)
+	{
+	case MT_CHANGE:
+		ostr << "Change mutation at "
+			<< (rec._iTarget+1)
+			<< " from "
+			<< pbBases
+			<< " to "
+			<< (_strBases.c_str() + rec._iBasesAfter);
+		break;
 
-	if (Genome::isState(STGS_ROLLBACK))
-		Genome::undoStatistics(MT_INSERT, _strBases.length(), false);
+	case MT_COPY:
+		ostr << "Copy mutation from "
+			<< (rec._iSource+1)
+			<< " to "
+			<< (rec._iTarget+1)
+			<< " of "
+			<< rec._cbBases
+			<< " bases ("
+			<< pbBases
+			<< ")";
+		break;
 
-	Genome::deleteBases(_iGene, _iTarget, _strBases.length());
-}
+	case MT_DELETE:
+		ostr << "Delete mutation from "
+			<< (rec._iTarget+1)
+			<< " of "
+			<< rec._cbBases
+			<< " bases ("
+			<< pbBases
+			<< ")";
+		break;
 
-/*
- * Function: toString
- *
- */
-string
-InsertModification::toString() const
-{
-	ENTER(MUTATION,toString);
+	case MT_INSERT:
+		ostr << "Insert mutation to "
+			<< (rec._iTarget+1)
+			<< " of "
+			<< rec._cbBases
+			<< " bases ("
+			<< pbBases
+			<< ")";
+		break;
 
-	ostringstream ostr;
+	case MT_TRANSPOSE:
+		ostr << "Transpose mutation from "
+			<< (rec._iSource+1)
+			<< " to "
+			<< (rec._iTarget+1)
+			<< " of "
+			<< rec._cbBases
+			<< " bases ("
+			<< pbBases
+			<< ")";
+		break;
 
-	ostr << "Insert mutation to "
-		<< (_iTarget+1)
-		<< " of "
-		<< _strBases.length()
-		<< " bases ("
-		<< _strBases
-		<< ")";
+	default:
+		ASSERT(false);
+		break;
+	}
 
 	return ostr.str();
 }
 
 /*
- * Function: InsertModification
+ * Function: recordToXML
  *
  */
 void
-InsertModification::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
+ModificationStack::recordToXML(XMLStream& xs, const Record& rec, STFLAGS grfRecordDetail) const
 {
-	ENTER(GENOME,toXML);
-	
-	xs.openStart(xmlTag(XT_INSERTED));
-	xs.writeAttribute(xmlTag(XT_TARGETINDEX), (_iTarget+1));
-	xs.writeAttribute(xmlTag(XT_COUNTBASES), _strBases.length());
-	xs.writeAttribute(xmlTag(XT_BASES), _strBases);
-	xs.closeStart(false);
-}
+	ENTER(GENOME,recordToXML);
 
-//--------------------------------------------------------------------------------
-//
-// TransposeModification
-//
-//--------------------------------------------------------------------------------
-
-/*
- * Function: TransposeModification
- *
- */
-TransposeModification::TransposeModification(size_t iGeneSource, size_t iGeneTarget, size_t iSource, size_t iTarget, const char* pbBases) :
-	MutationModification(iGeneTarget, iTarget, pbBases), _iGeneSource(iGeneSource), _iSource(iSource)
-{
-	ASSERT(!Genome::isState(STGS_ROLLBACK) && !Genome::isState(STGS_RESTORING));
-	ASSERT(_iSource >= _iTarget || (_iSource+_strBases.length() <= _iTarget));
-
-	if (_iSource < _iTarget)
+	if (rec._mt == MT_ILLEGAL)
 	{
-		_iTarget -= _strBases.length();
-		ASSERT(_iSource <= _iTarget);
+		_vecModifications[rec._iBases]->toXML(xs, grfRecordDetail);
+		return;
 	}
 
-	Genome::deleteBases(_iGeneSource, _iSource, _strBases.length());
-	ASSERT(_iGene == Genome::indexToGene(_iTarget));
-
-	Genome::insertBases(_iGene, _iTarget, _strBases);
-}
+	const char* pbBases = _strBases.c_str() + rec._iBases;
 
-/*
- * Function: undoChange
- *
- */
-void TransposeModification::undo()
-{
-	ENTER(GENOME,undoChange);
-	
-	ASSERT(Genome::isState(STGS_ROLLBACK) || Genome::isState(STGS_RESTORING));
-
-	if (Genome::isState(STGS_ROLLBACK))
-		Genome::undoStatistics(MT_TRANSPOSE, _strBases.length(), false);
-	
-	Genome::deleteBases(_iGene, _iTarget, _strBases.length());
-	Genome::insertBases(_iGeneSource, _iSource, _strBases);
-}
+	switch (rec._mt)
+	{
+	case MT_CHANGE:
+		xs.openStart(xmlTag(XT_CHANGED));
+		xs.writeAttribute(xmlTag(XT_TARGETINDEX), (rec._iTarget+1));
+		xs.writeAttribute(xmlTag(XT_COUNTBASES), rec._cbBases);
+		xs.writeAttribute(xmlTag(XT_BASES), pbBases);
+		xs.writeAttribute(xmlTag(XT_BASESAFTER), _strBases.c_str() + rec._iBasesAfter);
+		break;
 
-/*
- * Function: toString
- *
- */
-string
-TransposeModification::toString() const
-{
-	ENTER(MUTATION,toString);
+	case MT_COPY:
+		xs.openStart(xmlTag(XT_COPIED));
+		xs.writeAttribute(xmlTag(XT_SOURCEINDEX), (rec._iSource+1));
+		xs.writeAttribute(xmlTag(XT_TARGETINDEX), (rec._iTarget+1));
+		xs.writeAttribute(xmlTag(XT_COUNTBASES), rec._cbBases);
+		xs.writeAttribute(xmlTag(XT_BASES), pbBases);
+		break;
 
-	ostringstream ostr;
+	case MT_DELETE:
+		xs.openStart(xmlTag(XT_DELETED));
+		xs.writeAttribute(xmlTag(XT_TARGETINDEX), (rec._iTarget+1));
+		xs.writeAttribute(xmlTag(XT_COUNTBASES), rec._cbBases);
+		xs.writeAttribute(xmlTag(XT_BASES), pbBases);
+		break;
 
-	ostr << "Transpose mutation from "
-		<< (_iSource+1)
-		<< " to "
-		<< (_iTarget+1)
-		<< " of "
-		<< _strBases.length()
-		<< " bases ("
-		<< _strBases
-		<< ")";
+	case MT_INSERT:
+		xs.openStart(xmlTag(XT_INSERTED));
+		xs.writeAttribute(xmlTag(XT_TARGETINDEX), (rec._iTarget+1));
+		xs.writeAttribute(xmlTag(XT_COUNTBASES), rec._cbBases);
+		xs.writeAttribute(xmlTag(XT_BASES), pbBases);
+		break;
 
-	return ostr.str();
-}
+	case MT_TRANSPOSE:
+		xs.openStart(xmlTag(XT_TRANSPOSED));
+		xs.writeAttribute(xmlTag(XT_SOURCEINDEX), (rec._iSource+1));
+		xs.writeAttribute(xmlTag(XT_TARGETINDEX), (rec._iTarget+1));
+		xs.writeAttribute(xmlTag(XT_COUNTBASES), rec._cbBases);
+		xs.writeAttribute(xmlTag(XT_BASES), pbBases);
+		break;
 
-/*
- * Function: TransposeModification
- *
- */
-void
-TransposeModification::toXML(XMLStream& xs, STFLAGS grfRecordDetail) const
-{
-	ENTER(GENOME,toXML);
+	default:
+		ASSERT(false);
+		return;
+	}
 
-	xs.openStart(xmlTag(XT_TRANSPOSED));
-	xs.writeAttribute(xmlTag(XT_SOURCEINDEX), (_iSource+1));
-	xs.writeAttribute(xmlTag(XT_TARGETINDEX), (_iTarget+1));
-	xs.writeAttribute(xmlTag(XT_COUNTBASES), _strBases.length());
-	xs.writeAttribute(xmlTag(XT_BASES), _strBases);
 	xs.closeStart(false);
 }
 
-
 //--------------------------------------------------------------------------------
 //
 // Genome
@@ -599,55 +405,179 @@ Genome::executePlan(const char* pxmlPlan, size_t iTrialFirst, size_t cTrials, ST
 	// Load the supplied plan
 	_plan.load(pxmlPlan);
 
+	// Size the fitness cache for the plan (entries do not carry over between plans)
+	_cacheFitness.clear();
+	_cacheFitness.setSize(_plan.getFitnessCache());
 
 	// Save the initial genome and plan
-	if (isRecording())
+	recordPlan(RT_INITIAL);
+
+	// Execute the loaded plan, evolving a population of lineages if requested
+	if (_plan.getPopulation() > 1)
+		Population::execute(iTrialFirst, cTrials, pfnStatus, cStatusRate);
+	else
+		_plan.execute(iTrialFirst, cTrials, pfnStatus, cStatusRate);
+	
+	// Save the final genome and close the history file
+	recordPlan(RT_FINAL);
+}
+
+/*
+ * Function: recordPlan
+ *
+ * Record the genome, and open or close the history, at the start or end of
+ * executing a plan.
+ */
+void
+Genome::recordPlan(RECORDTYPE rt)
+{
+	ENTER(MUTATION,recordPlan);
+	ASSERT(rt == RT_INITIAL || rt == RT_FINAL);
+
+	if (rt == RT_INITIAL)
 	{
-		if (Globals::isSupplied())
+		if (isRecording())
 		{
-			ostringstream ostrGlobals;
-			ostrGlobals
+			if (Globals::isSupplied())
+			{
+				ostringstream ostrGlobals;
+				ostrGlobals
+					<< _strRecordDirectory
+					<< Constants::s_strGLOBALS
+					<< Constants::s_strXMLEXTENSION;
+				
+				ofstream ofstr(ostrGlobals.str().c_str(), ios::out | ios::trunc);
+				if (!ofstr || !ofstr.is_open())
+					THROWRC((RC(ERROR), "Unable to create global constants file %s", ostrGlobals.str().c_str()));
+
+				XMLStream xs(ofstr);
+				Globals::toXML(xs);
+			}
+
+			record(RT_INITIAL);
+
+			ostringstream ostrPlan;
+			ostrPlan
 				<< _strRecordDirectory
-				<< Constants::s_strGLOBALS
+				<< Constants::s_strPLAN
 				<< Constants::s_strXMLEXTENSION;
-				
-			ofstream ofstr(ostrGlobals.str().c_str(), ios::out | ios::trunc);
+
+			ofstream ofstr(ostrPlan.str().c_str(), ios::out | ios::trunc);
 			if (!ofstr || !ofstr.is_open())
-				THROWRC((RC(ERROR), "Unable to create global constants file %s", ostrGlobals.str().c_str()));
+				THROWRC((RC(ERROR), "Unable to create plan file %s", ostrPlan.str().c_str()));
 
+			ImpreciseMode impreciseMode;
 			XMLStream xs(ofstr);
-			Globals::toXML(xs);
+			_plan.toXML(xs);
 		}
+	
+		// Initialize a history file if recording history
+		if (isRecordingHistory())
+			recordHistory(RT_INITIAL);
+	}
+	else
+	{
+		if (isRecording())
+			record(RT_FINAL);
+		if (isRecordingHistory())
+			recordHistory(RT_FINAL);
+	}
+}
 
-		record(RT_INITIAL);
+/*
+ * Function: evaluateMutations
+ *
+ * Evaluate each passed mutation against the genome without keeping the
+ * result. The mutations are divided among workers, each holding a private
+ * copy of the genome (and the last loaded plan, whose options govern the
+ * mutations). The calling thread evaluates its share against a private copy
+ * as well, so the Genome, its statistics, and its history are never touched.
+ */
+void
+Genome::evaluateMutations(const ST_MUTATION* aryMutations, size_t cMutations, ST_EVALRESULT* aryResults)
+{
+	ENTER(MUTATION,evaluateMutations);
+	THROWIFEXECUTING(evaluateMutations);
+	REQUIREALIVE(evaluateMutations);
 
-		ostringstream ostrPlan;
-		ostrPlan
-			<< _strRecordDirectory
-			<< Constants::s_strPLAN
-			<< Constants::s_strXMLEXTENSION;
+	ASSERT(VALID(aryMutations));
+	ASSERT(VALID(aryResults));
 
-		ofstream ofstr(ostrPlan.str().c_str(), ios::out | ios::trunc);
-		if (!ofstr || !ofstr.is_open())
-			THROWRC((RC(ERROR), "Unable to create plan file %s", ostrPlan.str().c_str()));
+	// Load all mutations before evaluating any so that bad arguments leave no partial results
+	vector<Mutation> vecMutations(cMutations);
+	for (size_t iMutation=0; iMutation < cMutations; ++iMutation)
+		vecMutations[iMutation].load(aryMutations[iMutation]);
 
-        ImpreciseMode impreciseMode;
-		XMLStream xs(ofstr);
-		_plan.toXML(xs);
+	size_t cWorkers = max<size_t>(WorkerPool::getWorkers(cMutations / s_cminWORKEREVALUATIONS), 1);
+	vector<GenomeContext> vecContexts(cWorkers);
+	for (size_t iWorker=0; iWorker < cWorkers; ++iWorker)
+	{
+		copyContext(vecContexts[iWorker]);
+		vecContexts[iWorker]._plan = _plan;
+
+		// Mutations, as within a trial, are made to an INVALID genome (so that validation scores them)
+		vecContexts[iWorker]._gsCurrent = STGS_INVALID;
 	}
-	
-	// Initialize a history file if recording history
-	if (isRecordingHistory())
-		recordHistory(RT_INITIAL);
 
-	// Execute the loaded plan
-	_plan.execute(iTrialFirst, cTrials, pfnStatus, cStatusRate);
-	
-	// Save the final genome and close the history file
-	if (isRecording())
-		record(RT_FINAL);
-	if (isRecordingHistory())
-		recordHistory(RT_FINAL);
+	size_t cPerWorker = (cMutations + cWorkers - 1) / cWorkers;
+	auto fnEvaluate = [&](size_t iWorker)
+	{
+		size_t iFirst = min(iWorker * cPerWorker, cMutations);
+		size_t iLast = min(iFirst + cPerWorker, cMutations);
+
+		exchangeContext(vecContexts[iWorker]);
+		try
+		{
+			for (size_t iMutation=iFirst; iMutation < iLast; ++iMutation)
+				evaluateMutation(vecMutations[iMutation], aryResults[iMutation]);
+		}
+		catch (...)
+		{
+			exchangeContext(vecContexts[iWorker]);
+			throw;
+		}
+		exchangeContext(vecContexts[iWorker]);
+	};
+
+	if (cWorkers <= 1)
+		fnEvaluate(0);
+	else
+		WorkerPool::execute(cWorkers, fnEvaluate);
+}
+
+/*
+ * Function: evaluateMutation
+ *
+ * Apply, validate, score, and then rollback the passed mutation recording
+ * the outcome. Scores are not-a-number unless the mutated genome validated.
+ */
+void
+Genome::evaluateMutation(Mutation& mt, ST_EVALRESULT& er)
+{
+	ENTER(MUTATION,evaluateMutation);
+	ASSERT(isState(STGS_INVALID));
+
+	_gaTermination = STGT_NONE;
+	_grTermination = STGR_NONE;
+	_dsTermination.clear();
+
+	er._fValid = _plan.applyMutation(mt) && validate();
+	if (er._fValid)
+	{
+		er._nScore = getScore();
+		er._nUnits = getGeneUnits();
+		er._nCost = getCost();
+		er._nFitness = getFitness();
+	}
+	else
+		er._nScore = er._nUnits = er._nCost = er._nFitness = numeric_limits<UNIT>::quiet_NaN();
+	er._gt = _gaTermination;
+	er._gr = _grTermination;
+
+	rollback();
+
+	// Discard the attempt recorded by the rollback
+	purgeModifications();
 }
 
 /*
@@ -662,7 +592,7 @@ Genome::handleChange(const Mutation& mt, bool fPreserveGenes, bool fRejectSilent
 	size_t iTarget = mt.targetIndex();
 	size_t cbBases = mt.countBases();
 
-	string strBases(_strBases.substr(iTarget, cbBases));
+	string strBases(_seqBases.substr(iTarget, cbBases));
 	const char* pbBasesBefore = strBases.c_str();
 	const char* pbBasesAfter = mt.bases().c_str();
 
@@ -676,7 +606,7 @@ Genome::handleChange(const Mutation& mt, bool fPreserveGenes, bool fRejectSilent
 	size_t iGene = indexToGene(iTarget);
 	
 	// Determine if the change is silent
-	bool fSilent = Codon::isSilentChange(_strBases, iTarget, mt.bases());
+	bool fSilent = Codon::isSilentChange(_seqBases, iTarget, mt.bases());
 
 	// Record mutational statistics
 	recordStatistics(MT_CHANGE, cbBases, fSilent);
@@ -703,7 +633,7 @@ Genome::handleChange(const Mutation& mt, bool fPreserveGenes, bool fRejectSilent
 		const char* pbCodon = (cbBases == 1 ? aryCodon : pbBasesAfter);
 		if (cbBases == 1)
 		{
-			::memcpy(aryCodon, (_strBases.c_str()+Codon::toCodonBoundary(iTarget)), Codon::s_cchCODON);
+			::memcpy(aryCodon, _seqBases.view(Codon::toCodonBoundary(iTarget), Codon::s_cchCODON), Codon::s_cchCODON);
 			aryCodon[Codon::toCodonOffset(iTarget)] = *pbBasesAfter;
 		}
 		if (iGene >= _vecGenes.size() && Codon::isStart(pbCodon))
@@ -714,7 +644,8 @@ Genome::handleChange(const Mutation& mt, bool fPreserveGenes, bool fRejectSilent
 	}
 
 	// Make and record the mutation
-	recordModification(::new ChangeModification(iGene, iTarget, pbBasesBefore, pbBasesAfter, fSilent));
+	_msModifications.recordMutation(MT_CHANGE, iGene, iGene, iTarget, iTarget, pbBasesBefore, cbBases, pbBasesAfter, fSilent);
+	changeBases(iGene, iTarget, pbBasesAfter, cbBases, fSilent);
 
 	TFLOW(MUTATION,L2,(LLTRACE, "Mutating %ld from %s to %s in trial %ld", (iTarget+1), pbBasesBefore, pbBasesAfter, getTrial()));
 	return true;
@@ -759,11 +690,11 @@ Genome::handleCopy(const Mutation& mt, bool fPreserveGenes)
 	size_t cbBases = mt.countBases();
 
 #if defined(ST_TRACE)
-	const char* pbBases = _strBases.c_str() + iTarget;
+	const char* pbBases = _seqBases.str().c_str() + iTarget;
 #endif
 
 	ASSERT(mt.isCopy());
-	ASSERT(cbBases < (max<size_t>(_strBases.length(),iTarget)-iSource));
+	ASSERT(cbBases < (max<size_t>(_seqBases.length(),iTarget)-iSource));
 	ASSERT(fPreserveGenes);
 	ASSERT(Codon::onCodonBoundary(iSource));
 	ASSERT(Codon::onCodonBoundary(iTarget));
@@ -799,10 +730,14 @@ Genome::handleCopy(const Mutation& mt, bool fPreserveGenes)
 	}
 
 	// Make and record the mutation
-	recordModification(::new CopyModification(iGene, iSource, iTarget, _strBases.substr(iSource,cbBases).c_str()));
+	// - The bases are inserted from the record since the view does not survive changes to the genome
+	{
+		const char* pbCopied = _msModifications.recordMutation(MT_COPY, iGene, iGene, iSource, iTarget, _seqBases.view(iSource,cbBases), cbBases);
+		insertBases(iGene, iTarget, pbCopied, cbBases);
+	}
 
 	TFLOW(MUTATION,L2,(LLTRACE, "Copying %ld bases from %ld to %ld in trial %ld", cbBases, (iSource+1), (iTarget+1), getTrial()));
-	TDATA(MUTATION,L4,(LLTRACE, "Copied %s", _strBases.substr(iSource,cbBases).c_str()));
+	TDATA(MUTATION,L4,(LLTRACE, "Copied %s", _seqBases.substr(iSource,cbBases).c_str()));
 	return true;
 
 REJECT1:
@@ -851,7 +786,7 @@ Genome::handleDelete(const Mutation& mt, bool fPreserveGenes)
 	recordStatistics(MT_DELETE, cbBases, false);
 	
 	// Ensure the deletion remains within the boundaries of the genome
-	if ((iTarget+cbBases) > _strBases.length())
+	if ((iTarget+cbBases) > _seqBases.length())
 		goto REJECT;
 
 	// Preserve any existing genes
@@ -875,10 +810,10 @@ Genome::handleDelete(const Mutation& mt, bool fPreserveGenes)
 	}
 
 	// Make and record the mutation
-	recordModification(::new DeleteModification(iGeneFirst, iTarget, _strBases.substr(iTarget,cbBases).c_str()));
+	_msModifications.recordMutation(MT_DELETE, iGeneFirst, iGeneFirst, iTarget, iTarget, _seqBases.view(iTarget,cbBases), cbBases);
+	deleteBases(iGeneFirst, iTarget, cbBases);
 
 	TFLOW(MUTATION,L2,(LLTRACE, "Deleting %ld bases from %ld in trial %ld", cbBases, (iTarget+1), getTrial()));
-	TDATA(MUTATION,L4,(LLTRACE, "Deleted %s", _strBases.substr(iTarget,cbBases).c_str()));
 	return true;
 
 REJECT1:
@@ -897,7 +832,7 @@ REJECT3:
 	goto REJECT;
 
 REJECT:
-	TFLOW(MUTATION,L4,(LLTRACE, "Rejected deletion of %s", _strBases.substr(iTarget,cbBases).c_str()));
+	TFLOW(MUTATION,L4,(LLTRACE, "Rejected deletion of %s", _seqBases.substr(iTarget,cbBases).c_str()));
 	undoStatistics(MT_DELETE, cbBases, false);
 	return false;
 }
@@ -953,7 +888,8 @@ Genome::handleInsert(const Mutation& mt, bool fPreserveGenes)
 	}
 
 	// Make and record the mutation
-	recordModification(::new InsertModification(iGene, iTarget, pbBases));
+	_msModifications.recordMutation(MT_INSERT, iGene, iGene, iTarget, iTarget, pbBases, cbBases);
+	insertBases(iGene, iTarget, pbBases, cbBases);
 
 	TFLOW(MUTATION,L2,(LLTRACE, "Inserting %ld bases at %ld in trial %ld", cbBases, (iTarget+1), getTrial()));
 	TDATA(MUTATION,L4,(LLTRACE, "Inserted %s", string(pbBases,cbBases).c_str()));
@@ -999,7 +935,7 @@ Genome::handleTranspose(const Mutation& mt, bool fPreserveGenes)
 	size_t cbBases = mt.countBases();
 
 	ASSERT(mt.isTranspose());
-	ASSERT((iSource+cbBases) < _strBases.length());
+	ASSERT((iSource+cbBases) < _seqBases.length());
 	ASSERT(fPreserveGenes);
 	ASSERT(Codon::onCodonBoundary(iSource));
 	ASSERT(Codon::onCodonBoundary(iTarget));
@@ -1008,7 +944,7 @@ Genome::handleTranspose(const Mutation& mt, bool fPreserveGenes)
 	// First, determine and copy the bases from the source location
 	size_t iGeneTarget = indexToGene(iTarget);
 	size_t iGeneSource = indexToGene(iSource);
-	string strBasesSource(_strBases.c_str(), iSource, cbBases);
+	string strBasesSource(_seqBases.substr(iSource, cbBases));
 	
 	// Record mutational statistics
 	recordStatistics(MT_TRANSPOSE, cbBases, false);
@@ -1035,7 +971,17 @@ Genome::handleTranspose(const Mutation& mt, bool fPreserveGenes)
 	}
 
 	// Make and record the mutation
-	recordModification(::new TransposeModification(iGeneSource, iGeneTarget, iSource, iTarget, strBasesSource.c_str()));
+	// - The target is adjusted to account for the removal of the source bases
+	ASSERT(iSource >= iTarget || (iSource+cbBases) <= iTarget);
+	{
+		size_t iTargetAdjusted = (iSource < iTarget ? iTarget - cbBases : iTarget);
+		ASSERT(iSource >= iTarget || iSource <= iTargetAdjusted);
+
+		_msModifications.recordMutation(MT_TRANSPOSE, iGeneSource, iGeneTarget, iSource, iTargetAdjusted, strBasesSource.c_str(), cbBases);
+		deleteBases(iGeneSource, iSource, cbBases);
+		ASSERT(iGeneTarget == indexToGene(iTargetAdjusted));
+		insertBases(iGeneTarget, iTargetAdjusted, strBasesSource.c_str(), cbBases);
+	}
 
 	TFLOW(MUTATION,L2,(LLTRACE, "Transposing %ld bases from %ld to %ld in trial %ld", cbBases, (iSource+1), (iTarget+1), getTrial()));
 	TDATA(MUTATION,L4,(LLTRACE, "Transposed %s", strBasesSource.c_str()));
@@ -1067,19 +1013,19 @@ REJECT:
  *
  */
 void
-Genome::changeBases(size_t iGene, size_t iTarget, const std::string& strBases, bool fSilent)
+Genome::changeBases(size_t iGene, size_t iTarget, const char* pbBases, size_t cbBases, bool fSilent)
 {
 	ENTER(MUTATION,changeBases);
 	
 	TFLOW(MUTATION,L3,(LLTRACE, "Making a %s change in genome at %lu", (fSilent ? "silent" : "non-silent"), iTarget));
 
 	// Change the bases
-	_strBases.replace(iTarget, strBases.length(), strBases);
+	_seqBases.replace(iTarget, pbBases, cbBases);
 
 	// Mark the affected gene invalid
 	if (iGene < _vecGenes.size())
 	{
-		_vecGenes[iGene].markInvalid(Gene::GC_CHANGE, Range(iTarget,iTarget+strBases.length()-1), fSilent);
+		_vecGenes[iGene].markInvalid(Gene::GC_CHANGE, Range(iTarget,iTarget+cbBases-1), fSilent);
 		_grfGenesInvalid.set(iGene);
 	}
 }
@@ -1096,10 +1042,10 @@ Genome::deleteBases(size_t iGene, size_t iTarget, size_t cbBases)
 	TFLOW(MUTATION,L3,(LLTRACE, "Deleting %lu bases from genome at %lu", cbBases, (iTarget+1)));
 
 	// Remove the bases
-	_strBases.erase(iTarget,cbBases);
+	_seqBases.erase(iTarget,cbBases);
 	
 	// Update the statistics
-	_statsRecordRate._cbBases = _strBases.length();
+	_statsRecordRate._cbBases = _seqBases.length();
 	_stats._cbBases = _statsRecordRate._cbBases;
 
 	// Shrink the affected gene and mark it invalid, if any
@@ -1119,19 +1065,17 @@ Genome::deleteBases(size_t iGene, size_t iTarget, size_t cbBases)
  *
  */
 void
-Genome::insertBases(size_t iGene, size_t iTarget, const string& strBases)
+Genome::insertBases(size_t iGene, size_t iTarget, const char* pbBases, size_t cbBases)
 {
 	ENTER(MUTATION,insertBases);
 	
-	TFLOW(MUTATION,L3,(LLTRACE, "Inserting %lu bases to the genome at %lu", strBases.length(), (iTarget+1)));
-	
-	size_t cbBases = strBases.length();
+	TFLOW(MUTATION,L3,(LLTRACE, "Inserting %lu bases to the genome at %lu", cbBases, (iTarget+1)));
 	
 	// Insert the new bases
-	_strBases.insert(iTarget, strBases);
+	_seqBases.insert(iTarget, pbBases, cbBases);
 	
 	// Update the statistics
-	_statsRecordRate._cbBases = _strBases.length();
+	_statsRecordRate._cbBases = _seqBases.length();
 	_stats._cbBases = _statsRecordRate._cbBases;
 
 	// Extend the affected gene, if any, to encompass the inserted bases and mark it invalid
@@ -23,6 +23,59 @@
 using namespace std;
 using namespace stylus;
 
+// Helpers ----------------------------------------------------------------------
+/*
+ * Function: isSame
+ *
+ * Values are the same if they match exactly or are equal within the error
+ * margin; outside of imprecise mode the margin is zero and only exact
+ * matches count.
+ */
+static inline bool
+isSame(UNIT n1, const Unit& n2)
+{
+	return (n1 == static_cast<UNIT>(n2) || n2 == n1);
+}
+
+/*
+ * Function: isSamePoint
+ *
+ */
+static inline bool
+isSamePoint(const Point& pt1, const Point& pt2)
+{
+	return (isSame(pt1.x(), pt2.x()) && isSame(pt1.y(), pt2.y()));
+}
+
+#if defined(ST_DEBUG)
+/*
+ * Function: isSameOverlaps
+ *
+ * Compare overlaps pairwise since, with no error margin, the ordering of points
+ * within the sets (and thus set equality) cannot be relied upon.
+ */
+static bool
+isSameOverlaps(const STROKEOVERLAPS& setOverlaps1, const STROKEOVERLAPS& setOverlaps2)
+{
+	if (setOverlaps1.size() != setOverlaps2.size())
+		return false;
+
+	for (STROKEOVERLAPS::const_iterator it1 = setOverlaps1.begin(); it1 != setOverlaps1.end(); ++it1)
+	{
+		STROKEOVERLAPS::const_iterator it2 = setOverlaps2.begin();
+		for (; it2 != setOverlaps2.end(); ++it2)
+		{
+			if (	it1->getFirst() == it2->getFirst()
+				&&	it1->getSecond() == it2->getSecond()
+				&&	isSamePoint(it1->getPoint(), it2->getPoint()))
+				break;
+		}
+		if (it2 == setOverlaps2.end())
+			return false;
+	}
+	return true;
+}
+#endif
 
 
 //--------------------------------------------------------------------------------
@@ -50,6 +103,13 @@ LineEvent::compare(const LineEvent& le) const
 	if (_pt.x() > le._pt.x())
 		return 1;
 		
+	// Next, sort descending by the y-coordinate value
+	// - Move top to bottom along the same x-coordinate (matching canonical vertical lines)
+	if (_pt.y() > le._pt.y())
+		return -1;
+	if (_pt.y() < le._pt.y())
+		return 1;
+		
 	// Then, sort ascending by the event type
 	// - This becomes ENTER before SWAP before EXIT
 	// - The code assumes the LINEEVENTTYPE enum reflects this order
@@ -58,12 +118,6 @@ LineEvent::compare(const LineEvent& le) const
 	if (_let > le._let)
 		return 1;
 		
-	// Next, sort descending by the y-coordinate value
-	if (_pt.y() > le._pt.y())
-		return -1;
-	if (_pt.y() < le._pt.y())
-		return 1;
-		
 	// Finally, sort ascending by line IDs
 	if (_ln->getID() < le._ln->getID())
 		return -1;
@@ -97,11 +151,10 @@ string LineEvent::toString() const
 //--------------------------------------------------------------------------------
 
 /*
- * Function: EventStack
+ * Function: pushLines
  *
- * Add ENTER and EXIT events for all lines. Also, add SWAP events where two lines (vectors)
- * connect since these can never be an intersection between strokes (overlap detection
- * also skips over these and assumes the SWAP events exist).
+ * Add ENTER and EXIT events for all lines. SWAP events are added as the sweep
+ * discovers lines crossing beyond the sweep position.
  * 
  * Note:
  * - Line IDs are indexes into the Gene Acid/Point arrays; adjacent IDs reflect adjacent
@@ -110,14 +163,17 @@ string LineEvent::toString() const
 void
 EventStack::pushLines(const vector<Line>& vecLines)
 {
-	_llEvents.clear();
+	_vecEvents.clear();
+	_vecEvents.reserve(vecLines.size() * 2);
+	_iEvent = 0;
+	_vecSwaps.clear();
 	for (size_t iLine=0; iLine < vecLines.size(); ++iLine)
 	{
 		const Line& ln = vecLines[iLine];
-		_llEvents.push_back(LineEvent(LET_ENTER, ln.getStart(), ln));
-		_llEvents.push_back(LineEvent(LET_EXIT, ln.getEnd(), ln));
+		_vecEvents.push_back(LineEvent(LET_ENTER, ln.getStart(), ln));
+		_vecEvents.push_back(LineEvent(LET_EXIT, ln.getEnd(), ln));
 	}
-    std::sort(_llEvents.begin(), _llEvents.end());
+	std::sort(_vecEvents.begin(), _vecEvents.end());
 }
 
 #ifdef ST_TRACE
@@ -128,8 +184,12 @@ EventStack::pushLines(const vector<Line>& vecLines)
 void
 EventStack::traceStack() const
 {
-	LOGTRACE((LLTRACE, "EventStack contains %ld events", _llEvents.size()));
-	for (deque<LineEvent>::const_iterator it = _llEvents.begin(); it != _llEvents.end(); ++it)
+	LOGTRACE((LLTRACE, "EventStack contains %ld events and %ld swaps (in heap order)", (_vecEvents.size()-_iEvent), _vecSwaps.size()));
+	for (vector<LineEvent>::const_iterator it = _vecEvents.begin()+_iEvent; it != _vecEvents.end(); ++it)
+	{
+		LOGTRACE((LLTRACE, (*it).toString().c_str()));
+	}
+	for (vector<LineEvent>::const_iterator it = _vecSwaps.begin(); it != _vecSwaps.end(); ++it)
 	{
 		LOGTRACE((LLTRACE, (*it).toString().c_str()));
 	}
@@ -143,55 +203,108 @@ EventStack::traceStack() const
 bool
 EventStack::validate() const
 {
-    if( _llEvents.empty() ) return true;
-	deque<LineEvent>::const_iterator itFirst = _llEvents.begin();
-	deque<LineEvent>::const_iterator itSecond = ++itFirst;
-	while (itSecond != _llEvents.end())
+	if (	!std::is_sorted(_vecEvents.begin(), _vecEvents.end())
+		||	!std::is_heap(_vecSwaps.begin(), _vecSwaps.end(), std::greater<LineEvent>()))
 	{
-		if ((*itFirst) > (*itSecond))
-		{
-			LOGTRACE((LLTRACE, "%s event precedes %s in trial %lu, attempt %lu",
-								(*itFirst).toString().c_str(), (*itSecond).toString().c_str(), Genome::getTrial(), Genome::getTrialAttempts()));
-			return false;
-		}
-		itFirst = itSecond;
-		++itSecond;
+		LOGTRACE((LLTRACE, "Events are misordered in trial %lu, attempt %lu", Genome::getTrial(), Genome::getTrialAttempts()));
+		return false;
 	}
 	
 	return true;
 }
+#endif
+
+//--------------------------------------------------------------------------------
+//
+// LineStack
+//
+//--------------------------------------------------------------------------------
 
 /*
- * Function: validateSwap
- * 
- * Check for exit events occuring before the passed swap event
+ * Function: findAt
+ *
+ * Lines are ordered by descending y-value at the sweep position, so those
+ * passing through the point form a single run found by binary search.
  */
+size_t
+LineStack::findAt(const Point& pt, size_t& cLines) const
+{
+	size_t iLow = 0;
+	size_t iHigh = _ll.size();
+	while (iLow < iHigh)
+	{
+		size_t iMid = (iLow + iHigh) / 2;
+		if (Unit(yAt(*_ll[iMid], pt)) > pt.y())
+			iLow = iMid + 1;
+		else
+			iHigh = iMid;
+	}
 
-bool
-EventStack::validateSwap(const LineEvent& leSwap) const
+	for (cLines=0; iLow+cLines < _ll.size() && isSame(yAt(*_ll[iLow+cLines], pt), pt.y()); ++cLines);
+	return iLow;
+}
+
+/*
+ * Function: insertAt
+ *
+ */
+void
+LineStack::insertAt(const Line& ln, const Point& pt)
 {
-	deque<LineEvent>::const_iterator itSwap = _llEvents.begin();
-	for (; itSwap != _llEvents.end() && !((*itSwap) == leSwap); ++itSwap);
-	for (deque<LineEvent>::const_iterator it = _llEvents.begin(); it != itSwap; ++it)
+	size_t iLow = 0;
+	size_t iHigh = _ll.size();
+	while (iLow < iHigh)
 	{
-		const LineEvent& le = *it;
-		if (	le.getLine().getID() == leSwap.getLine().getID()
-			&&	le.getType() == LET_EXIT)
-		{
-			LOGTRACE((LLTRACE, "%s event precedes %s in trial %lu, attempt %lu",
-								le.toString().c_str(), leSwap.toString().c_str(), Genome::getTrial(), Genome::getTrialAttempts()));
-			return false;
-		}
+		size_t iMid = (iLow + iHigh) / 2;
+		if (compareAt(*_ll[iMid], ln, pt) > 0)
+			iLow = iMid + 1;
+		else
+			iHigh = iMid;
 	}
-	return true;
+	_ll.insert(_ll.begin()+iLow, &ln);
 }
-#endif
 
-//--------------------------------------------------------------------------------
-//
-// LineStack
-//
-//--------------------------------------------------------------------------------
+/*
+ * Function: compareAt
+ *
+ * Return 1 if the first line lies above the second at the sweep position,
+ * -1 if it lies below, and 0 if they are the same line. Lines meeting at the
+ * sweep position are ordered as they will lie just beyond it: by descending
+ * slope with vertical lines (which continue downward) last. Collinear lines
+ * never cross, so they keep a fixed (ID) order.
+ */
+int
+LineStack::compareAt(const Line& ln1, const Line& ln2, const Point& pt)
+{
+	if (&ln1 == &ln2)
+		return 0;
+
+	Unit y1 = yAt(ln1, pt);
+	UNIT y2 = yAt(ln2, pt);
+	if (y1 > y2)
+		return 1;
+	if (y1 < y2)
+		return -1;
+
+	bool fVertical1 = !ln1.getSlope().isDefined();
+	bool fVertical2 = !ln2.getSlope().isDefined();
+	if (fVertical1 != fVertical2)
+		return (fVertical1 ? -1 : 1);
+
+	if (!fVertical1)
+	{
+		if (ln1.getSlope() > ln2.getSlope())
+			return 1;
+		if (ln1.getSlope() < ln2.getSlope())
+			return -1;
+	}
+
+	return (ln1.getID() < ln2.getID()
+			? 1
+			: (ln1.getID() > ln2.getID()
+			   ? -1
+			   : 0));
+}
 
 #ifdef ST_TRACE
 /*
@@ -202,9 +315,7 @@ void
 LineStack::traceStack() const
 {
 	LOGTRACE((LLTRACE, "LineStack contains %ld lines", _ll.size()));
-	for (vector<const Line*>::iterator it = (const_cast<LineStack*>(this))->_ll.begin();
-		 it != (const_cast<LineStack*>(this))->_ll.end();
-		 ++it)
+	for (vector<const Line*>::const_iterator it = _ll.begin(); it != _ll.end(); ++it)
 	{
 		LOGTRACE((LLTRACE, (*it)->toString().c_str()));
 	}
@@ -222,18 +333,25 @@ LineStack::traceStack() const
  *
  * This routine first determines what strokes might intersect by finding those
  * whose bounding rectangles intersect. Then, it builds one line for each vector
- * from those strokes whose start and/or end point is contained within one or
- * more of the intersecting rectangles. This routine includes the vectors from
- * incoherent regions within a stroke (i.e., dropouts).
+ * from those strokes and bins the lines into a uniform grid. Only lines sharing
+ * a grid cell with a line from another stroke can intersect; these become the
+ * candidate line pairs and all other lines are discarded. This routine includes
+ * the vectors from incoherent regions within a stroke (i.e., dropouts).
  *
  * NOTES:
  * - Point values are those *after* applying the vector; the point associated
- *   with the start acid (i.e., _vecPoints[0]) is where the gene begins.
+ *   with the start acid (i.e., _vecX[0] and _vecY[0]) is where the gene begins.
  * - Use vector indexes as the line IDs.
- * - An STL bitset is used to flag those strokes that may intersect with another;
- *   sadly, this container requires a constant size at compile time. The routine
- *   assumes (and asserts) a large value (larger than the number of strokes in
- *   any known Han glyph).
+ * - Only selected stroke pairs may intersect; since stroke bounds include the
+ *   point preceding the stroke, every vector of one stroke that crosses another
+ *   lies within the bounds of both.
+ * - Grid cells are as wide and tall as the longest vector, so each line falls
+ *   into at most two cells along each axis. Intersecting lines share the cell
+ *   holding their intersection point; line bounds are widened by the error
+ *   margin (twice over, covering diagonal slopes) so that intersections found
+ *   within that tolerance also share a cell.
+ * - Lines sharing more than one cell are paired only within the first cell
+ *   (lowest column and row) they share.
  */
 void
 Overlaps::buildStrokeLines()
@@ -241,138 +359,220 @@ Overlaps::buildStrokeLines()
 	ENTER(VALIDATION,buildStrokeLines);
 
 	ASSERT(_vecLines.empty());
-	ASSERT(_vecStrokes.size() <= 100);
-
-	// First, find all intersecting regions between all stroke pairs
-	// - The actual region is expanded on all sides by the length of one long vector so
-	//   that intersecting vectors may be detected via point containment (rather than 
-	//   having to evaluate if the vector would overlap the rectangle in anyway)
-	bitset<100> grfStrokes;
-	vector<Rectangle> vecIntersects;
+	ASSERT(_vecLinePairs.empty());
+
+	// First, find all strokes whose bounds intersect those of another (selected) stroke
+	vector<bool> vecStrokes(_vecStrokes.size(), false);
+	bool fIntersects = false;
 	for (size_t iStroke1=0; iStroke1 < (_vecStrokes.size()-1); ++iStroke1)
 	{
 		const Rectangle& rStroke1 = _vecStrokes[iStroke1].getBounds();
 
 		for (size_t iStroke2=iStroke1+1; iStroke2 < _vecStrokes.size(); ++iStroke2)
 		{
+			if (!isPairSelected(iStroke1, iStroke2))
+				continue;
+
 			Rectangle rIntersect = rStroke1.intersect(_vecStrokes[iStroke2].getBounds());
 			if (!rIntersect.isEmpty())
 			{
-				grfStrokes.set(iStroke1);
-				grfStrokes.set(iStroke2);
+				vecStrokes[iStroke1] = true;
+				vecStrokes[iStroke2] = true;
+				fIntersects = true;
 
 				TDATA(VALIDATION,L4,(LLTRACE, "Strokes %ld and %ld may intersect within %s", (iStroke1+1), (iStroke2+1), rIntersect.toString().c_str()));
-
-				rIntersect.expand(Constants::s_nVECTOR_LONG, -Constants::s_nVECTOR_LONG, -Constants::s_nVECTOR_LONG, Constants::s_nVECTOR_LONG);
-				vecIntersects.push_back(rIntersect);
 			}
 		}
 	}
+	if (!fIntersects)
+		return;
 
-	// Then, create lines for each vector within each intersecting region
-	// - A vector lies within an intersection region if one or both of its
-	//   end-points lie within the region (since all intersection regions
-	//   were expanded by the length of the longest possible vector, checks
-	//   for point containment are sufficient)
+	// Then, create lines for each vector of those strokes
 	// - The first vector of a stroke is bounded by the point immediately
-	//   before and that associated with the first vector; the check needs
-	//   to begin at the acid/point just before where the stroke starts
-	// Note:
-	// - The inner loops could be enhanced by only evaluating stroke vectors
-	//   against intersection regions involving those strokes; that information
-	//   is not presently kept, so the loops evaluate vectors against all regions
-	if (!vecIntersects.empty())
+	//   before and that associated with the first vector
+	vector<Line> vecLines;
+	UNIT xLeft = numeric_limits<UNIT>::max();
+	UNIT yBottom = numeric_limits<UNIT>::max();
+	UNIT yTop = -numeric_limits<UNIT>::max();
+	for (size_t iStroke=0; iStroke < _vecStrokes.size(); ++iStroke)
+	{
+		if (!vecStrokes[iStroke])
+			continue;
+
+		const Stroke& st = _vecStrokes[iStroke];
+		const Rectangle& rStroke = st.getBounds();
+		xLeft = min<UNIT>(xLeft, rStroke.getTopLeft().x());
+		yBottom = min<UNIT>(yBottom, rStroke.getBottomRight().y());
+		yTop = max<UNIT>(yTop, rStroke.getTopLeft().y());
+
+		for (long iAcid=st.getStart(); iAcid <= st.getEnd(); ++iAcid)
+			vecLines.push_back(Line(Point(_vecX[iAcid-1], _vecY[iAcid-1]), Point(_vecX[iAcid], _vecY[iAcid]), iAcid, iStroke, true));
+	}
+
+	// Bin the lines into the grid cells covered by their (widened) bounds
+	// - Cells are numbered by column and then row, starting from the lower-left corner
+	//   of the stroke bounds
+	const UNIT nCell = Constants::s_nVECTOR_LONG;
+	const UNIT nMargin = 2 * Constants::s_nERROR_MARGIN;
+	xLeft -= 2 * nMargin;
+	yBottom -= 2 * nMargin;
+	const size_t cRows = static_cast<size_t>((yTop - yBottom + 2 * nMargin) / nCell) + 1;
+
+	vector<size_t> vecFirstCells(vecLines.size());
+	NUMERICPAIRARRAY vecCells;
+	vecCells.reserve(vecLines.size() * 2);
+	for (size_t iLine=0; iLine < vecLines.size(); ++iLine)
 	{
-		for (size_t iStroke=0; iStroke < _vecStrokes.size(); ++iStroke)
+		const Line& ln = vecLines[iLine];
+		UNIT yLow = min<UNIT>(ln.getStart().y(), ln.getEnd().y());
+		UNIT yHigh = max<UNIT>(ln.getStart().y(), ln.getEnd().y());
+		size_t iColFirst = static_cast<size_t>((ln.getStart().x() - nMargin - xLeft) / nCell);
+		size_t iColLast = static_cast<size_t>((ln.getEnd().x() + nMargin - xLeft) / nCell);
+		size_t iRowFirst = static_cast<size_t>((yLow - nMargin - yBottom) / nCell);
+		size_t iRowLast = static_cast<size_t>((yHigh + nMargin - yBottom) / nCell);
+
+		vecFirstCells[iLine] = (iColFirst * cRows) + iRowFirst;
+		for (size_t iCol=iColFirst; iCol <= iColLast; ++iCol)
 		{
-			// Only consider vectors from strokes that may have intersected with another
-			if (!grfStrokes.test(iStroke))
-				continue;
+			for (size_t iRow=iRowFirst; iRow <= iRowLast; ++iRow)
+				vecCells.push_back(NUMERICPAIR((iCol * cRows) + iRow, iLine));
+		}
+	}
+	sort(vecCells.begin(), vecCells.end());
+
+	// Pair lines of different strokes sharing a cell
+	// - The first cell two lines share lies at the greater of their first columns and rows
+	// - Lines within a cell are in build order, so pairs are as well
+	NUMERICPAIRARRAY vecLinePairs;
+	vector<bool> vecPaired(vecLines.size(), false);
+	for (size_t iCellStart=0, iCellEnd=0; iCellStart < vecCells.size(); iCellStart=iCellEnd)
+	{
+		size_t iCell = vecCells[iCellStart].first;
+		for (iCellEnd=iCellStart+1; iCellEnd < vecCells.size() && vecCells[iCellEnd].first == iCell; ++iCellEnd)
+			;
 
-			// Create lines for each vector whose start/end point are within an intersection region
-			const Stroke& st = _vecStrokes[iStroke];
-			long iAcid = st.getStart();
-			for (size_t iIntersect=0; iIntersect < vecIntersects.size(); ++iIntersect)
-			{
-				if (vecIntersects[iIntersect].contains(_vecPoints[iAcid-1]))
-				{
-					_vecLines.push_back(Line(_vecPoints[iAcid-1], _vecPoints[iAcid], iAcid, iStroke, true));
-					++iAcid;
-					break;
-				}
-			}
+		for (size_t i1=iCellStart; i1 < iCellEnd; ++i1)
+		{
+			size_t iLine1 = vecCells[i1].second;
+			size_t iFirstCell1 = vecFirstCells[iLine1];
 
-			for (; iAcid <= st.getEnd(); ++iAcid)
+			for (size_t i2=i1+1; i2 < iCellEnd; ++i2)
 			{
-				for (size_t iIntersect=0; iIntersect < vecIntersects.size(); ++iIntersect)
-				{
-					if (vecIntersects[iIntersect].contains(_vecPoints[iAcid]))
-					{
-						_vecLines.push_back(Line(_vecPoints[iAcid-1], _vecPoints[iAcid], iAcid, iStroke, true));
-						break;
-					}
-				}
+				size_t iLine2 = vecCells[i2].second;
+				size_t iFirstCell2 = vecFirstCells[iLine2];
+
+				if (	vecLines[iLine1].getOwnerID() == vecLines[iLine2].getOwnerID()
+					||	!isPairSelected(vecLines[iLine1].getOwnerID(), vecLines[iLine2].getOwnerID())
+					||	iCell != (	(max(iFirstCell1 / cRows, iFirstCell2 / cRows) * cRows)
+								+	max(iFirstCell1 % cRows, iFirstCell2 % cRows)))
+					continue;
+
+				vecLinePairs.push_back(NUMERICPAIR(iLine1, iLine2));
+				vecPaired[iLine1] = true;
+				vecPaired[iLine2] = true;
 			}
 		}
 	}
+
+	// Finally, keep only the paired lines (preserving build order)
+	// - Lines are copy-constructed since assignment does not preserve the line ID
+	vector<size_t> vecIndexes(vecLines.size());
+	for (size_t iLine=0; iLine < vecLines.size(); ++iLine)
+	{
+		if (!vecPaired[iLine])
+			continue;
+
+		vecIndexes[iLine] = _vecLines.size();
+		_vecLines.push_back(vecLines[iLine]);
+	}
+
+	_vecLinePairs.reserve(vecLinePairs.size());
+	for (size_t iPair=0; iPair < vecLinePairs.size(); ++iPair)
+		_vecLinePairs.push_back(NUMERICPAIR(vecIndexes[vecLinePairs[iPair].first], vecIndexes[vecLinePairs[iPair].second]));
+	sort(_vecLinePairs.begin(), _vecLinePairs.end());
 	
-	TDATA(VALIDATION,L4,(LLTRACE, "Intersection evaluation will involve %ld vectors/lines", _vecLines.size()));
+	TDATA(VALIDATION,L4,(LLTRACE, "Intersection evaluation will involve %ld vectors/lines and %ld line pairs", _vecLines.size(), _vecLinePairs.size()));
 	TRACEDOIF(VALIDATION,DATA,L4,traceStrokeLines());
 }
 
+/*
+ * Function: intersects
+ *
+ * Determine where the crossing lines now intersect, building them from the
+ * passed points just as overlap detection does (so that both yield binary
+ * equal intersection points).
+ */
+bool
+Overlaps::intersects(const UNITARRAY& vecX, const UNITARRAY& vecY, const LineCrossing& lc, Point& ptIntersection)
+{
+	long iAcid1 = lc.getFirstAcid();
+	long iAcid2 = lc.getSecondAcid();
+	Line ln1(Point(vecX[iAcid1-1], vecY[iAcid1-1]), Point(vecX[iAcid1], vecY[iAcid1]), iAcid1, lc.getFirstStroke(), true);
+	Line ln2(Point(vecX[iAcid2-1], vecY[iAcid2-1]), Point(vecX[iAcid2], vecY[iAcid2]), iAcid2, lc.getSecondStroke(), true);
+	return ln1.intersects(ln2, ptIntersection);
+}
+
 /*
  * Function: checkIntersection
  *
+ * Record the overlap, if any, between lines of different strokes and schedule
+ * a SWAP event where the lines cross beyond the sweep position.
+ *
  * NOTE:
  * - A tempting 'optimization' is to only check for intersections between lines belonging to
  *   different strokes (since that is the end goal). However, this 'optimization' fails
  *   because lines from the *same* stroke may hide lines from other strokes in the stack
  *   of lines. Therefore, all lines must be compared, causing SWAP events to induce the
  *   necessary position changes in the stack of active lines.
+ * - Lines are compared in the order they were built (as compareLines does) so that
+ *   both produce the same (binary equal) intersection points.
+ * - Crossings at the end-points of either line need no SWAP event; the ENTER or
+ *   EXIT event at that point reorders all lines passing through it.
  */
 void
-Overlaps::checkIntersection(const Line& lnAbove, const Line& lnBelow, const Point& pt)
+Overlaps::checkIntersection(const Line& ln1, const Line& ln2, const Point& pt)
 {
+	const Line& lnFirst = (&ln1 < &ln2 ? ln1 : ln2);
+	const Line& lnSecond = (&ln1 < &ln2 ? ln2 : ln1);
+
+	// Lines whose y-ranges lie apart cannot intersect
+	if (	Unit(max<UNIT>(ln1.getStart().y(), ln1.getEnd().y())) < min<UNIT>(ln2.getStart().y(), ln2.getEnd().y())
+		||	Unit(max<UNIT>(ln2.getStart().y(), ln2.getEnd().y())) < min<UNIT>(ln1.getStart().y(), ln1.getEnd().y()))
+		return;
+
 	Point ptIntersection;
-	if (lnAbove.intersectsAt(lnBelow, pt.x(), ptIntersection))
+	if (!lnFirst.intersects(lnSecond, ptIntersection))
+		return;
+
+	TDATA(VALIDATION,L5,(LLTRACE,
+						 "Line %ld and %ld intersect at x/y%s",
+						 lnFirst.getID(), lnSecond.getID(), ptIntersection.toString().c_str()));
+
+	if (	lnFirst.getOwnerID() != lnSecond.getOwnerID()
+		&&	isPairSelected(lnFirst.getOwnerID(), lnSecond.getOwnerID())
+		&&	_setOverlaps.insert(STROKEOVERLAP(lnFirst.getOwnerID(), lnSecond.getOwnerID(), ptIntersection)).second)
+		_vecCrossings.push_back(LineCrossing(lnFirst.getOwnerID(), lnSecond.getOwnerID(), lnFirst.getID(), lnSecond.getID()));
+
+	if (	(	ptIntersection.x() > pt.x()
+			||	(	ptIntersection.x() == pt.x()
+				&&	ptIntersection.y() < pt.y()))
+		&&	ptIntersection != lnFirst.getStart()
+		&&	ptIntersection != lnFirst.getEnd()
+		&&	ptIntersection != lnSecond.getStart()
+		&&	ptIntersection != lnSecond.getEnd())
 	{
-		TDATA(VALIDATION,L5,(LLTRACE,
-							 "Line %ld and %ld intersect at x/y%s",
-							 lnAbove.getID(), lnBelow.getID(), ptIntersection.toString().c_str()));
 		pair<LINEOVERLAPS::iterator,bool> pairResult =
-			_setLineOverlaps.insert(lnAbove <= lnBelow
-									? LINEOVERLAP(lnAbove, lnBelow, ptIntersection)
-									: LINEOVERLAP(lnBelow, lnAbove, ptIntersection));
+			_setLineOverlaps.insert(lnFirst <= lnSecond
+									? LINEOVERLAP(lnFirst, lnSecond, ptIntersection)
+									: LINEOVERLAP(lnSecond, lnFirst, ptIntersection));
 		if (pairResult.second)
-		{
-            std::cout << "I" << lnAbove.getID() << ","<< lnBelow.getID() << "," << ptIntersection.toString() << std::endl;
-			LineEvent le(LET_SWAP, ptIntersection, lnAbove);
-			_events.push(le);
-
-			IFDEBUG(_events.validateSwap(le));
-		}
+			_events.push(LineEvent(LET_SWAP, ptIntersection, lnFirst));
 	}
 }
 
 /*
  * Function: ensureOverlaps
  *
- * Overlaps between strokes are found using a left-to-right line sweep
- * algorithm. As lines enter and exit scope, pairs of lines (those above
- * and beneath) are checked for intersection. Intersecting lines also
- * induce a scope change with the lines trading places along the y-axis at
- * the point of intersection; at these scope events, pairs of lines are also
- * discovered and checked for intersection.
- *
- * The routine works by executing an event stack: Each event marks when a line
- * starts, ends, or intersects with another line. At each event, line pairs
- * (each line with its immediate neighbors along the y-axis) are compared for
- * intersections. If an intersection does occur, an event for it is added to
- * the event stack. Events are stacked by increasing x-coordinate (thus, the
- * scan sweeps left-to-right). The event stack is initialized with the list of
- * all line start/stop events. The line stack (which lists all active lines)
- * is ordered by the y-coordinate of the lines at the given x-coordinate (with
- * line events inducing changes in that order).
  */
 void
 Overlaps::ensureOverlaps()
@@ -387,16 +587,157 @@ Overlaps::ensureOverlaps()
 	if (_vecLines.empty())
 		return;
 
-    for (auto iter = _vecLines.begin(); iter != _vecLines.end(); iter++) {
-        for (auto iter2 = iter+1; iter2 != _vecLines.end(); iter2++) {
-            if (iter->getOwnerID() != iter2->getOwnerID()) {
-                Point ptIntersection;
-                if (iter->intersects(*iter2, ptIntersection)) {
-                    _setOverlaps.insert(STROKEOVERLAP(iter->getOwnerID(), iter2->getOwnerID(), ptIntersection));
-                }
-            }
-        }
-    }
+	// Then, find the overlaps among those lines
+	// - Comparing candidate pairs is cheaper than sweeping unless the lines crowd
+	//   into a few cells (yielding many pairs per line)
+	// - Debug builds always sweep and compare the outcome with that of comparing pairs
+#if defined(ST_OVERLAPS_BRUTEFORCE)
+	compareLines(_setOverlaps, _vecCrossings);
+#elif defined(ST_DEBUG)
+	sweepLines();
+
+	STROKEOVERLAPS setCompared;
+	LINECROSSINGARRAY vecCompared;
+	compareLines(setCompared, vecCompared);
+	ASSERT(isSameOverlaps(_setOverlaps, setCompared));
+#else
+	if (_vecLinePairs.size() < (_vecLines.size() * Constants::s_cminSWEEPPAIRSPERLINE))
+		compareLines(_setOverlaps, _vecCrossings);
+	else
+		sweepLines();
+#endif
+
+	TRACEDOIF(VALIDATION,DATA,L4,traceLineOverlaps());
+}
+
+/*
+ * Function: compareLines
+ *
+ * Find overlaps by comparing each candidate pair of lines.
+ */
+void
+Overlaps::compareLines(STROKEOVERLAPS& setOverlaps, LINECROSSINGARRAY& vecCrossings) const
+{
+	ENTER(VALIDATION,compareLines);
+
+	for (size_t iPair=0; iPair < _vecLinePairs.size(); ++iPair)
+	{
+		const Line& ln1 = _vecLines[_vecLinePairs[iPair].first];
+		const Line& ln2 = _vecLines[_vecLinePairs[iPair].second];
+
+		Point ptIntersection;
+		if (	ln1.intersects(ln2, ptIntersection)
+			&&	setOverlaps.insert(STROKEOVERLAP(ln1.getOwnerID(), ln2.getOwnerID(), ptIntersection)).second)
+			vecCrossings.push_back(LineCrossing(ln1.getOwnerID(), ln2.getOwnerID(), ln1.getID(), ln2.getID()));
+	}
+}
+
+/*
+ * Function: sweepLines
+ *
+ * Overlaps between strokes are found using a left-to-right line sweep
+ * (Bentley-Ottmann). As lines enter and exit scope, pairs of lines (those
+ * above and beneath) are checked for intersection. Intersecting lines also
+ * induce a scope change with the lines trading places along the y-axis at
+ * the point of intersection; at these scope events, pairs of lines are also
+ * discovered and checked for intersection.
+ *
+ * The routine works by executing an event stack: Each event marks when a line
+ * starts, ends, or crosses another line. All events at the same point are
+ * handled together: Every pair of lines meeting at the point (those entering,
+ * exiting, or passing through it) is compared, the lines continuing beyond the
+ * point are reordered, and the outermost of them are compared with their new
+ * neighbors. Events are stacked by increasing x-coordinate (thus, the scan
+ * sweeps left-to-right) and then by decreasing y-coordinate. The line stack
+ * (which lists all active lines) is ordered by the y-coordinate of the lines
+ * at the sweep position.
+ *
+ * This handles the degenerate cases common to stroke vectors: Many lines
+ * sharing an end-point, collinear lines (which share a run of the stack
+ * without crossing), and vertical lines.
+ */
+void
+Overlaps::sweepLines()
+{
+	ENTER(VALIDATION,sweepLines);
+
+	LineStack lines;
+	vector<const Line*> vecMeeting;
+	vector<const Line*> vecExiting;
+
+	_events.pushLines(_vecLines);
+	while (!_events.isEmpty())
+	{
+		// Gather the events at the next point
+		// - Exiting lines are normally found on the stack along with those passing through
+		//   the point; they are noted in case rounding placed them elsewhere
+		// - The first event is always taken so that progress does not rest on the error
+		//   margin, which is zero outside of imprecise mode
+		const Point pt(_events.peek().getPoint());
+
+		vecMeeting.clear();
+		vecExiting.clear();
+		do
+		{
+			const LineEvent le(_events.pop());
+			if (le.getType() == LET_ENTER)
+				vecMeeting.push_back(&le.getLine());
+			else if (le.getType() == LET_EXIT)
+				vecExiting.push_back(&le.getLine());
+		}
+		while (!_events.isEmpty() && isSamePoint(_events.peek().getPoint(), pt));
+		size_t cEntering = vecMeeting.size();
+
+		// Remove all active lines passing through the point
+		size_t cLines;
+		size_t iLine = lines.findAt(pt, cLines);
+		for (size_t i=0; i < cLines; ++i)
+			vecMeeting.push_back(lines.getAt(iLine+i));
+		lines.erase(iLine, cLines);
+
+		for (size_t i=0; i < vecExiting.size(); ++i)
+		{
+			if (find(vecMeeting.begin()+cEntering, vecMeeting.end(), vecExiting[i]) == vecMeeting.end())
+			{
+				lines.remove(*vecExiting[i]);
+				vecMeeting.push_back(vecExiting[i]);
+			}
+		}
+
+		// Compare all lines meeting at the point
+		for (size_t i=0; i < vecMeeting.size(); ++i)
+		{
+			for (size_t j=i+1; j < vecMeeting.size(); ++j)
+			{
+				if (vecMeeting[i]->getOwnerID() != vecMeeting[j]->getOwnerID())
+					checkIntersection(*vecMeeting[i], *vecMeeting[j], pt);
+			}
+		}
+
+		// Restore the lines continuing beyond the point (including those entering) in
+		// their new order and compare the outermost with their new neighbors
+		for (size_t i=0; i < vecMeeting.size(); ++i)
+		{
+			if (!isSamePoint(vecMeeting[i]->getEnd(), pt))
+				lines.insertAt(*vecMeeting[i], pt);
+		}
+
+		iLine = lines.findAt(pt, cLines);
+
+		const Line* plnAbove = lines.getAt(static_cast<long>(iLine)-1);
+		const Line* plnBelow = lines.getAt(iLine+cLines);
+		if (cLines)
+		{
+			if (plnAbove)
+				checkIntersection(*plnAbove, *lines.getAt(iLine), pt);
+			if (plnBelow)
+				checkIntersection(*lines.getAt(iLine+cLines-1), *plnBelow, pt);
+		}
+		else if (plnAbove && plnBelow)
+			checkIntersection(*plnAbove, *plnBelow, pt);
+	}
+
+	TDATA(VALIDATION,L4,(LLTRACE, "Line sweep found %ld line crossings", _setLineOverlaps.size()));
 }	
 
 #ifdef ST_TRACE
@@ -4,6 +4,11 @@
  *
  * Overlaps encapsulates stroke overlap detection.
  *
+ * Overlaps are found with a left-to-right line sweep (or, for few lines, by
+ * comparing every pair of lines). Defining ST_OVERLAPS_BRUTEFORCE always
+ * compares every pair; debug builds always sweep and verify the outcome by
+ * comparing every pair.
+ *
  * Stylus, Copyright 2006-2009 Biologic Institute
  * 
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -28,14 +33,14 @@ namespace org_biologicinstitute_stylus
 	 * \brief LineEvent types
 	 *
 	 * \remarks
-	 * - The event order is \em critical; LineEvent::compare relies on the events
-	 *   having the following ascending order
-	 * - SWAP events move lines down toward smaller y-values
+	 * - Events at the same point are ordered ENTER before SWAP before EXIT;
+	 *   LineEvent::compare relies on the events having this ascending order
+	 * - SWAP events mark where two lines cross, reversing their y-order
 	 */
 	enum LINEEVENTTYPE
 	{
 		LET_ENTER = 1,							///< A line is entering scope
-		LET_SWAP,								///< A line is moving down in y-order
+		LET_SWAP,								///< A line is crossing another
 		LET_EXIT								///< A line is exiting scope
 	};
 
@@ -78,7 +83,9 @@ namespace org_biologicinstitute_stylus
 	 * \brief EventStack class
 	 *
 	 * The EventStack is used by the overlap detection code to hold and manage
-	 * all events line events.
+	 * all line events. The ENTER and EXIT events of all lines are sorted once
+	 * into a flat buffer and consumed in order; SWAP events, discovered during
+	 * the sweep, are kept in a (much smaller) binary heap.
 	 */
 	class EventStack
 	{
@@ -87,6 +94,7 @@ namespace org_biologicinstitute_stylus
 
 		void pushLines(const std::vector<Line>& vecLines);
 		void push(const LineEvent& le);
+		const LineEvent& peek() const;
 		const LineEvent pop();
 
 		bool isEmpty() const;
@@ -94,55 +102,52 @@ namespace org_biologicinstitute_stylus
 #ifdef ST_TRACE
 		void traceStack() const;
 		bool validate() const;
-		bool validateSwap(const LineEvent& le) const;
 #endif
 
 	private:
-		std::deque<LineEvent> _llEvents;
+		std::vector<LineEvent> _vecEvents;		///< Sorted ENTER and EXIT events
+		size_t _iEvent;							///< Next ENTER or EXIT event
+		std::vector<LineEvent> _vecSwaps;		///< Pending SWAP events (as a heap)
+
+		bool isSwapNext() const;
 	};
 
 	/**
 	 * \brief LineStack class
 	 *
-	 * A LineStack is a 'stack' of lines ordered by their y-coordinate (at a given
-	 * x-coordinate). It is a helper structure, much like LineEvent above, used
-	 * during overlap detection.
+	 * A LineStack is a 'stack' of lines ordered by their y-coordinate at the
+	 * current event point (the sweep position). It is a helper structure, much
+	 * like LineEvent above, used during overlap detection.
 	 *
 	 * \remarks
-	 * - The stack is kept in descending order of the y-coordinate value for a
-	 *   given x-coordinate
+	 * - The stack is kept in descending order of the y-coordinate value at the
+	 *   sweep position; lines sharing that value are ordered as they will be
+	 *   just beyond it (by descending slope, vertical lines last)
+	 * - The sweep advances by ascending x-coordinate and, at the same
+	 *   x-coordinate, by descending y-coordinate; an active vertical line lies
+	 *   at the sweep position
+	 * - Lines passing through a point are always adjacent within the stack
 	 */
 	class LineStack
 	{
 	public:
 		LineStack();
 
-		/**
-		 * \brief Make the passed line the active line of the stack
-		 *
-		 */
-		void makeActive(const Line& ln);
-
-		/**
-		 * \brief LINEEVENTTYPE handlers
-		 *
-		 */
-		//{@
-		void handleEnter(const Line& ln);
-		void handleSwap();
-		void handleExit();
-		//@}
+		size_t size() const;
+		const Line* getAt(long iLine) const;
 
 		/**
-		 * \brief Obtain neighboring lines
+		 * \brief Locate the lines passing through the passed point
 		 *
 		 * \remarks
-		 * - These routines will return NULL when no neighbor exists
+		 * - Returns the index of the first such line (or where one would be
+		 *   inserted) and sets the number of lines found
 		 */
-		//{@
-		const Line* getAbove();
-		const Line* getBelow();
-		//@}
+		size_t findAt(const Point& pt, size_t& cLines) const;
+
+		void erase(size_t iLine, size_t cLines = 1);
+		void insertAt(const Line& ln, const Point& pt);
+		void remove(const Line& ln);
 
 #ifdef ST_TRACE
 		void traceStack() const;
@@ -150,7 +155,9 @@ namespace org_biologicinstitute_stylus
 
 	private:
 		std::vector<const Line*> _ll;				///< Stack of lines
-		std::vector<const Line*>::iterator _it;	///< Current iterator
+
+		static UNIT yAt(const Line& ln, const Point& pt);
+		static int compareAt(const Line& ln1, const Line& ln2, const Point& pt);
 	};
 
 	/**
@@ -179,34 +186,73 @@ namespace org_biologicinstitute_stylus
 		int compare(const Overlap<Type>& ol) const;
 	};
 
+	/**
+	 * \brief LineCrossing class
+	 *
+	 * Records two intersecting lines of different strokes, each identified by
+	 * its stroke and the acid ending it.
+	 */
+	class LineCrossing
+	{
+	public:
+		LineCrossing(size_t iStroke1, size_t iStroke2, long iAcid1, long iAcid2);
+
+		size_t getFirstStroke() const;
+		size_t getSecondStroke() const;
+		long getFirstAcid() const;
+		long getSecondAcid() const;
+
+		void shift(long dAcid1, long dAcid2);
+
+	private:
+		size_t _iStroke1;						///< Stroke owning the first line
+		size_t _iStroke2;						///< Stroke owning the second line
+		long _iAcid1;							///< Acid ending the first line
+		long _iAcid2;							///< Acid ending the second line
+	};
+
 	/**
 	 * \brief Overlaps class
 	 *
 	 * This object detects and exposes overlaps in the set of passed strokes.
+	 * Callers may restrict detection to selected stroke pairs (e.g., those
+	 * whose overlaps could not be reused from an earlier pass).
 	 */
 	class Overlaps
 	{
 	public:
 		Overlaps(const std::vector<ACIDTYPE>& vecAcids,
-				 const std::vector<Point>& vecPoints,
+				 const UNITARRAY& vecX,
+				 const UNITARRAY& vecY,
 				 const std::vector<Stroke>& vecStrokes);
 
 		const STROKEOVERLAPS& getOverlaps();
+		const STROKEOVERLAPS& getOverlaps(const std::vector<bool>& vecPairs);
+		const LINECROSSINGARRAY& getCrossings() const;
+
+		static bool intersects(const UNITARRAY& vecX, const UNITARRAY& vecY, const LineCrossing& lc, Point& ptIntersection);
 
 	private:
 		const std::vector<ACIDTYPE>& _vecAcids;	///< Acids underlying the strokes
-		const std::vector<Point>& _vecPoints;	///< Points associated with each acid
+		const UNITARRAY& _vecX;					///< Point x-coordinates associated with each acid
+		const UNITARRAY& _vecY;					///< Point y-coordinates associated with each acid
 		const std::vector<Stroke>& _vecStrokes;	///< Strokes to analyze
+		std::vector<bool> _vecPairs;			///< Stroke pairs to analyze (by first * strokes + second, all if empty)
 
 		std::vector<Line> _vecLines;			///< Array of lines from all strokes
+		NUMERICPAIRARRAY _vecLinePairs;			///< Candidate line pairs (as indexes into the line array)
 		LINEOVERLAPS _setLineOverlaps;			///< Set of overlapping lines
 		STROKEOVERLAPS _setOverlaps;			///< Set of overlapping strokes (as indexes into Gene stroke array)
+		LINECROSSINGARRAY _vecCrossings;		///< Intersecting lines yielding the overlapping strokes
 
 		EventStack _events;						///< Active line event stack
 
 		void buildStrokeLines();
-		void checkIntersection(const Line& lnAbove, const Line& lnBelow, const Point& pt);
+		void checkIntersection(const Line& ln1, const Line& ln2, const Point& pt);
 		void ensureOverlaps();
+		void compareLines(STROKEOVERLAPS& setOverlaps, LINECROSSINGARRAY& vecCrossings) const;
+		void sweepLines();
+		bool isPairSelected(size_t iStroke1, size_t iStroke2) const;
 
 #ifdef ST_TRACE
 		void traceStrokeLines() const;
@@ -50,78 +50,68 @@ inline const Line& LineEvent::getLine() const { return *_ln; }
 // EventStack
 //
 //--------------------------------------------------------------------------------
-inline EventStack::EventStack()
+inline EventStack::EventStack() : _iEvent(0) {}
+inline void EventStack::push(const LineEvent& le)
 {
+	_vecSwaps.push_back(le);
+	std::push_heap(_vecSwaps.begin(), _vecSwaps.end(), std::greater<LineEvent>());
 }
-inline void EventStack::push(const LineEvent& le)
+inline const LineEvent& EventStack::peek() const
 {
-    _llEvents.insert( 
-        std::lower_bound(_llEvents.begin(), _llEvents.end(), le),
-        le);
+	DASSERT(!isEmpty());
+	return (isSwapNext()
+			? _vecSwaps.front()
+			: _vecEvents[_iEvent]);
 }
 inline const LineEvent EventStack::pop()
 {
-	const LineEvent le(_llEvents.front());
-	_llEvents.pop_front();
+	DASSERT(!isEmpty());
+	if (!isSwapNext())
+		return _vecEvents[_iEvent++];
+
+	std::pop_heap(_vecSwaps.begin(), _vecSwaps.end(), std::greater<LineEvent>());
+	const LineEvent le(_vecSwaps.back());
+	_vecSwaps.pop_back();
 	return le;
 }
-inline bool EventStack::isEmpty() const { return _llEvents.empty(); }
+inline bool EventStack::isEmpty() const { return (_iEvent >= _vecEvents.size() && _vecSwaps.empty()); }
+inline bool EventStack::isSwapNext() const
+{
+	return (	!_vecSwaps.empty()
+			&&	(	_iEvent >= _vecEvents.size()
+				||	_vecSwaps.front() < _vecEvents[_iEvent]));
+}
 
 //--------------------------------------------------------------------------------
 //
 // LineStack
 //
 //--------------------------------------------------------------------------------
-inline LineStack::LineStack() { _it = _ll.begin(); }
-inline void LineStack::makeActive(const Line& ln)
+inline LineStack::LineStack() {}
+inline size_t LineStack::size() const { return _ll.size(); }
+inline const Line* LineStack::getAt(long iLine) const
 {
-	for(_it = _ll.begin(); _it != _ll.end() && *_it != &ln; ++_it);
-	DASSERT(_it != _ll.end());
+	return (iLine >= 0 && static_cast<size_t>(iLine) < _ll.size()
+			? _ll[iLine]
+			: NULL);
 }
-inline void LineStack::handleEnter(const Line& ln)
+inline void LineStack::erase(size_t iLine, size_t cLines)
 {
-	for (_it = _ll.begin();
-		 _it != _ll.end() && ln.compareAt(*(*_it), ln.getStart().x()) < 0;
-		 ++_it);
-	_it = _ll.insert(_it, &ln);
+	DASSERT(iLine+cLines <= _ll.size());
+	_ll.erase(_ll.begin()+iLine, _ll.begin()+iLine+cLines);
 }
-inline void LineStack::handleSwap()
+inline void LineStack::remove(const Line& ln)
 {
-	DASSERT(_it != _ll.end());
-    std::vector<const Line*>::iterator current = _it;
-    _it++;
-    if(_it != _ll.end())
-        std::swap(*current, *_it);
-    else
-        _it = current;
+	std::vector<const Line*>::iterator it = std::find(_ll.begin(), _ll.end(), &ln);
+	if (it != _ll.end())
+		_ll.erase(it);
 }
-inline void LineStack::handleExit()
+inline UNIT LineStack::yAt(const Line& ln, const Point& pt)
 {
-	DASSERT(_it != _ll.end());
-	_it = _ll.erase(_it);
-}
-inline const Line* LineStack::getAbove()
-{
-	DASSERT(_it != _ll.end());
-	const Line* pln = NULL;
-	if (_it != _ll.begin())
-	{
-		--_it;
-		pln = *_it;
-		++_it;
-	}
-	return pln;
-}
-inline const Line* LineStack::getBelow()
-{
-	DASSERT(_it != _ll.end());
-	const Line* pln;
-	++_it;
-	pln = (_it == _ll.end()
-		   ? NULL
-		   : *_it);
-	--_it;
-	return pln;
+	// Active vertical lines lie at the sweep position
+	if (!ln.getSlope().isDefined())
+		return max<UNIT>(min<UNIT>(pt.y(), ln.getStart().y()), ln.getEnd().y());
+	return ln.yAt(pt.x());
 }
 
 //--------------------------------------------------------------------------------
@@ -159,14 +149,42 @@ template<class Type> inline int Overlap<Type>::compare(const Overlap<Type>& ol)
 						   : 0))))));
 }
 
+//--------------------------------------------------------------------------------
+//
+// LineCrossing
+//
+//--------------------------------------------------------------------------------
+inline LineCrossing::LineCrossing(size_t iStroke1, size_t iStroke2, long iAcid1, long iAcid2) :
+	_iStroke1(iStroke1), _iStroke2(iStroke2), _iAcid1(iAcid1), _iAcid2(iAcid2) {}
+
+inline size_t LineCrossing::getFirstStroke() const { return _iStroke1; }
+inline size_t LineCrossing::getSecondStroke() const { return _iStroke2; }
+inline long LineCrossing::getFirstAcid() const { return _iAcid1; }
+inline long LineCrossing::getSecondAcid() const { return _iAcid2; }
+
+inline void LineCrossing::shift(long dAcid1, long dAcid2) { _iAcid1 += dAcid1; _iAcid2 += dAcid2; }
+
 //--------------------------------------------------------------------------------
 //
 // Overlaps
 //
 //--------------------------------------------------------------------------------
 inline Overlaps::Overlaps(const std::vector<ACIDTYPE>& vecAcids,
-						  const std::vector<Point>& vecPoints,
+						  const UNITARRAY& vecX,
+						  const UNITARRAY& vecY,
 						  const std::vector<Stroke>& vecStrokes) :
-	_vecAcids(vecAcids), _vecPoints(vecPoints), _vecStrokes(vecStrokes) {}
+	_vecAcids(vecAcids), _vecX(vecX), _vecY(vecY), _vecStrokes(vecStrokes) {}
 inline const STROKEOVERLAPS& Overlaps::getOverlaps() { ensureOverlaps(); return _setOverlaps; }
+inline const STROKEOVERLAPS& Overlaps::getOverlaps(const std::vector<bool>& vecPairs)
+{
+	_vecPairs = vecPairs;
+	ensureOverlaps();
+	return _setOverlaps;
+}
+inline const LINECROSSINGARRAY& Overlaps::getCrossings() const { return _vecCrossings; }
+inline bool Overlaps::isPairSelected(size_t iStroke1, size_t iStroke2) const
+{
+	DASSERT(iStroke1 < iStroke2);
+	return (_vecPairs.empty() || _vecPairs[(iStroke1 * _vecStrokes.size()) + iStroke2]);
+}
 
@@ -0,0 +1,285 @@
+/*******************************************************************************
+ * \file	philox.cpp
+ * \brief	Stylus Philox classes
+ *
+ * Stylus, Copyright 2006-2009 Biologic Institute
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+// Includes ---------------------------------------------------------------------
+#include "headers.hpp"
+#include "randomc/sha256.h"
+
+using namespace std;
+using namespace stylus;
+
+//--------------------------------------------------------------------------------
+//
+// Helpers
+//
+//--------------------------------------------------------------------------------
+namespace
+{
+	const uint32_t s_nMULTIPLIER0 = 0xD2511F53;
+	const uint32_t s_nMULTIPLIER1 = 0xCD9E8D57;
+	const uint32_t s_nWEYL0 = 0x9E3779B9;
+	const uint32_t s_nWEYL1 = 0xBB67AE85;
+	const size_t s_cROUNDS = 10;
+
+	/*
+	 * Function: getLimit
+	 *
+	 * Return the largest value (of 32 random bits scaled by the interval)
+	 * accepted so that each value of the interval is equally likely.
+	 */
+	inline uint32_t
+	getLimit(uint32_t nInterval)
+	{
+		return static_cast<uint32_t>((static_cast<uint64_t>(1) << 32) / nInterval) * nInterval - 1;
+	}
+}
+
+//--------------------------------------------------------------------------------
+//
+// Philox
+//
+//--------------------------------------------------------------------------------
+const std::string Philox::s_strUUID("5C1E7A52-9B3D-4F0E-A6D8-2B7F31C94E10");
+
+/*
+ * Function: Philox
+ *
+ */
+Philox::Philox()
+{
+	ENTER(GLOBAL,Philox);
+	hashSeed(string());
+}
+
+/*
+ * Function: getUUID
+ *
+ */
+const std::string&
+Philox::getUUID() throw()
+{
+	return s_strUUID;
+}
+
+/*
+ * Function: createStream
+ *
+ * The substream is keyed by hashing the full state of this generator with
+ * the passed name.
+ */
+IRandom*
+Philox::createStream(const std::string& strStream) const
+{
+	ENTER(GLOBAL,createStream);
+
+	Philox* pphilox = ::new Philox();
+	pphilox->hashSeed(getSeed() + strStream);
+	return pphilox;
+}
+
+/*
+ * Function: setSeed
+ *
+ */
+void
+Philox::setSeed(const std::string& strSeed)
+{
+	ENTER(GLOBAL,setSeed);
+	ASSERT(!EMPTYSTR(strSeed));
+
+	bool fState = (strSeed.length() == s_cchSEED);
+	for (size_t ich=0; fState && ich < strSeed.length(); ++ich)
+		fState = (::isxdigit(static_cast<unsigned char>(strSeed[ich])) != 0);
+
+	if (!fState)
+		hashSeed(strSeed);
+
+	else
+	{
+		uint32_t aryWords[s_cKEY + s_cCOUNTER + 1];
+		for (size_t iWord=0; iWord < ARRAY_LENGTH(aryWords); ++iWord)
+			aryWords[iWord] = static_cast<uint32_t>(::strtoul(strSeed.substr(iWord * 8, 8).c_str(), NULL, 16));
+
+		::memcpy(_aryKey, aryWords, sizeof(_aryKey));
+		::memcpy(_aryCounter, aryWords + s_cKEY, sizeof(_aryCounter));
+		_iBlock = aryWords[s_cKEY + s_cCOUNTER];
+		if (_iBlock < s_cCOUNTER)
+			generateBlock();
+		else
+			_iBlock = s_cCOUNTER;
+	}
+}
+
+/*
+ * Function: getSeed
+ *
+ * The seed is the key, counter, and position within the block, each as
+ * eight hexadecimal digits.
+ */
+std::string
+Philox::getSeed() const
+{
+	ENTER(GLOBAL,getSeed);
+
+	char szSeed[s_cchSEED + 1];
+	::sprintf(szSeed, "%08x%08x%08x%08x%08x%08x%08x",
+			  _aryKey[0], _aryKey[1],
+			  _aryCounter[0], _aryCounter[1], _aryCounter[2], _aryCounter[3],
+			  static_cast<uint32_t>(_iBlock));
+	return string(szSeed);
+}
+
+void
+Philox::getSeed(XMLStream& xs, STFLAGS grfRecordDetail) const
+{
+	ENTER(GLOBAL,getSeed);
+	
+	xs.openStart(xmlTag(XT_SEED));
+	xs.writeAttribute(xmlTag(XT_PROCESSORID), s_strUUID);
+	xs.closeStart(true, false);
+	xs.writeContent(getSeed());
+	xs.writeEnd(xmlTag(XT_SEED));
+}
+
+/*
+ * Function: getUniform
+ *
+ * Scaling by multiplication (rather than modulus) with rejection of the
+ * few values that would bias the result (as does RandomC).
+ */
+long
+Philox::getUniform(long nLow, long nHigh)
+{
+	ASSERT(nLow <= nHigh);
+	ASSERT(static_cast<unsigned long>(nHigh - nLow) < numeric_limits<uint32_t>::max());
+
+	uint32_t nInterval = static_cast<uint32_t>(nHigh - nLow + 1);
+	uint32_t nLimit = getLimit(nInterval);
+	uint64_t nScaled;
+	do
+		nScaled = static_cast<uint64_t>(getNext()) * nInterval;
+	while (static_cast<uint32_t>(nScaled) > nLimit);
+	return nLow + static_cast<long>(nScaled >> 32);
+}
+
+/*
+ * Function: getUniform
+ *
+ * Fill the passed array with the same values that as many calls to
+ * getUniform(nLow, nHigh) would return.
+ */
+void
+Philox::getUniform(long nLow, long nHigh, long* aryValues, size_t cValues)
+{
+	ASSERT(nLow <= nHigh);
+	ASSERT(static_cast<unsigned long>(nHigh - nLow) < numeric_limits<uint32_t>::max());
+	ASSERT(VALID(aryValues) || cValues == 0);
+
+	uint32_t nInterval = static_cast<uint32_t>(nHigh - nLow + 1);
+	uint32_t nLimit = getLimit(nInterval);
+	for (size_t iValue=0; iValue < cValues; ++iValue)
+	{
+		uint64_t nScaled;
+		do
+			nScaled = static_cast<uint64_t>(getNext()) * nInterval;
+		while (static_cast<uint32_t>(nScaled) > nLimit);
+		aryValues[iValue] = nLow + static_cast<long>(nScaled >> 32);
+	}
+}
+
+UNIT
+Philox::getUniform()
+{
+	// Combine 53 random bits (the precision of a double)
+	uint64_t nHigh = getNext() >> 5;
+	uint64_t nLow = getNext() >> 6;
+	UNIT value = static_cast<UNIT>((nHigh * 67108864.0 + nLow) * (1.0 / 9007199254740992.0));
+	return (value == 0.0 ? Constants::s_nERROR_MARGIN : value);
+}
+
+/*
+ * Function: getNext
+ *
+ */
+inline uint32_t
+Philox::getNext()
+{
+	if (_iBlock >= s_cCOUNTER)
+	{
+		for (size_t iCounter=0; iCounter < s_cCOUNTER && ++_aryCounter[iCounter] == 0; ++iCounter)
+			;
+		generateBlock();
+		_iBlock = 0;
+	}
+	return _aryBlock[_iBlock++];
+}
+
+/*
+ * Function: generateBlock
+ *
+ * Encrypt the counter to produce the current block.
+ */
+void
+Philox::generateBlock()
+{
+	uint32_t aryKey[s_cKEY] = { _aryKey[0], _aryKey[1] };
+	uint32_t aryBlock[s_cCOUNTER] = { _aryCounter[0], _aryCounter[1], _aryCounter[2], _aryCounter[3] };
+
+	for (size_t iRound=0; iRound < s_cROUNDS; ++iRound)
+	{
+		uint64_t nProduct0 = static_cast<uint64_t>(s_nMULTIPLIER0) * aryBlock[0];
+		uint64_t nProduct1 = static_cast<uint64_t>(s_nMULTIPLIER1) * aryBlock[2];
+
+		aryBlock[0] = static_cast<uint32_t>(nProduct1 >> 32) ^ aryBlock[1] ^ aryKey[0];
+		aryBlock[1] = static_cast<uint32_t>(nProduct1);
+		aryBlock[2] = static_cast<uint32_t>(nProduct0 >> 32) ^ aryBlock[3] ^ aryKey[1];
+		aryBlock[3] = static_cast<uint32_t>(nProduct0);
+
+		aryKey[0] += s_nWEYL0;
+		aryKey[1] += s_nWEYL1;
+	}
+
+	::memcpy(_aryBlock, aryBlock, sizeof(_aryBlock));
+}
+
+/*
+ * Function: hashSeed
+ *
+ * Derive the key and counter from the SHA-256 hash of the passed seed.
+ */
+void
+Philox::hashSeed(const std::string& strSeed)
+{
+	BYTE aryHash[SHA256_BLOCK_SIZE];
+	SHA256_CTX sha256;
+	sha256_init(&sha256);
+	sha256_update(&sha256, reinterpret_cast<const BYTE*>(strSeed.data()), strSeed.size());
+	sha256_final(&sha256, aryHash);
+
+	uint32_t aryWords[SHA256_BLOCK_SIZE / sizeof(uint32_t)];
+	::memcpy(aryWords, aryHash, sizeof(aryWords));
+
+	_aryKey[0] = aryWords[0];
+	_aryKey[1] = aryWords[1];
+	_aryCounter[0] = 0;
+	_aryCounter[1] = 0;
+	_aryCounter[2] = aryWords[2];
+	_aryCounter[3] = aryWords[3];
+	_iBlock = s_cCOUNTER;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * \file    philox.hpp
+ * \brief   Philox implementation classes
+ *
+ * Stylus, Copyright 2006-2009 Biologic Institute
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef PHILOX_HPP
+#define PHILOX_HPP
+
+namespace org_biologicinstitute_stylus
+{
+	/**
+	 * \brief Philox-based implementation of IRandom
+	 *
+	 * Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as
+	 * 1, 2, 3") is a counter-based generator: each block of four numbers is
+	 * the encryption of a 128-bit counter under a 64-bit key. The complete
+	 * state is the key, the counter, and the position within the block, so
+	 * seeds are short and substreams (each under a key of its own) cost
+	 * nothing to create.
+	 *
+	 * \remarks
+	 * - Seeds not produced by getSeed are hashed (SHA-256) into a key and
+	 *   counter
+	 */
+	class Philox : public IRandom
+	{
+		friend class RGenerator;
+
+	private:
+		static const size_t s_cKEY = 2;
+		static const size_t s_cCOUNTER = 4;
+		static const size_t s_cchSEED = (s_cKEY + s_cCOUNTER + 1) * 8;
+
+		uint32_t _aryKey[s_cKEY];				///< Key of the stream
+		uint32_t _aryCounter[s_cCOUNTER];		///< Counter of the current block
+		uint32_t _aryBlock[s_cCOUNTER];			///< Current block
+		size_t _iBlock;							///< Next number in the current block (s_cCOUNTER if none remain)
+
+		Philox();
+
+		uint32_t getNext();
+		void generateBlock();
+		void hashSeed(const std::string& strSeed);
+
+	public:
+		static const std::string s_strUUID;		///< UUID used to request Philox
+
+		inline virtual ~Philox() {};
+
+		/**
+		 * \brief Implementation of IRandom (see IRandom for details)
+		 *
+		 */
+		//{@
+		virtual const std::string& getUUID() throw();
+
+		virtual IRandom* createStream(const std::string& strStream) const;
+
+		virtual void setSeed(const std::string& strSeed);
+		virtual std::string getSeed() const;
+		virtual void getSeed(XMLStream& xs, STFLAGS grfRecordDetail) const;
+
+		virtual long getUniform(long nLow, long nHigh);
+		virtual void getUniform(long nLow, long nHigh, long* aryValues, size_t cValues);
+		virtual UNIT getUniform();
+		//@}
+	};
+
+}	// namespace org_biologicinstitute_stylus
+#endif // PHILOX_HPP
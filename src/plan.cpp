@@ -163,13 +163,13 @@ TrialCondition::evaluate(UNIT nValue, bool fFinal)
 			break;
 
 		case TCM_INCREASE:
-			fSuccess = (Unit(nValue) > tv.getValue());
+			fSuccess = (Unit(nValue) > tv.getValue() || accept(tv.getValue() - nValue, fFinal));
 			if (fSuccess && fFinal)
 				tv.setValue(nValue);
 			break;
 
 		case TCM_DECREASE:
-			fSuccess = (Unit(nValue) < tv.getValue());
+			fSuccess = (Unit(nValue) < tv.getValue() || accept(nValue - tv.getValue(), fFinal));
 			if (fSuccess && fFinal)
 				tv.setValue(nValue);
 			break;
@@ -192,6 +192,35 @@ TrialCondition::evaluate(UNIT nValue, bool fFinal)
 	return fSuccess;
 }
 
+/*
+ * Function: accept
+ *
+ * Decide, by the Metropolis criterion, whether to accept a value worse than
+ * the threshold by the passed amount: the value is accepted with probability
+ * exp(-nWorse / T), where T is the current temperature. The decision is made
+ * once per attempt; the final evaluation takes the decision already made.
+ */
+bool
+TrialCondition::accept(UNIT nWorse, bool fFinal)
+{
+	ENTER(VALIDATION,accept);
+
+	if (!isAnnealing())
+		return false;
+
+	if (fFinal)
+		return (_iAttemptAccepted == Genome::getTrialAttempts());
+
+	UNIT nTemperature = getTemperature();
+	bool fAccepted = (nTemperature > 0.0 && RGenerator::getUniform() < ::exp(-nWorse / nTemperature));
+	if (fAccepted)
+	{
+		_iAttemptAccepted = Genome::getTrialAttempts();
+		TFLOW(PLAN,L2,(LLTRACE, "Accepted %s worse by %0.15f at temperature %0.15f", xmlTag(_xt), nWorse, nTemperature));
+	}
+	return fAccepted;
+}
+
 /*
  * Function: initialize
  * 
@@ -258,6 +287,16 @@ TrialCondition::load(XMLDocument* pxd, xmlNodePtr pxnTrialCondition)
 					? TCM_DECREASE
 					: TCM_NONE)));
 
+	if (pxd->getAttribute(pxnTrialCondition, xmlTag(XT_TEMPERATURE), str))
+		_nTemperature = Unit(str);
+	if (pxd->getAttribute(pxnTrialCondition, xmlTag(XT_COOLING), str))
+		_nCooling = Unit(str);
+
+	if (_tcm != TCM_INCREASE && _tcm != TCM_DECREASE && isAnnealing())
+		THROWRC((RC(XMLERROR), "A temperature is allowed only with increase or decrease mode"));
+	if (_nCooling <= 0.0 || _nCooling > 1.0)
+		THROWRC((RC(XMLERROR), "The cooling factor (%6.4f) is illegal - it must be greater than 0.0 and no more than 1.0", _nCooling));
+
 	// Set the context to the thresholdCondition
 	spxpc->node = pxnTrialCondition;
 	
@@ -299,6 +338,12 @@ TrialCondition::toXML(XMLStream& xs, size_t iGene)
 	if (iGene > 0)
 		xs.writeAttribute(xmlTag(XT_GENE), iGene);
 	xs.writeAttribute(xmlTag(XT_MODE), TrialCondition::s_aryTRIALCONDITIONMODE[_tcm]);
+	if (isAnnealing())
+	{
+		xs.writeAttribute(xmlTag(XT_TEMPERATURE), _nTemperature);
+		if (_nCooling != 1.0)
+			xs.writeAttribute(xmlTag(XT_COOLING), _nCooling);
+	}
 	xs.closeStart();
 	
 	for (size_t iValue=0; iValue < _vecValues.size(); ++iValue)
@@ -956,12 +1001,12 @@ IndexRange::getRange() const
 	Range rg;
 
 	if (_grfSupplied == FS_NONE)
-		rg.set(Codon::s_cchCODON, (Genome::getBases().length() - 1) - Codon::s_cchCODON);
+		rg.set(Codon::s_cchCODON, (Genome::getBaseSequence().length() - 1) - Codon::s_cchCODON);
 	else if (ST_ISALLSET(_grfSupplied, FS_INDEXRANGE))
 	{
 		if (_fPercentageIndex)
 		{
-			size_t cbCodons = (Genome::getBases().length() / Codon::s_cchCODON) - 2;
+			size_t cbCodons = (Genome::getBaseSequence().length() / Codon::s_cchCODON) - 2;
 
 			rg.set((((((cbCodons * _rgIndex.getStart()) + 50) / 100) + 1) * Codon::s_cchCODON),
 				   (((((cbCodons * _rgIndex.getEnd()) + 50) / 100) + 1) * Codon::s_cchCODON) - 1);
@@ -982,7 +1027,7 @@ IndexRange::getRange() const
 		rg.set(Genome::getGenes()[_iGene].getRange());
 	}
 	
-	if (rg.isEmpty() || static_cast<size_t>(rg.getEnd()) >= Genome::getBases().length())
+	if (rg.isEmpty() || static_cast<size_t>(rg.getEnd()) >= Genome::getBaseSequence().length())
 		THROWRC((RC(ERROR), "Index range (%s) is invalid for trial %lu", toString().c_str(), Genome::getTrial()));
 		
 	return rg;
@@ -1073,6 +1118,82 @@ Mutation::toString(bool fTypeOnly) const
 	}
 }
 
+/*
+ * Function: load
+ *
+ * Load a fully specified mutation passed through the public interface. The
+ * same rules applied to mutations within plans apply.
+ */
+void
+Mutation::load(const ST_MUTATION& stm)
+{
+	ENTER(PLAN,load);
+
+	Range rgGenomeBases(Codon::s_cchCODON, Genome::getBaseSequence().length()-Codon::s_cchCODON);
+
+	if (stm._mt < STMT_COPY || stm._mt > STMT_TRANSPOSE)
+		THROWRC((RC(BADARGUMENTS), "Illegal mutation type (%d)", stm._mt));
+
+	initialize(static_cast<MUTATIONTYPE>(stm._mt));
+
+	size_t cb = stm._cbBases;
+	if (needsBases())
+	{
+		if (!VALID(stm._pszBases))
+			THROWRC((RC(BADARGUMENTS), "%s mutation requires bases", s_aryMUTATIONTYPE[_mt]));
+
+		_strBases = stm._pszBases;
+		if (!validateBases(_strBases.c_str(), _strBases.length()))
+			THROWRC((RC(BADARGUMENTS), "%s mutation has illegal bases (%s) - bases must be T, C, A, or G",
+									s_aryMUTATIONTYPE[_mt], _strBases.c_str()));
+		if (cb == 0)
+			cb = _strBases.length();
+		else if (cb != _strBases.length())
+			THROWRC((RC(BADARGUMENTS), "%s mutation has %ld bases but a countBases of %ld",
+									s_aryMUTATIONTYPE[_mt], _strBases.length(), cb));
+		_grfSupplied |= FS_BASES;
+	}
+
+	if (cb <= 0 || cb > rgGenomeBases.getLength())
+		THROWRC((RC(BADARGUMENTS), "%s mutation has an illegal countBases (%ld) - it must range from 1 to %ld",
+								s_aryMUTATIONTYPE[_mt], cb, rgGenomeBases.getLength()));
+	if (_mt != MT_CHANGE)
+	{
+		if (!Codon::hasWholeCodons(cb))
+			THROWRC((RC(BADARGUMENTS), "This version of Stylus requires countBases to be in whole codon units for all mutations except change - %ld is an illegal countBases value", cb));
+	}
+	else
+	{
+		if (cb != 1 && cb != Codon::s_cchCODON)
+			THROWRC((RC(BADARGUMENTS), "This version of Stylus requires countBases to be either 1 or %ld for change mutations - %ld is an illegal countBases value", Codon::s_cchCODON, cb));
+	}
+	_cbBases = cb;
+	_grfSupplied |= FS_COUNT;
+
+	if (needsSourceIndex())
+	{
+		long iIndex = static_cast<long>(stm._iSource) - 1;
+		if (!rgGenomeBases.contains(iIndex) || (iIndex + cb) >= Genome::getBaseSequence().length())
+			THROWRC((RC(BADARGUMENTS), "%s mutation has an illegal sourceIndex (%ld) - it must range from %ld to %ld",
+									s_aryMUTATIONTYPE[_mt], (iIndex+1), (rgGenomeBases.getStart()+1), (rgGenomeBases.getEnd()+1)));
+		if (!Codon::onCodonBoundary(iIndex))
+			THROWRC((RC(BADARGUMENTS), "This version of Stylus requires the sourceIndex for copy and transpose mutations to be on a codon boundary - %ld is an illegal sourceIndex value", (iIndex+1)));
+		_iSource = iIndex;
+		_grfSupplied |= FS_SOURCE;
+	}
+
+	long iIndex = static_cast<long>(stm._iTarget) - 1;
+	if (!rgGenomeBases.contains(iIndex))
+		THROWRC((RC(BADARGUMENTS), "%s mutation has an illegal targetIndex (%ld) - it must range from %ld to %ld",
+								s_aryMUTATIONTYPE[_mt], (iIndex+1), (rgGenomeBases.getStart()+1), (rgGenomeBases.getEnd()+1)));
+	if ((_mt != MT_CHANGE || cb != 1) && !Codon::onCodonBoundary(iIndex))
+		THROWRC((RC(BADARGUMENTS), "This version of Stylus requires the targetIndex for all mutations except single base changes to be on a codon boundary - %ld is an illegal targetIndex value", (iIndex+1)));
+	_iTarget = iIndex;
+	_grfSupplied |= FS_TARGET;
+
+	ASSERT(allFieldsSupplied());
+}
+
 
 //--------------------------------------------------------------------------------
 // 
@@ -1091,7 +1212,7 @@ StepMutation::load(XMLDocument* pxd, xmlNodePtr pxnStepMutation)
 	ASSERT(VALID(pxd));
 	ASSERT(VALID(pxnStepMutation));
 
-	Range rgGenomeBases(Codon::s_cchCODON, Genome::getBases().length()-Codon::s_cchCODON);
+	Range rgGenomeBases(Codon::s_cchCODON, Genome::getBaseSequence().length()-Codon::s_cchCODON);
 	string str;
 	
 	const char *pszStylusNamespace = pxd->getStylusNamespace();
@@ -1219,12 +1340,12 @@ StepMutation::load(XMLDocument* pxd, xmlNodePtr pxnStepMutation)
 	if (ST_ISALLSET(_grfSupplied, FS_SOURCE | FS_COUNT) && ST_ISANYSET(_grfSupplied, FS_TARGET | FS_TANDEM))
 	{
 		size_t iTarget = (ST_ISALLSET(_grfSupplied, FS_TARGET) ? _iTarget : _iSource + _cbBases);
-		if (_cbBases > (_iSource > iTarget ? Genome::getBases().length() - _iSource : iTarget - _iSource))
+		if (_cbBases > (_iSource > iTarget ? Genome::getBaseSequence().length() - _iSource : iTarget - _iSource))
 			THROWRC((RC(XMLERROR), "%s mutation has a countBases (%ld) value (actual or implied) that exceeds the available bases at sourceIndex (%ld)",
 									pxnStepMutation->name, _cbBases, (_iSource+1)));
 	}
 	
-	if (_mt == MT_CHANGE && ST_ISALLSET(_grfSupplied, FS_COUNT | FS_TARGET) && (_iTarget + _cbBases) > Genome::getBases().length())
+	if (_mt == MT_CHANGE && ST_ISALLSET(_grfSupplied, FS_COUNT | FS_TARGET) && (_iTarget + _cbBases) > Genome::getBaseSequence().length())
 		THROWRC((RC(XMLERROR), "%s mutation has a countBases (%ld) value (actual or implied) that exceeds the available bases at targetIndex (%ld)",
 								pxnStepMutation->name, _cbBases, (_iTarget+1)));
 }
@@ -1307,7 +1428,7 @@ Step::getMutation(Mutation& m, STFLAGS grfOptions, size_t iTrialInStep) const
 	if (_dIndex && !m.hasRange())
 	{
 		long codon = Codon::s_cchCODON;
-		long range = Genome::getBases().length() - (2 * codon);
+		long range = Genome::getBaseSequence().length() - (2 * codon);
 		long shift = (_dIndex * iTrialInStep) % range;
 
 		if (rg.getLength() >= static_cast<size_t>(range))
@@ -1346,7 +1467,7 @@ Step::getMutation(Mutation& m, STFLAGS grfOptions, size_t iTrialInStep) const
 	if (!m.hasCountBases())
 	{
 		ASSERT(!m.hasBases());
-		ASSERT(Genome::_strBases.length() > Constants::s_nMAXIMUMGENERATEDLENGTH);
+		ASSERT(Genome::_seqBases.length() > Constants::s_nMAXIMUMGENERATEDLENGTH);
 		m._cbBases = (m.isChange()
 						? 1
 						: Genome::rgenLength(Constants::s_nMAXIMUMGENERATEDLENGTH, ST_ISALLSET(grfOptions, SO_ENSUREWHOLECODONS)));
@@ -1362,9 +1483,9 @@ Step::getMutation(Mutation& m, STFLAGS grfOptions, size_t iTrialInStep) const
 		size_t iRandomTrial = 0;
 		do
 			m._iSource = Genome::rgenIndex(rg, ST_ISALLSET(grfOptions, SO_ENSUREINFRAME));
-		while (		(m._iSource + m._cbBases) >= Genome::_strBases.length()
-				&&	++iRandomTrial < Genome::_strBases.length());
-		if (iRandomTrial >= Genome::_strBases.length())
+		while (		(m._iSource + m._cbBases) >= Genome::_seqBases.length()
+				&&	++iRandomTrial < Genome::_seqBases.length());
+		if (iRandomTrial >= Genome::_seqBases.length())
 			THROWRC((RC(ERROR), "Unable to successfully generate a random mutation source index for mutation %s",
 					 			m.toString().c_str()));
 	}
@@ -1385,8 +1506,8 @@ Step::getMutation(Mutation& m, STFLAGS grfOptions, size_t iTrialInStep) const
 				&&	(	m._iTarget == m._iSource
 					||	(	m._iSource < m._iTarget
 						&&	(m._iSource + m._cbBases) > m._iTarget))
-				&&	++iRandomTrial < Genome::_strBases.length());
-		if (iRandomTrial >= Genome::_strBases.length())
+				&&	++iRandomTrial < Genome::_seqBases.length());
+		if (iRandomTrial >= Genome::_seqBases.length())
 			THROWRC((RC(ERROR), "Unable to successfully generate a random mutation target index for mutation %s",
 					 			m.toString().c_str()));
 	}
@@ -1399,11 +1520,22 @@ Step::getMutation(Mutation& m, STFLAGS grfOptions, size_t iTrialInStep) const
 		{
 			do
 				Genome::rgenBases(m._strBases, m._cbBases);
-			while (m.isChange() && !Genome::_strBases.compare(m._iTarget, m._cbBases, m._strBases));
+			while (m.isChange() && !Genome::_seqBases.compare(m._iTarget, m._cbBases, m._strBases));
 		}
 	}
 }
 
+/*
+ * Function: produceMutations
+ *
+ * Enumerate every mutation of the step's single mutation type within its
+ * range and pass them, as considerations, to the selector:
+ * - Changes replace the bases at each target with every other combination
+ * - Insertions add, at each codon boundary, the supplied bases or each sense codon
+ * - Deletions remove countBases bases at each codon boundary
+ * - Copies and transpositions move a countBases window from each source to
+ *   each target (or, for tandem copies, to just past the source)
+ */
 void
 Step::produceMutations(MutationSelector & selector, STFLAGS grfOptions, size_t iTrialInStep) 
 {
@@ -1420,67 +1552,120 @@ Step::produceMutations(MutationSelector & selector, STFLAGS grfOptions, size_t i
     ASSERT( _dIndex == 0 );
     if( !m.hasCountBases() )
     {
-        ASSERT( m.isChange() );
-        m._cbBases = 1;
+        ASSERT( m.isChange() || m.isInsert() || m.isDelete() );
+        m._cbBases = (m.isChange() ? 1 : Codon::s_cchCODON);
     }
-    ASSERT( !m.needsSourceIndex() );
+    ASSERT( !m.hasSourceIndex() );
+    ASSERT( !m.hasTargetIndex() );
+
+    // All but changes of partial codons must remain in frame
+    bool fEnsureInFrame = !m.isChange() || (ST_ISALLSET(grfOptions, SO_ENSUREINFRAME) && Codon::hasWholeCodons(m._cbBases));
 
-    ASSERT( !m.hasTandemIndex() );
-    bool fEnsureInFrame = ST_ISALLSET(grfOptions, SO_ENSUREINFRAME) && (!m.isChange() || Codon::hasWholeCodons(m._cbBases));
+    // Copies and transpositions take their sources from the range and insert within its extension
+    Range rgSource(rg);
     if (fWillInsert)
         ir.adjustRangeForInsert(rg);
 
-    ASSERT( !m.hasTargetIndex() );
-
     TFLOW(MUTATION,L2,(LLTRACE, "Sampling mutation positions from %d to %d",
             rg.getStart(), rg.getEnd()));
-    for(long iTarget = rg.getStart(); iTarget <= rg.getEnd(); iTarget++)
-   {
-        if( !fEnsureInFrame || Codon::onCodonBoundary(iTarget) )
+    MutationSelector::MUTATIONVECTOR vecMutations;
+
+    if( m.isCopy() || m.isTranspose() )
+    {
+        for(long iSource = rgSource.getStart(); iSource <= rgSource.getEnd(); iSource++)
         {
+            if( !Codon::onCodonBoundary(iSource) || (iSource + m._cbBases) >= Genome::_seqBases.length() )
+                continue;
+
+            TFLOW(MUTATION,L2,(LLTRACE, "Starting source position %d", iSource));
+            m._iSource = iSource;
+            if( m.hasTandemIndex() )
+            {
+                m._iTarget = iSource + m._cbBases;
+                vecMutations.push_back(m);
+                continue;
+            }
+
+            for(long iTarget = rg.getStart(); iTarget <= rg.getEnd(); iTarget++)
+            {
+                // Skip targets within (or, for transpositions, bordering) the source window
+                if(     !Codon::onCodonBoundary(iTarget)
+                    ||  (   iTarget >= iSource
+                        &&  iTarget < static_cast<long>(iSource + m._cbBases + (m.isTranspose() ? 1 : 0))) )
+                    continue;
+
+                m._iTarget = iTarget;
+                vecMutations.push_back(m);
+            }
+        }
+    }
+
+    else
+    {
+        for(long iTarget = rg.getStart(); iTarget <= rg.getEnd(); iTarget++)
+        {
+            if( fEnsureInFrame && !Codon::onCodonBoundary(iTarget) )
+                continue;
 
             TFLOW(MUTATION,L2,(LLTRACE, "Starting target position %d", iTarget));
             m._iTarget = iTarget;
-            ASSERT(!m.isCopy());
-            ASSERT(!m.isTranspose());
-            ASSERT(m.needsBases() && !m.hasBases());
-
-            ASSERT(Constants::s_strBASES.length() == 4);
-	    std::vector<size_t> counts(m._cbBases+1);
-            m._strBases.resize(m._cbBases);
-            while(!counts[m._cbBases])
+
+            if( m.isDelete() )
             {
-                for(size_t idx = 0; idx < m._cbBases;idx++)
-                {
-                    m._strBases[idx] = Constants::s_strBASES[counts[idx]];
-                }
-                // skip silent changes
-                if( Genome::_strBases.compare(m._iTarget, m._cbBases, m._strBases) )
-                {
-                    TFLOW(MUTATION,L2,(LLTRACE, "Mutation with bases %s", m._strBases.c_str()));
-                    selector.addMutation(m);
-                    selector.mutationFinalize();
-                }
-                size_t increment_pos = 0;
-                while(true)
+                if( (iTarget + m._cbBases) <= Genome::_seqBases.length() )
+                    vecMutations.push_back(m);
+            }
+
+            else if( m.isInsert() && m.hasBases() )
+            {
+                vecMutations.push_back(m);
+            }
+
+            else
+            {
+                ASSERT(m.needsBases() && !m.hasBases());
+                ASSERT(m.isChange() || m._cbBases == Codon::s_cchCODON);
+
+                ASSERT(Constants::s_strBASES.length() == 4);
+                std::vector<size_t> counts(m._cbBases+1);
+                m._strBases.resize(m._cbBases);
+                while(!counts[m._cbBases])
                 {
-                    counts[increment_pos]++;
-                    if( counts[increment_pos] == 4 )
+                    for(size_t idx = 0; idx < m._cbBases;idx++)
                     {
-                        counts[increment_pos] = 0;
-                        increment_pos++;
+                        m._strBases[idx] = Constants::s_strBASES[counts[idx]];
                     }
-                    else
+                    // skip silent changes and inserted stop codons
+                    if( m.isChange()
+                        ? Genome::_seqBases.compare(m._iTarget, m._cbBases, m._strBases) != 0
+                        : !Codon::isStop(m._strBases) )
                     {
-                        break;
+                        TFLOW(MUTATION,L2,(LLTRACE, "Mutation with bases %s", m._strBases.c_str()));
+                        vecMutations.push_back(m);
                     }
+                    size_t increment_pos = 0;
+                    while(true)
+                    {
+                        counts[increment_pos]++;
+                        if( counts[increment_pos] == 4 )
+                        {
+                            counts[increment_pos] = 0;
+                            increment_pos++;
+                        }
+                        else
+                        {
+                            break;
+                        }
 
-                }
+                    }
 
+                }
             }
-
         }
     }
+
+    TFLOW(MUTATION,L2,(LLTRACE, "Enumerated %lu %s mutations", vecMutations.size(), m.toString(true).c_str()));
+    selector.considerMutations(vecMutations);
 }
 
 void Step::checkSupportsExhaustive()
@@ -1490,17 +1675,23 @@ void Step::checkSupportsExhaustive()
 
     Mutation & m = _vecMutations[0];
     
-    if( !m.isChange() )
-        THROWRC((RC(XMLERROR), "Only change mutations are supported when exhaustive mode is enabled"));
-    
     if( m.hasTargetIndex() )
         THROWRC((RC(XMLERROR), "Specifying the target position is not supported when exhaustive mode is enabled"));
 
+    if( m.hasSourceIndex() )
+        THROWRC((RC(XMLERROR), "Specifying the source position is not supported when exhaustive mode is enabled"));
+
     if( m.hasTransversion() )
         THROWRC((RC(XMLERROR), "Transversion likelihood is not supported when exhaustive mode is enabled"));
 
-    if( m.hasBases() )
-        THROWRC((RC(XMLERROR), "Specifying the bases is not supported when exhaustive mode is enabled"));
+    if( m.isChange() && m.hasBases() )
+        THROWRC((RC(XMLERROR), "Specifying the bases is not supported for changes when exhaustive mode is enabled"));
+
+    if( m.isInsert() && !m.hasBases() && m.hasCountBases() && m.countBases() != Codon::s_cchCODON )
+        THROWRC((RC(XMLERROR), "Insertions without bases enumerate single codons when exhaustive mode is enabled - %ld is an illegal countBases value", m.countBases()));
+
+    if( (m.isCopy() || m.isTranspose()) && !m.hasCountBases() )
+        THROWRC((RC(XMLERROR), "Copies and transpositions require countBases when exhaustive mode is enabled"));
 }
 
 
@@ -1515,7 +1706,7 @@ Step::load(XMLDocument* pxd, xmlNodePtr pxnStep)
 	ASSERT(VALID(pxd));
 	ASSERT(VALID(pxnStep));
 
-	Range rgGenomeBases(Codon::s_cchCODON, Genome::_strBases.length()-Codon::s_cchCODON);
+	Range rgGenomeBases(Codon::s_cchCODON, Genome::_seqBases.length()-Codon::s_cchCODON);
 	xmlXPathContextSPtr spxpc(pxd->createXPathContext());
 	xmlXPathObjectSPtr spxpo;
 	string str;
@@ -1692,24 +1883,29 @@ Plan::execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t
 
 				// Advance the genome to the next trial
 				Genome::advanceTrial(!_fAccumulateMutations);
+
+				// Speculate only in steps applying random mutations (exhaustive steps consider theirs concurrently)
+				Speculation speculation(_cSpeculativeAttempts > 0 && getMutationTrialCondition(_iStep)->generatesSingleMutation()
+										? _cSpeculativeAttempts
+										: 0);
 				
 				// Execute the current step until trial completion
 				// - The number of mutations to apply varies with each *attempt* (rather than each trial)
 				while (!fPlanTerminated && !fTrialCompleted)
 				{
 					bool fSuccess = true;
+					bool fRollbackPossible = false;
+					bool fSpeculated = false;
 
-					// Advance the number of trial attempts
-					Genome::advanceTrialAttempts();
-
-                    mutationSelector.reset();
-
-					TFLOW(PLAN,L3,(LLTRACE, "Executing trial attempt %d", Genome::getTrialAttempts()));
-                    MutationSource source(st, grfOptions, Genome::getTrial()-cTrialsInCompletedSteps-iTrialFirst);
-                    produceMutations(source, mutationSelector);
-					
-					// If all mutations applied, validate and score the genome
-                    fSuccess = mutationSelector.selectMutation();
+					// Execute the attempt (or take the outcome of its speculative execution)
+					if (speculation.isEnabled())
+						fSuccess = speculation.execute(*this, mutationSelector, grfOptions, Genome::getTrial()-cTrialsInCompletedSteps-iTrialFirst,
+													   fRollbackPossible, fSpeculated);
+					else
+					{
+						fSuccess = executeAttempt(mutationSelector, grfOptions, Genome::getTrial()-cTrialsInCompletedSteps-iTrialFirst);
+						fRollbackPossible = mutationSelector.getRollbackPossible();
+					}
 
 					// Convert a successful attempt into a successful trial and continue
 					// - Condition or caller termination leaves the success state unchanged
@@ -1727,6 +1923,14 @@ Plan::execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t
 						else if (fSuccess && VALID(pfnStatus) && ((Genome::getTrial() % cStatusRate) == 0) && (*pfnStatus)())
 						{
 							Genome::recordTermination(ST_FILELINE, STGT_CALLBACK, STGR_TERMINATED, "Callback ended plan execution at trial %ld", Genome::getTrial());
+							Population::terminate();
+							fPlanTerminated = true;
+						}
+
+						// If evolving a population, allow migration (and end the plan if the population has ended)
+						else if (!Population::completeTrial())
+						{
+							Genome::recordTermination(ST_FILELINE, STGT_CALLBACK, STGR_TERMINATED, "Population ended plan execution at trial %ld", Genome::getTrial());
 							fPlanTerminated = true;
 						}
 					}
@@ -1737,12 +1941,13 @@ Plan::execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t
 
 						// Always leave the genome in the last stable state
 						// - The genome should never be "alive" at this point since something has failed
+						// - Speculative attempts were removed when they were executed
 						ASSERT(!Genome::isState(STGS_ALIVE));
-						fSuccess = Genome::rollback();
+						fSuccess = (fSpeculated || Genome::rollback());
 						TFLOW(PLAN,L5,(LLTRACE, "Plan %s removed changes", (fSuccess ? "successfully" : "unsuccessfully")));
 
 						// If rollbacks are not possible and or exhausted, terminate the plan
-						if (!mutationSelector.getRollbackPossible() )
+						if (!fRollbackPossible )
                         {
                             fPlanTerminated = true;
                             Genome::recordTermination(ST_FILELINE, STGT_ROLLBACK, STGR_NONE, "Rollbacks not possible in trial %lu - plan ending", Genome::getTrial() );
@@ -1769,6 +1974,31 @@ Plan::execute(size_t iTrialFirst, size_t cTrials, ST_PFNSTATUS pfnStatus, size_t
 
 }
 
+/*
+ * Function: executeAttempt
+ *
+ * Produce, apply, validate, and score the mutations of one trial attempt,
+ * returning whether the attempt succeeded. A failed attempt is left for the
+ * caller to remove.
+ */
+bool
+Plan::executeAttempt(MutationSelector & mutationSelector, STFLAGS grfOptions, size_t iTrialInStep)
+{
+	ENTER(PLAN,executeAttempt);
+
+	// Advance the number of trial attempts
+	Genome::advanceTrialAttempts();
+
+	mutationSelector.reset();
+
+	TFLOW(PLAN,L3,(LLTRACE, "Executing trial attempt %d", Genome::getTrialAttempts()));
+	MutationSource source(_vecSteps[_iStep], grfOptions, iTrialInStep);
+	produceMutations(source, mutationSelector);
+
+	// If all mutations applied, validate and score the genome
+	return mutationSelector.selectMutation();
+}
+
 /*
  * Function: load
  *
@@ -1809,6 +2039,25 @@ Plan::load(const char* pxmlPlan)
 			_fEnsureWholeCodons = XMLDocument::isXMLTrue(str);
 		if (spxd->getAttribute(pxnOptions, xmlTag(XT_REJECTSILENT), str))
 			_fRejectSilent = XMLDocument::isXMLTrue(str);
+		if (spxd->getAttribute(pxnOptions, xmlTag(XT_FITNESSCACHE), str))
+			_cFitnessCache = ::atol(str.c_str());
+		if (spxd->getAttribute(pxnOptions, xmlTag(XT_SPECULATIVEATTEMPTS), str))
+			_cSpeculativeAttempts = ::atol(str.c_str());
+		if (spxd->getAttribute(pxnOptions, xmlTag(XT_BOUNDSCORES), str))
+			_fBoundScores = XMLDocument::isXMLTrue(str);
+		if (spxd->getAttribute(pxnOptions, xmlTag(XT_ATTEMPTHISTORY), str))
+			_ahRetention = (str == xmlTag(XT_NONE)
+							? AH_NONE
+							: (str == xmlTag(XT_LAST)
+								? AH_LAST
+								: (str == xmlTag(XT_SAMPLE)
+									? AH_SAMPLE
+									: AH_ALL)));
+		if (spxd->getAttribute(pxnOptions, xmlTag(XT_ATTEMPTHISTORYSIZE), str))
+			_cAttemptHistory = ::atol(str.c_str());
+
+		if ((_ahRetention == AH_LAST || _ahRetention == AH_SAMPLE) && _cAttemptHistory <= 0)
+			THROWRC((RC(XMLERROR), "Illegal plan - Keeping the last or a sample of the attempts requires a positive attemptHistorySize"));
 
 		// Check for restrictions in this version of Stylus
 		// - Genes must be preserved
@@ -1847,6 +2096,25 @@ Plan::load(const char* pxmlPlan)
 			_grfTermination |= PC_TERMINATIONFITNESS;
 			_fc.load(spxd.get(), spxpoOption->nodesetval->nodeTab[0]);
 		}
+
+		// Load any population
+		spxpoOption = spxd->evalXPath(spxpcOptions.get(), xmlXPath(XP_POPULATION));
+		if (XMLDocument::isXPathSuccess(spxpoOption.get(), 1))
+		{
+			xmlNodePtr pxnPopulation = spxpoOption->nodesetval->nodeTab[0];
+
+			if (spxd->getAttribute(pxnPopulation, xmlTag(XT_SIZE), str))
+				_cPopulation = ::atol(str.c_str());
+			if (spxd->getAttribute(pxnPopulation, xmlTag(XT_MIGRATIONINTERVAL), str))
+				_cMigrationInterval = ::atol(str.c_str());
+			if (spxd->getAttribute(pxnPopulation, xmlTag(XT_TEMPERATURERATIO), str))
+				_nTemperatureRatio = Unit(str);
+
+			if (_cPopulation <= 0)
+				THROWRC((RC(XMLERROR), "Illegal plan - The population must contain at least one lineage"));
+			if (_nTemperatureRatio != 0.0 && _nTemperatureRatio <= 1.0)
+				THROWRC((RC(XMLERROR), "Illegal plan - The temperature ratio (%6.4f) must be greater than 1.0", _nTemperatureRatio));
+		}
 	}
 
 	// Find and load the steps
@@ -1912,6 +2180,22 @@ Plan::toXML(XMLStream& xs)
 	xs.writeAttribute(xmlTag(XT_ENSUREINFRAME), _fEnsureInFrame);
 	xs.writeAttribute(xmlTag(XT_ENSUREWHOLECODONS), _fEnsureWholeCodons);
 	xs.writeAttribute(xmlTag(XT_REJECTSILENT), _fRejectSilent);
+	if (_cFitnessCache > 0)
+		xs.writeAttribute(xmlTag(XT_FITNESSCACHE), _cFitnessCache);
+	if (_cSpeculativeAttempts > 0)
+		xs.writeAttribute(xmlTag(XT_SPECULATIVEATTEMPTS), _cSpeculativeAttempts);
+	if (_fBoundScores)
+		xs.writeAttribute(xmlTag(XT_BOUNDSCORES), _fBoundScores);
+	if (_ahRetention != AH_ALL)
+	{
+		xs.writeAttribute(xmlTag(XT_ATTEMPTHISTORY), xmlTag(_ahRetention == AH_NONE
+														? XT_NONE
+														: (_ahRetention == AH_LAST
+															? XT_LAST
+															: XT_SAMPLE)));
+		if (_ahRetention != AH_NONE)
+			xs.writeAttribute(xmlTag(XT_ATTEMPTHISTORYSIZE), _cAttemptHistory);
+	}
 	xs.closeStart();
 
 	_tc.toXML(xs);
@@ -1927,6 +2211,16 @@ Plan::toXML(XMLStream& xs)
 			_rc.toXML(xs);
 		xs.writeEnd(xmlTag(XT_TERMINATIONCONDITIONS));
 	}
+
+	if (_cPopulation > 1)
+	{
+		xs.openStart(xmlTag(XT_POPULATION));
+		xs.writeAttribute(xmlTag(XT_SIZE), _cPopulation);
+		xs.writeAttribute(xmlTag(XT_MIGRATIONINTERVAL), _cMigrationInterval);
+		if (_nTemperatureRatio > 0.0)
+			xs.writeAttribute(xmlTag(XT_TEMPERATURERATIO), _nTemperatureRatio);
+		xs.closeStart(false);
+	}
 	
 	xs.writeEnd(xmlTag(XT_OPTIONS));
 
@@ -1954,6 +2248,11 @@ Plan::initialize()
 	_fEnsureInFrame = true;
 	_fEnsureWholeCodons = true;
 	_fRejectSilent = false;
+	_cFitnessCache = 0;
+	_cSpeculativeAttempts = 0;
+	_fBoundScores = false;
+	_ahRetention = AH_ALL;
+	_cAttemptHistory = 0;
 
 	_tc.clear();
 
@@ -1962,15 +2261,25 @@ Plan::initialize()
 	_rc.clear();
 	_fc.clear();
 
+	_cPopulation = 1;
+	_cMigrationInterval = 0;
+	_nTemperatureRatio = 0.0;
+
 	_vecSteps.clear();
 }
 
 bool
 Plan::evaluateConditions(bool fFinal)
 {
-    return	    evaluateCondition(PC_TRIALCOST, Genome::getCost(), fFinal)
-            &&	evaluateCondition(PC_TRIALFITNESS, Genome::getFitness(), fFinal)
-            &&	evaluateCondition(PC_TRIALSCORE, Genome::getScore(), fFinal);
+    return evaluateConditions(Genome::getCost(), Genome::getFitness(), Genome::getScore(), fFinal);
+}
+
+bool
+Plan::evaluateConditions(UNIT nCost, UNIT nFitness, UNIT nScore, bool fFinal)
+{
+    return	    evaluateCondition(PC_TRIALCOST, nCost, fFinal)
+            &&	evaluateCondition(PC_TRIALFITNESS, nFitness, fFinal)
+            &&	evaluateCondition(PC_TRIALSCORE, nScore, fFinal);
 }
 
 UNIT
@@ -1996,6 +2305,93 @@ Plan::getPerformancePrecision()
     return getPrimaryTrialCondition()->getPerformancePrecision();
 }
 
+/*
+ * Function: boundScoring
+ *
+ * Let the genome stop scoring once its performance must fall below the precision
+ * of the passed best performance (that is, once it could not be selected). Only
+ * increasing score or fitness performance is bounded; otherwise, or if the plan
+ * does not bound scores, scoring is left unbounded.
+ */
+void
+Plan::boundScoring(UNIT nBest)
+{
+	ENTER(PLAN,boundScoring);
+
+	TrialCondition* primary = getPrimaryTrialCondition();
+	if (	_fBoundScores
+		&&	primary->isIncreasing()
+		&&	primary != getTrialCondition(PC_TRIALCOST))
+		Genome::setScoreBound(nBest * getPerformancePrecision(), primary == getTrialCondition(PC_TRIALFITNESS));
+	else
+		Genome::clearScoreBound();
+}
+
+/*
+ * Function: getTemperature
+ *
+ * Return the current temperature of the fitness condition (zero if the
+ * condition does not anneal).
+ */
+UNIT
+Plan::getTemperature()
+{
+	ENTER(PLAN,getTemperature);
+
+	TrialCondition* ptc = getTrialCondition(PC_TRIALFITNESS);
+	return (ptc->isAnnealing() ? ptc->getTemperature() : 0.0);
+}
+
+/*
+ * Function: scaleTemperatures
+ *
+ * Scale the temperature of every annealing condition (in the plan and in
+ * each step).
+ */
+void
+Plan::scaleTemperatures(UNIT nFactor)
+{
+	ENTER(PLAN,scaleTemperatures);
+
+	_tc.scaleTemperatures(nFactor);
+	for (size_t iStep=0; iStep < _vecSteps.size(); ++iStep)
+		_vecSteps[iStep].scaleTemperatures(nFactor);
+}
+
+/*
+ * Function: resetAnnealing
+ *
+ * Set the threshold of each annealing condition to the value of the current
+ * genome so that, after adopting a genome, annealing continues from it.
+ */
+void
+Plan::resetAnnealing()
+{
+	ENTER(PLAN,resetAnnealing);
+
+	getTrialCondition(PC_TRIALCOST)->resetAnnealing(Genome::getCost());
+	getTrialCondition(PC_TRIALFITNESS)->resetAnnealing(Genome::getFitness());
+	getTrialCondition(PC_TRIALSCORE)->resetAnnealing(Genome::getScore());
+}
+
+/*
+ * Function: adoptConditions
+ *
+ * Take the trial conditions (in the plan and in each step) of the passed copy
+ * of the plan, so that the thresholds left by an attempt executed against the
+ * copy (see Speculation) hold as though the attempt were made against the plan.
+ */
+void
+Plan::adoptConditions(const Plan& plan)
+{
+	ENTER(PLAN,adoptConditions);
+	ASSERT(plan._vecSteps.size() == _vecSteps.size());
+
+	_tc = plan._tc;
+	for (size_t iStep=0; iStep < _vecSteps.size(); ++iStep)
+		_vecSteps[iStep].adoptConditions(plan._vecSteps[iStep]);
+}
+
 
 bool Plan::applyMutation(Mutation & m)
 {
@@ -2036,6 +2432,93 @@ MutationSelector::addMutation(Mutation & mutation)
     return fSuccess;
 }
 
+/*
+ * Function: considerMutations
+ *
+ * Consider, in order, each of the passed mutations. When more than one worker
+ * thread is available, the mutations are divided among workers, each holding
+ * a private copy of the genome; the results are then replayed, in order, on
+ * the calling thread. Condition evaluation (which may consume random numbers)
+ * always occurs on the calling thread so that the outcome does not depend on
+ * the number of workers.
+ *
+ * NOTES:
+ * - Mutation callbacks expect to run on the thread executing the plan, so
+ *   setting one forces serial evaluation
+ */
+void
+MutationSelector::considerMutations(const MUTATIONVECTOR & vecMutations)
+{
+    ENTER(PLAN,considerMutations);
+
+    size_t cWorkers = WorkerPool::getWorkers(vecMutations.size() / s_cminWORKERCONSIDERATIONS);
+    if( cWorkers <= 1 || _fSingleMutation || VALID(Genome::_mutationCallback) )
+    {
+        for(size_t iMutation = 0; iMutation < vecMutations.size(); ++iMutation)
+        {
+            Mutation m(vecMutations[iMutation]);
+            addMutation(m);
+            mutationFinalize();
+        }
+        return;
+    }
+
+    ASSERT(_current().mutations.empty());
+    _considerations.pop_back();
+
+    std::vector<GenomeContext> vecContexts(cWorkers);
+    std::vector<CONSIDERATIONVECTOR> vecConsiderations(cWorkers);
+    std::vector<char> vecFieldsMissing(cWorkers, false);
+    for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker)
+        Genome::copyContext(vecContexts[iWorker]);
+
+    ST_STATISTICS stats = Genome::_stats;
+    ST_STATISTICS statsRecordRate = Genome::_statsRecordRate;
+
+    size_t cPerWorker = (vecMutations.size() + cWorkers - 1) / cWorkers;
+    WorkerPool::execute(cWorkers, [&](size_t iWorker)
+    {
+        size_t iFirst = std::min(iWorker * cPerWorker, vecMutations.size());
+        size_t iLast = std::min(iFirst + cPerWorker, vecMutations.size());
+
+        bool fFieldsMissing = false;
+        Genome::exchangeContext(vecContexts[iWorker]);
+        Globals::enableTracing(Genome::getTrial(), Genome::getTrialAttempts());
+        try
+        {
+            _evaluateConsiderations(vecMutations, iFirst, iLast, vecConsiderations[iWorker], fFieldsMissing);
+        }
+        catch (...)
+        {
+            Genome::exchangeContext(vecContexts[iWorker]);
+            throw;
+        }
+        Genome::exchangeContext(vecContexts[iWorker]);
+        vecFieldsMissing[iWorker] = fFieldsMissing;
+    });
+
+    // Replay the considerations, in order, against the calling thread's genome
+    for(size_t iWorker = 0; iWorker < cWorkers; ++iWorker)
+    {
+        _fFieldsMissing = _fFieldsMissing || vecFieldsMissing[iWorker];
+        for(size_t iConsideration = 0; iConsideration < vecConsiderations[iWorker].size(); ++iConsideration)
+        {
+            _considerations.push_back( Consideration() );
+            _current() = vecConsiderations[iWorker][iConsideration];
+            vecConsiderations[iWorker][iConsideration].spSnapshot = NULL;
+            _replayConsideration(_current());
+            if( VALIDSP(_current().spSnapshot) )
+                _vecSnapshots.push_back(_considerations.size()-1);
+            _pruneSnapshots(_considerations, _vecSnapshots, _best);
+        }
+        Genome::mergeContext(vecContexts[iWorker], stats, statsRecordRate);
+    }
+
+    // Discard descriptions recorded while replaying conditions (each consideration was already rolled back)
+    Genome::_msModifications.clear();
+    _considerations.push_back( Consideration() );
+}
+
 bool
 MutationSelector::selectMutation()
 {
@@ -2056,7 +2539,12 @@ MutationSelector::selectMutation()
         }
         TFLOW(PLAN,L2,(LLTRACE, "Mutation reapplied: %d", consideration.fValidMutations));
 
-        fSuccess = consideration.fValidMutations && Genome::validate();
+        // Take the validated genes preserved when the mutation was considered, if any,
+        // rather than validating the genome again
+        fSuccess = consideration.fValidMutations
+                && (VALIDSP(consideration.spSnapshot)
+                    ? Genome::restoreSnapshot(*consideration.spSnapshot)
+                    : Genome::validate());
     }
     else
     {
@@ -2077,7 +2565,13 @@ void
 MutationSelector::mutationFinalize()
 {
     if( _current().fValidMutations )
+    {
+        // Considerations that cannot be selected need not be scored in full
+        if( _fBest && !_fSingleMutation )
+            _plan.boundScoring(_best);
         _current().fValidated = Genome::validate();
+        Genome::clearScoreBound();
+    }
     else
         _current().fValidated = false;
 
@@ -2095,13 +2589,22 @@ MutationSelector::mutationFinalize()
         {
             _best = _current().value;
         }
+        _fBest = true;
+
+        if( !_fSingleMutation )
+        {
+            _takeSnapshot(_current(), _best);
+            if( VALIDSP(_current().spSnapshot) )
+                _vecSnapshots.push_back(_considerations.size()-1);
+            _pruneSnapshots(_considerations, _vecSnapshots, _best);
+        }
     }
     TFLOW(PLAN,L2,(LLTRACE, "Mutation %d as been added to considerations, performance: %f,  best so far is %f", 
         _considerations.size(),
         static_cast<UNIT>(_current().value),
         static_cast<UNIT>(_best)));
     if( _current().fValidated && _current().fValidMutations )
-        Genome::recordAttempt(ST_FILELINE, STTR_PLAN, "Performance: %f", static_cast<UNIT>(_current().value));
+        _recordPerformance(_current());
 
     // if we are only going to consider a single mutation
     // we can skip the rollback
@@ -2111,6 +2614,158 @@ MutationSelector::mutationFinalize()
 
 }
 
+/*
+ * Function: _evaluateConsiderations
+ *
+ * Apply, validate, score, and then rollback each mutation in the passed range
+ * recording the results as considerations. This routine runs on a worker
+ * thread against a private copy of the genome.
+ *
+ * NOTES:
+ * - Scoring is bounded by the best performance among the worker's own
+ *   considerations, which never exceeds the best overall
+ */
+void
+MutationSelector::_evaluateConsiderations(const MUTATIONVECTOR & vecMutations, size_t iFirst, size_t iLast,
+                                          CONSIDERATIONVECTOR & considerations, bool & fFieldsMissing)
+{
+    ENTER(PLAN,_evaluateConsiderations);
+
+    NUMERICARRAY vecSnapshots;
+    bool fBest = false;
+    UNIT nBest = 0;
+
+    for(size_t iMutation = iFirst; iMutation < iLast; ++iMutation)
+    {
+        considerations.push_back( Consideration() );
+        Consideration & consideration = considerations.back();
+
+        Genome::_gaTermination = STGT_NONE;
+        Genome::_grTermination = STGR_NONE;
+        Genome::_dsTermination.clear();
+
+        Mutation m(vecMutations[iMutation]);
+        consideration.fValidMutations = _plan.applyMutation(m);
+        fFieldsMissing = fFieldsMissing || !m.allFieldsSupplied();
+        consideration.mutations.push_back(m);
+
+        if( fBest )
+            _plan.boundScoring(nBest);
+        consideration.fValidated = consideration.fValidMutations && Genome::validate();
+        Genome::clearScoreBound();
+        if( consideration.fValidMutations && consideration.fValidated )
+        {
+            consideration.nCost = Genome::getCost();
+            consideration.nFitness = Genome::getFitness();
+            consideration.nScore = Genome::getScore();
+            consideration.value = _plan.evaluatePerformance();
+            if( !fBest || consideration.value > nBest )
+            {
+                nBest = consideration.value;
+                fBest = true;
+            }
+
+            _takeSnapshot(consideration, nBest);
+            if( VALIDSP(consideration.spSnapshot) )
+                vecSnapshots.push_back(considerations.size()-1);
+            _pruneSnapshots(considerations, vecSnapshots, nBest);
+
+            _recordPerformance(consideration);
+        }
+
+        consideration.gaTermination = Genome::_gaTermination;
+        consideration.grTermination = Genome::_grTermination;
+        consideration.dsTermination = Genome::_dsTermination;
+
+        Genome::rollback();
+    }
+}
+
+/*
+ * Function: _recordPerformance
+ *
+ */
+void
+MutationSelector::_recordPerformance(const Consideration & consideration)
+{
+    Genome::recordAttempt(ST_FILELINE, STTR_PLAN, "Performance: %f", static_cast<UNIT>(consideration.value));
+}
+
+/*
+ * Function: _takeSnapshot
+ *
+ * Preserve the validated genes of the consideration if it could be selected
+ * (that is, if its performance is within the precision of the best so far)
+ */
+void
+MutationSelector::_takeSnapshot(Consideration & consideration, UNIT nBest)
+{
+    ENTER(PLAN,_takeSnapshot);
+
+    if( consideration.value >= nBest * _plan.getPerformancePrecision() )
+    {
+        consideration.spSnapshot = ::new GenomeSnapshot();
+        Genome::takeSnapshot(*consideration.spSnapshot);
+    }
+}
+
+/*
+ * Function: _pruneSnapshots
+ *
+ * Release the snapshots of considerations that can no longer be selected
+ *
+ * NOTES:
+ * - The best performance only rises, so a pruned consideration never again
+ *   becomes selectable; should one be selected anyway, it is validated again
+ */
+void
+MutationSelector::_pruneSnapshots(CONSIDERATIONVECTOR & considerations, NUMERICARRAY & vecSnapshots, UNIT nBest)
+{
+    ENTER(PLAN,_pruneSnapshots);
+
+    UNIT threshold = nBest * _plan.getPerformancePrecision();
+    size_t cSnapshots = 0;
+    for(size_t iSnapshot = 0; iSnapshot < vecSnapshots.size(); ++iSnapshot)
+    {
+        Consideration & consideration = considerations[vecSnapshots[iSnapshot]];
+        if( consideration.value >= threshold )
+            vecSnapshots[cSnapshots++] = vecSnapshots[iSnapshot];
+        else
+            consideration.spSnapshot = NULL;
+    }
+    vecSnapshots.resize(cSnapshots);
+}
+
+/*
+ * Function: _replayConsideration
+ *
+ * Apply to the calling thread the results of a consideration evaluated by a
+ * worker (see mutationFinalize)
+ */
+void
+MutationSelector::_replayConsideration(Consideration & consideration)
+{
+    ENTER(PLAN,_replayConsideration);
+
+    if( consideration.gaTermination != STGT_NONE )
+        Genome::recordTermination(consideration.gaTermination, consideration.grTermination, consideration.dsTermination);
+
+    if( consideration.fValidMutations && consideration.fValidated )
+    {
+        _fAcceptedMutation = _fAcceptedMutation
+                            || _plan.evaluateConditions(consideration.nCost, consideration.nFitness, consideration.nScore, false);
+        if( _considerations.size() == 1 || consideration.value > _best)
+        {
+            _best = consideration.value;
+        }
+        _fBest = true;
+    }
+    TFLOW(PLAN,L2,(LLTRACE, "Mutation %d as been added to considerations, performance: %f,  best so far is %f", 
+        _considerations.size(),
+        static_cast<UNIT>(consideration.value),
+        static_cast<UNIT>(_best)));
+}
+
 size_t
 MutationSelector::_pickMutation()
 {
@@ -2166,7 +2821,9 @@ void
 MutationSelector::reset()
 {
     _considerations.clear();
+    _vecSnapshots.clear();
     _fFieldsMissing = false;
     _fAcceptedMutation = false;
+    _fBest = false;
     _considerations.push_back( Consideration() );
 }
@@ -85,6 +85,12 @@ namespace org_biologicinstitute_stylus
         bool active() const;
         UNIT getPerformancePrecision() const;
         const MutationTrialCondition * getMutationTrialCondition() const;
+
+		bool isIncreasing() const;
+		bool isAnnealing() const;
+		UNIT getTemperature() const;
+		void scaleTemperature(UNIT nFactor);
+		void resetAnnealing(UNIT nValue);
 		
 	protected:
 		enum TRIALCONDITIONMODE
@@ -101,8 +107,13 @@ namespace org_biologicinstitute_stylus
 
 		TRIALCONDITIONMODE _tcm;
 		TRIALVALUEARRAY _vecValues;
+
+		UNIT _nTemperature;					///< Initial Metropolis temperature (zero requires every trial to improve)
+		UNIT _nCooling;						///< Factor applied to the temperature each trial
+		size_t _iAttemptAccepted;			///< Last attempt accepted despite failing the threshold
 		
 		void initialize(UNIT nValueDefault);
+		bool accept(UNIT nWorse, bool fFinal);
 
 		void load(XMLDocument* pxd, xmlNodePtr pxn);
 		void toXML(XMLStream& xs, size_t iGene = 0);
@@ -224,6 +235,7 @@ namespace org_biologicinstitute_stylus
 		bool evaluate(PLANCONDITION pc, UNIT nValue, bool fFinal);
 		size_t getMutationsPerAttempt() const;
         void produceMutations(MutationSource & source, MutationSelector & selector);
+		void scaleTemperatures(UNIT nFactor);
 		
 		void load(XMLDocument* pxd, xmlNodePtr pxn);
 		void toXML(XMLStream& xs);
@@ -400,6 +412,8 @@ namespace org_biologicinstitute_stylus
 		
 		std::string toString(bool fTypeOnly = false) const;
 
+		void load(const ST_MUTATION& stm);
+
 	protected:
 		static const char* s_aryMUTATIONTYPE[MT_MAX];
 		static const Unit s_nTRANSVERSIONLIKELIHOOD;
@@ -508,6 +522,8 @@ namespace org_biologicinstitute_stylus
         void produceMutations(MutationSource & source, MutationSelector & selector);
 
         void produceMutations(MutationSelector & selector, STFLAGS grfOptions, size_t iTrialInStep);
+		void scaleTemperatures(UNIT nFactor);
+		void adoptConditions(const Step& st);
 		
 		void load(XMLDocument* pxd, xmlNodePtr pxn);
 		void toXML(XMLStream& xs);
@@ -543,8 +559,11 @@ namespace org_biologicinstitute_stylus
     class MutationSelector
     {
     public:
+        typedef std::vector<Mutation> MUTATIONVECTOR;
+
         MutationSelector(Plan & plan);
         bool addMutation(Mutation & mutation);
+        void considerMutations(const MUTATIONVECTOR & vecMutations);
         void startMutations(bool fSingleMutation);
         void mutationFinalize();
         bool selectMutation();
@@ -553,8 +572,8 @@ namespace org_biologicinstitute_stylus
 
 
     private:
+        static const size_t s_cminWORKERCONSIDERATIONS = 16;  ///< Fewest considerations worth handing to a worker
 
-        typedef std::vector<Mutation> MUTATIONVECTOR;
         struct Consideration
         {
             Consideration();
@@ -562,18 +581,37 @@ namespace org_biologicinstitute_stylus
             bool fValidMutations;
             bool fValidated;
             MUTATIONVECTOR mutations;
+
+            // Values recorded by workers for replay on the selecting thread
+            Unit nCost;
+            Unit nFitness;
+            Unit nScore;
+            ST_GENOMETERMINATION gaTermination;
+            ST_GENOMEREASON grTermination;
+            Description dsTermination;
+
+            GenomeSnapshotSRPtr spSnapshot;   ///< Validated genes (kept only while the consideration may be selected)
         };
         typedef std::vector< Consideration > CONSIDERATIONVECTOR;
 
         Consideration & _current();
         size_t _pickMutation();
 
+        void _evaluateConsiderations(const MUTATIONVECTOR & vecMutations, size_t iFirst, size_t iLast,
+                                     CONSIDERATIONVECTOR & considerations, bool & fFieldsMissing);
+        void _replayConsideration(Consideration & consideration);
+        void _recordPerformance(const Consideration & consideration);
+        void _takeSnapshot(Consideration & consideration, UNIT nBest);
+        void _pruneSnapshots(CONSIDERATIONVECTOR & considerations, NUMERICARRAY & vecSnapshots, UNIT nBest);
+
         Plan & _plan;
 
         CONSIDERATIONVECTOR _considerations;
+        NUMERICARRAY _vecSnapshots;           ///< Indexes of considerations holding snapshots
         bool _fFieldsMissing;
         bool _fAcceptedMutation;
         bool _fSingleMutation;
+        bool _fBest;                          ///< A consideration has set the best performance
         UNIT _best;
     };
 	
@@ -585,6 +623,7 @@ namespace org_biologicinstitute_stylus
 	class Plan
 	{
 		friend class PlanScope;
+		friend class Speculation;
 
 	public:
 		Plan();
@@ -597,6 +636,7 @@ namespace org_biologicinstitute_stylus
 		bool evaluateCondition(PLANCONDITION pc, UNIT nValue, bool fFinal);
         UNIT evaluatePerformance();
         bool evaluateConditions(bool fFinal);
+        bool evaluateConditions(UNIT nCost, UNIT nFitness, UNIT nScore, bool fFinal);
         bool applyMutation(Mutation & mutation);
 		
 		void load(const char* pxmlPlan);
@@ -604,6 +644,20 @@ namespace org_biologicinstitute_stylus
 
 		size_t getActualTrialCount(size_t cTrials, size_t iTrialFirst);
         UNIT getPerformancePrecision();
+		void boundScoring(UNIT nBest);
+
+		size_t getFitnessCache() const;
+		size_t getSpeculativeAttempts() const;
+		ATTEMPTHISTORY getAttemptHistory() const;
+		size_t getAttemptHistorySize() const;
+		size_t getPopulation() const;
+		size_t getMigrationInterval() const;
+		UNIT getTemperatureRatio() const;
+
+		UNIT getTemperature();
+		void scaleTemperatures(UNIT nFactor);
+		void resetAnnealing();
+		void adoptConditions(const Plan& plan);
 
 	private:
 		bool _fExecuting;					///< Plan is actively executing
@@ -615,6 +669,11 @@ namespace org_biologicinstitute_stylus
 		bool _fEnsureInFrame;
 		bool _fEnsureWholeCodons;
 		bool _fRejectSilent;
+		size_t _cFitnessCache;				///< Genome scores to cache (zero disables the cache)
+		size_t _cSpeculativeAttempts;		///< Attempts to evaluate at once (zero disables speculation)
+		bool _fBoundScores;					///< Stop scoring considerations once they cannot be selected
+		ATTEMPTHISTORY _ahRetention;		///< Failed attempts (and considerations) to retain
+		size_t _cAttemptHistory;			///< Attempts to retain when keeping the last or a sample
 
 		TrialConditions _tc;
 
@@ -623,6 +682,10 @@ namespace org_biologicinstitute_stylus
 		RollbackTerminationCondition _rc;
 		FitnessTerminationCondition _fc;
 
+		size_t _cPopulation;				///< Number of lineages to evolve
+		size_t _cMigrationInterval;			///< Trials between migrations (zero disables migration)
+		UNIT _nTemperatureRatio;			///< Temperature ratio of successive lineages (zero disables replica exchange)
+
 		size_t _iStep;
 		STEPARRAY _vecSteps;
 		
@@ -635,6 +698,7 @@ namespace org_biologicinstitute_stylus
 		size_t getMutationsPerAttempt() ;
         bool evaluatePerformance(PLANCONDITION pc, UNIT nValue, UNIT & nOutput);
         void produceMutations(MutationSource & source, MutationSelector & selector);
+        bool executeAttempt(MutationSelector & mutationSelector, STFLAGS grfOptions, size_t iTrialInStep);
         UNIT getPerformancePrecision(PLANCONDITION pc);
         TrialCondition * getTrialCondition(PLANCONDITION pc);
         TrialCondition * getTrialCondition(PLANCONDITION pc, size_t iStep);
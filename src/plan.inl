@@ -64,6 +64,10 @@ inline TrialCondition& TrialCondition::operator=(const TrialCondition& tc)
 	_tcm = tc._tcm;
 	_vecValues = tc._vecValues;
 
+	_nTemperature = tc._nTemperature;
+	_nCooling = tc._nCooling;
+	_iAttemptAccepted = tc._iAttemptAccepted;
+
 	_xt = tc._xt;
 	_stgr = tc._stgr;
 	
@@ -74,6 +78,10 @@ inline void TrialCondition::clear()
 {
 	_tcm = TCM_NONE;
 	_vecValues.clear();
+
+	_nTemperature = 0.0;
+	_nCooling = 1.0;
+	_iAttemptAccepted = 0;
 }
 
 inline bool TrialCondition::active() const
@@ -81,6 +89,12 @@ inline bool TrialCondition::active() const
     return _tcm != TCM_NONE;
 }
 
+inline bool TrialCondition::isIncreasing() const { return (_tcm == TCM_INCREASE); }
+inline bool TrialCondition::isAnnealing() const { return (_nTemperature > 0.0); }
+inline UNIT TrialCondition::getTemperature() const { return _nTemperature * ::pow(_nCooling, static_cast<UNIT>(Genome::getTrial())); }
+inline void TrialCondition::scaleTemperature(UNIT nFactor) { _nTemperature *= nFactor; }
+inline void TrialCondition::resetAnnealing(UNIT nValue) { if (isAnnealing()) _vecValues[0].setValue(nValue); }
+
 
 //--------------------------------------------------------------------------------
 //
@@ -141,6 +155,7 @@ inline void MutationTrialCondition::clear()
 {
 	_vecMutationsPerAttempt.clear();
 	_vecMutationsPerAttempt.push_back(MutationsPerAttempt());
+	_fExhaustive = false;
 }
 
 //--------------------------------------------------------------------------------
@@ -200,6 +215,13 @@ inline size_t TrialConditions::getMutationsPerAttempt() const { return _mc.getMu
 inline void TrialConditions::produceMutations(MutationSource & source, MutationSelector & selector) { _mc.produceMutations(source, selector); }
 inline const MutationTrialCondition * TrialConditions::getMutationTrialCondition() const { return &_mc; }
 
+inline void TrialConditions::scaleTemperatures(UNIT nFactor)
+{
+	_cc.scaleTemperature(nFactor);
+	_fc.scaleTemperature(nFactor);
+	_sc.scaleTemperature(nFactor);
+}
+
 
 //--------------------------------------------------------------------------------
 //
@@ -234,12 +256,12 @@ inline RollbackTerminationCondition::RollbackTerminationCondition() { clear(); }
 	
 inline void RollbackTerminationCondition::clear()
 {
-	_cRollbacks = Genome::getBases().length();
+	_cRollbacks = Genome::getBaseSequence().length();
 }
 
 inline void RollbackTerminationCondition::initialize()
 {
-	_cRollbacks = Genome::getBases().length();
+	_cRollbacks = Genome::getBaseSequence().length();
 }
 
 //--------------------------------------------------------------------------------
@@ -358,7 +380,7 @@ inline StepMutation::StepMutation(const StepMutation& sm) { operator=(sm); }
 inline StepMutation& StepMutation::operator=(const StepMutation& sm)
 {
 	_nLikelihood = sm._nLikelihood;
-	Mutation::operator=(*this);
+	Mutation::operator=(sm);
 	return *this;
 }
 
@@ -394,6 +416,8 @@ inline size_t Step::getMutationsPerAttempt() const { return _tc.getMutationsPerA
 inline void Step::produceMutations(MutationSource & source, MutationSelector & selector) { _tc.produceMutations(source, selector); }
 inline TrialCondition * Step::getTrialCondition(PLANCONDITION pc) { return _tc.getTrialCondition(pc); }
 inline const MutationTrialCondition * Step::getMutationTrialCondition() const { return _tc.getMutationTrialCondition(); }
+inline void Step::scaleTemperatures(UNIT nFactor) { _tc.scaleTemperatures(nFactor); }
+inline void Step::adoptConditions(const Step& st) { _tc = st._tc; }
 
 //--------------------------------------------------------------------------------
 //
@@ -406,6 +430,14 @@ inline void Plan::clear() { initialize(); }
 
 inline bool Plan::isExecuting() const { return _fExecuting; }
 
+inline size_t Plan::getFitnessCache() const { return _cFitnessCache; }
+inline size_t Plan::getSpeculativeAttempts() const { return _cSpeculativeAttempts; }
+inline ATTEMPTHISTORY Plan::getAttemptHistory() const { return _ahRetention; }
+inline size_t Plan::getAttemptHistorySize() const { return _cAttemptHistory; }
+inline size_t Plan::getPopulation() const { return _cPopulation; }
+inline size_t Plan::getMigrationInterval() const { return _cMigrationInterval; }
+inline UNIT Plan::getTemperatureRatio() const { return _nTemperatureRatio; }
+
 inline TrialCondition * Plan::getTrialCondition(PLANCONDITION pc, size_t iStep)
 {
     if(!_vecSteps.empty() && _vecSteps[iStep].hasConditions(pc) )
@@ -538,7 +570,9 @@ inline MutationSelector::Consideration & MutationSelector::_current()
 }
 
 inline MutationSelector::Consideration::Consideration():
-    fValidMutations(true)
+    fValidMutations(true),
+    gaTermination(STGT_NONE),
+    grTermination(STGR_NONE)
 {
 }
 
@@ -30,9 +30,11 @@
 
 // Standard C/C++ ---------------------------------------------------------------
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cctype>
 #include <cmath>
+#include <condition_variable>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
@@ -42,18 +44,23 @@
 #include <deque>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <ostream>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #if defined(ST_PROFILE) and defined(ST_MACOSX)
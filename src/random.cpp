@@ -28,7 +28,8 @@ using namespace stylus;
 // RGenerator
 //
 //--------------------------------------------------------------------------------
-IRandom* RGenerator::s_prgen = NULL;
+thread_local IRandom* RGenerator::s_prgen = NULL;
+std::string RGenerator::s_strUUID;
 
 /*
  * Function: initialize
@@ -40,10 +41,8 @@ RGenerator::initialize(const std::string& strUUID)
 	ENTER(GLOBAL,initialize);
 	ASSERT(!EMPTYSTR(strUUID));
 
-	if (strUUID == RandomC::s_strUUID)
-		s_prgen = ::new RandomC();
-	else
-		THROWRC((RC(BADARGUMENTS), "%s does not identify a known Random Generator", strUUID.c_str()));
+	s_prgen = createInstance(strUUID);
+	s_strUUID = strUUID;
 }
 
 /*
@@ -56,6 +55,82 @@ RGenerator::terminate()
 	ENTER(GLOBAL,terminate);
 
 	::delete s_prgen;
+	s_prgen = NULL;
+}
+
+/*
+ * Function: initializeThread
+ *
+ */
+void
+RGenerator::initializeThread()
+{
+	ENTER(GLOBAL,initializeThread);
+	ASSERT(!EMPTYSTR(s_strUUID));
+
+	if (!VALID(s_prgen))
+		s_prgen = createInstance(s_strUUID);
+}
+
+/*
+ * Function: createInstance
+ *
+ * Create a new instance of the active random generator (or, if the calling
+ * thread has none, of that selected during initialization).
+ */
+IRandom*
+RGenerator::createInstance()
+{
+	ENTER(GLOBAL,createInstance);
+	ASSERT(!EMPTYSTR(s_strUUID));
+	return createInstance(VALID(s_prgen) ? s_prgen->getUUID() : s_strUUID);
+}
+
+/*
+ * Function: createInstance
+ *
+ * Create a new instance of the random generator identified by the passed
+ * UUID.
+ */
+IRandom*
+RGenerator::createInstance(const std::string& strUUID)
+{
+	ENTER(GLOBAL,createInstance);
+
+	IRandom* prgen = NULL;
+	if (strUUID == RandomC::s_strUUID)
+		prgen = ::new RandomC();
+	else if (strUUID == Philox::s_strUUID)
+		prgen = ::new Philox();
+	else
+		THROWRC((RC(BADARGUMENTS), "%s does not identify a known Random Generator", strUUID.c_str()));
+	return prgen;
+}
+
+/*
+ * Function: createStream
+ *
+ * Create a generator for the named substream of the active generator.
+ */
+IRandom*
+RGenerator::createStream(const std::string& strStream)
+{
+	ENTER(GLOBAL,createStream);
+	ASSERT(s_prgen);
+	return s_prgen->createStream(strStream);
+}
+
+/*
+ * Function: exchangeInstance
+ *
+ * Exchange the active random generator of the calling thread with the passed
+ * generator.
+ */
+void
+RGenerator::exchangeInstance(IRandom*& prgen)
+{
+	ENTER(GLOBAL,exchangeInstance);
+	std::swap(s_prgen, prgen);
 }
 
 /*
@@ -74,6 +149,16 @@ RGenerator::loadSeed(XMLDocument* pxd, xmlNodePtr pxnSeed)
 	string strValue;
 	pxd->getContent(pxnSeed, strValue);
 
+	// Switch generators if the seed belongs to another
+	string strUUID;
+	pxd->getAttribute(pxnSeed, xmlTag(XT_PROCESSORID), strUUID);
+	if (!EMPTYSTR(strUUID) && strUUID != s_prgen->getUUID())
+	{
+		IRandom* prgen = createInstance(strUUID);
+		exchangeInstance(prgen);
+		::delete prgen;
+	}
+
 	TDATA(GLOBAL,L2,(LLTRACE, "Initializing random generator with seed \"%s\"", strValue.c_str()));
 	s_prgen->setSeed(strValue);
 }
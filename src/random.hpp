@@ -47,6 +47,16 @@ namespace org_biologicinstitute_stylus
 		 *
 		 */
 		virtual const std::string& getUUID() throw() = 0;
+
+		/**
+		 * \brief Create a generator for the named substream
+		 * \param[in] strStream Name of the substream
+		 *
+		 * Substreams derive from the current state and the name alone;
+		 * creating one leaves this generator unchanged. Differently named
+		 * substreams produce independent series of numbers.
+		 */
+		virtual IRandom* createStream(const std::string& strStream) const = 0;
 		
 		/**
 		 * \brief Initialize the random number seed from the passed string
@@ -77,6 +87,17 @@ namespace org_biologicinstitute_stylus
 		 */
 		virtual long getUniform(long nLow, long nHigh) = 0;
 
+		/**
+		 * \brief Fill an array with uniformly distributed integer random numbers within the range
+		 * \param[in] nLow Low end of the range (inclusive)
+		 * \param[in] nHigh High end of the range (inclusive)
+		 * \param[out] aryValues Array to fill
+		 * \param[in] cValues Number of values to generate
+		 * \remarks
+		 * - The values are those that as many calls to getUniform(nLow, nHigh) return
+		 */
+		virtual void getUniform(long nLow, long nHigh, long* aryValues, size_t cValues) = 0;
+
 		/**
 		 * \brief Generate a uniformly distributed real random number between 0 and 1
 		 * \remarks
@@ -104,6 +125,28 @@ namespace org_biologicinstitute_stylus
 		static void initialize(const std::string& strUUID);
 		static void terminate();
 
+		/**
+		 * \brief Create the random generator of a calling thread that has none
+		 *
+		 * The generator is of the type selected during initialization.
+		 */
+		static void initializeThread();
+
+		/**
+		 * \brief Create and exchange generator instances
+		 *
+		 * Each engine owns a generator instance of the type selected during
+		 * initialization (or by the last seed loaded on the calling thread);
+		 * binding an engine to a thread makes its instance the active generator
+		 * for that thread. Substreams are created from the active generator.
+		 */
+		//{@
+		static IRandom* createInstance();
+		static IRandom* createInstance(const std::string& strUUID);
+		static IRandom* createStream(const std::string& strStream);
+		static void exchangeInstance(IRandom*& prgen);
+		//@}
+
 		/**
 		 * \brief Methods that statically reroute to the active random generator
 		 *
@@ -118,11 +161,13 @@ namespace org_biologicinstitute_stylus
 
 		static UNIT getUniform(UNIT nLow, UNIT nHigh);
 		static long getUniform(long nLow, long nHigh);
+		static void getUniform(long nLow, long nHigh, long* aryValues, size_t cValues);
 		static UNIT getUniform();
 		//@}
 
 	private:
-		static IRandom* s_prgen;				///< Active random generator
+		static thread_local IRandom* s_prgen;	///< Active random generator (per thread)
+		static std::string s_strUUID;			///< UUID of the selected random generator
 	};
 
 }	// namespace org_biologicinstitute_stylus
@@ -33,5 +33,6 @@ inline void RGenerator::getSeed(XMLStream& xs, STFLAGS grfRecordDetail) { ASSERT
 
 inline UNIT RGenerator::getUniform(UNIT nLow, UNIT nHigh) { ASSERT(s_prgen); return s_prgen->getUniform(nLow,nHigh); }
 inline long RGenerator::getUniform(long nLow, long nHigh) { ASSERT(s_prgen); return s_prgen->getUniform(nLow,nHigh); }
+inline void RGenerator::getUniform(long nLow, long nHigh, long* aryValues, size_t cValues) { ASSERT(s_prgen); s_prgen->getUniform(nLow,nHigh,aryValues,cValues); }
 inline UNIT RGenerator::getUniform() { ASSERT(s_prgen); return s_prgen->getUniform(); }
 
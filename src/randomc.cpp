@@ -58,6 +58,21 @@ RandomC::getUUID() throw()
 	return s_strUUID;
 }
 
+/*
+ * Function: createStream
+ *
+ * The substream is seeded with the current seed followed by the passed name.
+ */
+IRandom*
+RandomC::createStream(const std::string& strStream) const
+{
+	ENTER(GLOBAL,createStream);
+
+	RandomC* prandomc = ::new RandomC();
+	prandomc->setSeed(getSeed() + strStream);
+	return prandomc;
+}
+
 /*
  * Function: setSeed
  *
@@ -105,6 +120,15 @@ RandomC::getUniform(long nLow, long nHigh)
 	return static_cast<long>(_pmersenne->IRandomX(static_cast<int>(nLow), static_cast<int>(nHigh)));
 }
 
+void
+RandomC::getUniform(long nLow, long nHigh, long* aryValues, size_t cValues)
+{
+	ASSERT(nLow <= nHigh);
+	ASSERT(VALID(aryValues) || cValues == 0);
+	for (size_t iValue=0; iValue < cValues; ++iValue)
+		aryValues[iValue] = static_cast<long>(_pmersenne->IRandomX(static_cast<int>(nLow), static_cast<int>(nHigh)));
+}
+
 UNIT
 RandomC::getUniform()
 {
@@ -39,7 +39,7 @@ namespace org_biologicinstitute_stylus
 	public:
 		static const std::string s_strUUID;		///< UUID used to request RandomC
 
-		inline virtual ~RandomC() {};
+		inline virtual ~RandomC() { ::delete _pmersenne; };
 
 		/**
 		 * \brief Implementation of IRandom (see IRandom for details)
@@ -48,11 +48,14 @@ namespace org_biologicinstitute_stylus
 		//{@
 		virtual const std::string& getUUID() throw();
 
+		virtual IRandom* createStream(const std::string& strStream) const;
+
 		virtual void setSeed(const std::string& strSeed);
 		virtual std::string getSeed() const;
 		virtual void getSeed(XMLStream& xs, STFLAGS grfRecordDetail) const;
 
 		virtual long getUniform(long nLow, long nHigh);
+		virtual void getUniform(long nLow, long nHigh, long* aryValues, size_t cValues);
 		virtual UNIT getUniform();
 		//@}
 	};
@@ -167,7 +167,7 @@ class CRandomMersenne {                // Encapsulate random number generator
 
 public:
    CRandomMersenne(int seed) {         // Constructor
-      RandomInit(seed); LastInterval = 0;}
+      RandomInit(seed); LastInterval = 0; RLimit = 0;}
    void RandomInit(int seed);          // Re-seed
    void RandomInitByArray(int const seeds[], int NumSeeds); // Seed by more than 32 bits
    int IRandom (int min, int max);     // Output random integer
@@ -57,10 +57,17 @@ using namespace stylus;
  * cannot be a maximum deviated point and the maximum may occur at either a stroke
  * or Han vertex).
  * 
+ * The Han points are taken either forward or reversed: By default, whichever
+ * yields the smaller deviation (both are measured in one walk over the stroke
+ * points); with the "endpoints" stroke orientation global, whichever lies closer
+ * to the stroke at its end points (see determineStrokeOrientation).
+ * 
  * NOTE:
  * - Since the pre-computed points of the Gene are not scaled (and cannot be as
  *   scaling is a feature of a child element), scaling *must* be applied to the
  *   sums rather than accumulating scaled lengths.
+ * - Deviation is measured by measureDeviation; debug builds also walk the points
+ *   directly (see walkDeviation) and compare the outcome.
  */
 bool
 Stroke::calcScore(Gene& gene, const HStroke& hst)
@@ -81,30 +88,263 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 	Unit nStrokeLength = _slVectors.getLength();
 	_nExtraLength = max<UNIT>(0, (nStrokeLength - hst.getLength()));
 
-	// Obtain the Han points (forward or reversed) that best fit the stroke
-	const HPOINTARRAY& vecHPoints = determineStrokeOrientation(gene, hst);
+	// Measure the maximum (square) deviation against the Han points (forward or reversed)
+	// - Either those yielding the smaller deviation or those that best fit the stroke at its end points
+	Unit nSquareDeviation;
+	DEVIATIONMEASURE dm;
+	if (Globals::isStrokeOrientationMode(SOM_DEVIATION))
+		dm = measureDeviation(gene, hst, nSquareDeviation);
+	else
+	{
+		const HPath& hpath = determineStrokeOrientation(gene, hst);
+
+		// Debug builds also walk the points directly and compare the outcome
+		dm = measureDeviation(gene, hpath, nSquareDeviation);
+#if defined(ST_DEBUG)
+		Unit nSquareDeviationWalked;
+		ASSERT(walkDeviation(gene, hpath, nSquareDeviationWalked) == dm);
+		ASSERT(static_cast<UNIT>(nSquareDeviationWalked) == static_cast<UNIT>(nSquareDeviation));
+#endif
+	}
+	_nDeviation = nSquareDeviation;
+
+	// Ensure comparison occurred at all points
+	if (dm == DM_NOHANPOINTS)
+	{
+		Genome::recordAttempt(ST_FILELINE, STTR_SCORING, "Stroke %ld ran out of Han points during deviation measure", (_id+1));
+		Genome::recordTermination(NULL, STGT_SCORE, STGR_STROKE, "Stroke %ld ran out of Han points during deviation measure", (_id+1));
+		return false;
+	}
+	if (dm == DM_NOPOINTS)
+	{
+		Genome::recordAttempt(ST_FILELINE, STTR_SCORING, "Stroke %ld ran out of points during deviation measure", (_id+1));
+		Genome::recordTermination(NULL, STGT_SCORE, STGR_STROKE, "Stroke %ld ran out of points during deviation measure", (_id+1));
+		return false;
+	}
+
+	_nDeviation = ::sqrt(_nDeviation);
+	TDATA(SCORING,L5,(LLTRACE, ""));
+	return true;
+}
+
+/*
+ * Function: determineStrokeOrientation
+ *
+ * The orientation selected, forward or reverse, is that which yields the smallest
+ * deviation at the end points.
+ */
+const HPath&
+Stroke::determineStrokeOrientation(const Gene& gene, const HStroke& hst)
+{
+	Point ptStart(gene.getPoint(_rgAcids.getStart()-1));
+	ptStart.scale(_sxToHan, _syToHan);
+	ptStart.move(_dxToHan, _dyToHan);
+
+	Point ptEnd(gene.getPoint(_rgAcids.getEnd()));
+	ptEnd.scale(_sxToHan, _syToHan);
+	ptEnd.move(_dxToHan, _dyToHan);
+
+	const HPOINTARRAY& vecHPointsForward = hst.getPointsForward();
+	Unit nDeviationForward = vecHPointsForward[0].squareDeviationFrom(ptStart);
+	nDeviationForward += vecHPointsForward[vecHPointsForward.size()-1].squareDeviationFrom(ptEnd);
+
+	const HPOINTARRAY& vecHPointsReverse = hst.getPointsReverse();
+	Unit nDeviationReverse = vecHPointsReverse[0].squareDeviationFrom(ptStart);
+	nDeviationReverse += vecHPointsReverse[vecHPointsReverse.size()-1].squareDeviationFrom(ptEnd);
+
+	TDATA(SCORING,L4,(LLTRACE,
+					"Stroke %ld is %s relative to the Han (length %6.9f)",
+					(_id+1),
+					(nDeviationForward < nDeviationReverse ? "forward" : "reverse"),
+					hst.getLength()));
+
+	return (nDeviationForward < nDeviationReverse
+			? hst.getPathForward()
+			: hst.getPathReverse());
+}
+
+/*
+ * Function: measureDeviation
+ *
+ * Walk the stroke and Han points together, measuring deviation at each point as
+ * it is reached. The Han points are read from the coordinate and distance arrays
+ * of the path and the stroke points are moved into Han coordinates as plain values,
+ * so no intermediate point objects are built and the values being compared stay
+ * in registers.
+ *
+ * NOTE:
+ * - The comparisons and arithmetic match those of walkDeviation exactly, so both
+ *   yield identical deviations
+ */
+Stroke::DEVIATIONMEASURE
+Stroke::measureDeviation(const Gene& gene, const HPath& hpath, Unit& nSquareDeviation) const
+{
+	ENTER(SCORING,measureDeviation);
+
+	ASSERT(_rgAcids.getStart() > 0);
+
+	// Obtain the stroke points
+	// Note: Points contain the value *after* vector application; the first point is the one prior to the initial acid
+	const ACIDTYPEARRAY& vecAcids = gene.getAcids();
+	const UNITARRAY& vecX = gene.getX();
+	const UNITARRAY& vecY = gene.getY();
+	long iPoint = _rgAcids.getStart()-1;
+
+	const UNIT sx = _sxToHan;
+	const UNIT sy = _syToHan;
+	const UNIT dxToHan = _dxToHan;
+	const UNIT dyToHan = _dyToHan;
+	const UNIT nStrokeLength = _slVectors.getLength();
+	ScaledLength slTraversed(_sxToHan, _syToHan, _sxyToHan);
+
+	UNIT xPrev = (vecX[iPoint] * sx) + dxToHan;
+	UNIT yPrev = (vecY[iPoint] * sy) + dyToHan;
+	UNIT dPrev = 0;
+
+	DeviationWalk dw(hpath, xPrev, yPrev);
+
+	for (++iPoint; iPoint <= _rgAcids.getEnd() && dw.isWalking(); ++iPoint)
+	{
+		ASSERT(static_cast<size_t>(iPoint) < vecX.size());
+		slTraversed += vecAcids[iPoint];
+
+		UNIT x = (vecX[iPoint] * sx) + dxToHan;
+		UNIT y = (vecY[iPoint] * sy) + dyToHan;
+		UNIT d = slTraversed.getLength();
+
+		dw.measure(nStrokeLength, xPrev, yPrev, dPrev, x, y, d);
+
+		xPrev = x;
+		yPrev = y;
+		dPrev = d;
+	}
+
+	nSquareDeviation = dw.getSquareDeviation();
+	return dw.getOutcome();
+}
+
+/*
+ * Function: measureDeviation
+ *
+ * Measure deviation against both the forward and reverse Han points, keeping
+ * that of the orientation yielding the smaller deviation (preferring one measured
+ * at every point). Both orientations are measured in a single walk over the
+ * stroke points, each stroke point being moved into Han coordinates just once.
+ */
+Stroke::DEVIATIONMEASURE
+Stroke::measureDeviation(const Gene& gene, const HStroke& hst, Unit& nSquareDeviation) const
+{
+	ENTER(SCORING,measureDeviation);
+
+	ASSERT(_rgAcids.getStart() > 0);
+
+	DEVIATIONMEASURE dmForward;
+	DEVIATIONMEASURE dmReverse;
+	Unit nSquareDeviationForward;
+	Unit nSquareDeviationReverse;
+
+	// Obtain the stroke points
+	// Note: Points contain the value *after* vector application; the first point is the one prior to the initial acid
+	const ACIDTYPEARRAY& vecAcids = gene.getAcids();
+	const UNITARRAY& vecX = gene.getX();
+	const UNITARRAY& vecY = gene.getY();
+	long iPoint = _rgAcids.getStart()-1;
+
+	const UNIT sx = _sxToHan;
+	const UNIT sy = _syToHan;
+	const UNIT dxToHan = _dxToHan;
+	const UNIT dyToHan = _dyToHan;
+	const UNIT nStrokeLength = _slVectors.getLength();
+	ScaledLength slTraversed(_sxToHan, _syToHan, _sxyToHan);
+
+	UNIT xPrev = (vecX[iPoint] * sx) + dxToHan;
+	UNIT yPrev = (vecY[iPoint] * sy) + dyToHan;
+	UNIT dPrev = 0;
+
+	DeviationWalk dwForward(hst.getPathForward(), xPrev, yPrev);
+	DeviationWalk dwReverse(hst.getPathReverse(), xPrev, yPrev);
+
+	for (++iPoint; iPoint <= _rgAcids.getEnd() && (dwForward.isWalking() || dwReverse.isWalking()); ++iPoint)
+	{
+		ASSERT(static_cast<size_t>(iPoint) < vecX.size());
+		slTraversed += vecAcids[iPoint];
+
+		UNIT x = (vecX[iPoint] * sx) + dxToHan;
+		UNIT y = (vecY[iPoint] * sy) + dyToHan;
+		UNIT d = slTraversed.getLength();
+
+		if (dwForward.isWalking())
+			dwForward.measure(nStrokeLength, xPrev, yPrev, dPrev, x, y, d);
+		if (dwReverse.isWalking())
+			dwReverse.measure(nStrokeLength, xPrev, yPrev, dPrev, x, y, d);
+
+		xPrev = x;
+		yPrev = y;
+		dPrev = d;
+	}
+
+	dmForward = dwForward.getOutcome();
+	dmReverse = dwReverse.getOutcome();
+	nSquareDeviationForward = dwForward.getSquareDeviation();
+	nSquareDeviationReverse = dwReverse.getSquareDeviation();
+
+#if defined(ST_DEBUG)
+	Unit nSquareDeviationWalked;
+	ASSERT(walkDeviation(gene, hst.getPathForward(), nSquareDeviationWalked) == dmForward);
+	ASSERT(static_cast<UNIT>(nSquareDeviationWalked) == static_cast<UNIT>(nSquareDeviationForward));
+	ASSERT(walkDeviation(gene, hst.getPathReverse(), nSquareDeviationWalked) == dmReverse);
+	ASSERT(static_cast<UNIT>(nSquareDeviationWalked) == static_cast<UNIT>(nSquareDeviationReverse));
+#endif
+
+	bool fForward = (dmForward == DM_MEASURED
+					&& (dmReverse != DM_MEASURED
+						|| static_cast<UNIT>(nSquareDeviationForward) < static_cast<UNIT>(nSquareDeviationReverse)));
+
+	TDATA(SCORING,L4,(LLTRACE,
+					"Stroke %ld is %s relative to the Han (square deviation forward %6.9f, reverse %6.9f)",
+					(_id+1),
+					(fForward ? "forward" : "reverse"),
+					static_cast<UNIT>(nSquareDeviationForward),
+					static_cast<UNIT>(nSquareDeviationReverse)));
+
+	nSquareDeviation = (fForward ? nSquareDeviationForward : nSquareDeviationReverse);
+	return (fForward ? dmForward : dmReverse);
+}
+
+#ifdef ST_DEBUG
+/*
+ * Function: walkDeviation
+ *
+ * Walk the stroke and Han points together, measuring deviation at each point as
+ * it is reached. Debug builds check measureDeviation against it.
+ */
+Stroke::DEVIATIONMEASURE
+Stroke::walkDeviation(const Gene& gene, const HPath& hpath, Unit& nSquareDeviation) const
+{
+	ENTER(SCORING,walkDeviation);
+
+	Unit nStrokeLength = _slVectors.getLength();
 	size_t iHPoint = 0;
 
 	// Obtain the stroke points
 	// Note: Points contain the value *after* vector application; the first point is the one prior to the initial acid
 	ASSERT(_rgAcids.getStart() > 0);
 	const ACIDTYPEARRAY& vecAcids = gene.getAcids();
-	const POINTARRAY& vecPoints = gene.getPoints();
 	ScaledLength slTraversed(_sxToHan, _syToHan, _sxyToHan);
 	long iPoint = _rgAcids.getStart()-1;
 
 	// Walk the stroke points and midpoints measuring deviation
 	// - Track maximum deviation for stroke and Han points
 
-	PointDistance ptdPrev(vecPoints[iPoint]);
+	PointDistance ptdPrev(gene.getPoint(iPoint));
 	ptdPrev.scale(_sxToHan, _syToHan);
 	ptdPrev.move(_dxToHan, _dyToHan);
 
-	ASSERT(iHPoint < vecHPoints.size());
+	ASSERT(iHPoint < hpath.size());
 	
-	HPoint hptPrev(vecHPoints[iHPoint]);
+	HPoint hptPrev(hpath.getPoint(iHPoint));
 	Unit nDeviation = hptPrev.squareDeviationFrom(ptdPrev);
-	_nDeviation = nDeviation;
+	nSquareDeviation = nDeviation;
 	++iHPoint;
 
 	TDATA(SCORING,L5,(LLTRACE,
@@ -114,13 +354,13 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 					static_cast<UNIT>(hptPrev.x()), static_cast<UNIT>(hptPrev.y()),
 					static_cast<UNIT>(nDeviation)));
 
-	for (++iPoint; iPoint <= _rgAcids.getEnd() && iHPoint < vecHPoints.size(); ++iPoint)
+	for (++iPoint; iPoint <= _rgAcids.getEnd() && iHPoint < hpath.size(); ++iPoint)
 	{
 		ASSERT(Unit(ptdPrev.getDistance()) == slTraversed.getLength());
 		slTraversed += vecAcids[iPoint];
 
-		ASSERT(static_cast<size_t>(iPoint) < vecPoints.size());
-		PointDistance ptdEndpoint(vecPoints[iPoint], slTraversed.getLength());
+		ASSERT(static_cast<size_t>(iPoint) < gene.getX().size());
+		PointDistance ptdEndpoint(gene.getPoint(iPoint), slTraversed.getLength());
 		ptdEndpoint.scale(_sxToHan, _syToHan);
 		ptdEndpoint.move(_dxToHan, _dyToHan);
 		
@@ -128,7 +368,7 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 		// - Distance on stroke points is total (scaled) vector distance
 		// - Distance on Han points is the fractional distance
 		Unit dTraversedCurrent = ptdEndpoint.getDistance() / nStrokeLength;
-		HPoint hptEndpoint(vecHPoints[iHPoint]);
+		HPoint hptEndpoint(hpath.getPoint(iHPoint));
 			
 		// Measure against all Han points occurring before the point under evaluation
 		// - This loop terminates with the Han point at or beyond the current stroke point
@@ -137,7 +377,7 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 			Unit dProportion = ((nStrokeLength * hptEndpoint.getDistance()) - ptdPrev.getDistance()) / (ptdEndpoint.getDistance() - ptdPrev.getDistance());
 			PointDistance ptd(getPointBetween(ptdPrev, ptdEndpoint, dProportion));
 			nDeviation = hptEndpoint.squareDeviationFrom(ptd);
-			_nDeviation = max<UNIT>(_nDeviation, nDeviation);
+			nSquareDeviation = max<UNIT>(nSquareDeviation, nDeviation);
 
 			TDATA(SCORING,L5,(LLTRACE,
 							"DEVIATION (%0.6f): stroke(%6.9f,%6.9f) han(%6.9f,%6.9f) max-deviation(%6.9f)",
@@ -147,9 +387,9 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 							static_cast<UNIT>(nDeviation)));
 
 			hptPrev = hptEndpoint;
-			if (++iHPoint >= vecHPoints.size())
+			if (++iHPoint >= hpath.size())
 				goto CHECKPOINTS;
-			hptEndpoint = vecHPoints[iHPoint];
+			hptEndpoint = hpath.getPoint(iHPoint);
 		}
 
 		// Measure deviation at the stroke point
@@ -160,7 +400,7 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 						? getPointBetween(hptPrev, hptEndpoint, (dTraversedCurrent - hptPrev.getDistance()) / (hptEndpoint.getDistance() - hptPrev.getDistance()))
 						: hptEndpoint);
 		nDeviation = hptCurrent.squareDeviationFrom(ptdEndpoint);
-		_nDeviation = max<UNIT>(_nDeviation, nDeviation);
+		nSquareDeviation = max<UNIT>(nSquareDeviation, nDeviation);
 
 		TDATA(SCORING,L5,(LLTRACE,
 						"DEVIATION (%0.6f): stroke(%6.9f,%6.9f) han(%6.9f,%6.9f) deviation(%6.9f)",
@@ -182,61 +422,13 @@ Stroke::calcScore(Gene& gene, const HStroke& hst)
 
 	// Ensure comparison occurred at all points
 CHECKPOINTS:
-	if (iHPoint > vecHPoints.size() && iPoint <= _rgAcids.getEnd())
-	{
-		Genome::recordAttempt(ST_FILELINE, STTR_SCORING, "Stroke %ld ran out of Han points during deviation measure", (_id+1));
-		Genome::recordTermination(NULL, STGT_SCORE, STGR_STROKE, "Stroke %ld ran out of Han points during deviation measure", (_id+1));
-		return false;
-	}
-	if (iPoint > _rgAcids.getEnd() && iHPoint < vecHPoints.size())
-	{
-		Genome::recordAttempt(ST_FILELINE, STTR_SCORING, "Stroke %ld ran out of points during deviation measure", (_id+1));
-		Genome::recordTermination(NULL, STGT_SCORE, STGR_STROKE, "Stroke %ld ran out of points during deviation measure", (_id+1));
-		return false;
-	}
-
-	_nDeviation = ::sqrt(_nDeviation);
-	TDATA(SCORING,L5,(LLTRACE, ""));
-	return true;
-}
-
-/*
- * Function: determineStrokeOrientation
- *
- * The orientation selected, forward or reverse, is that which yields the smallest
- * deviation at the end points.
- */
-const HPOINTARRAY&
-Stroke::determineStrokeOrientation(const Gene& gene, const HStroke& hst)
-{
-	const POINTARRAY& vecPoints = gene.getPoints();
-
-	Point ptStart(vecPoints[_rgAcids.getStart()-1]);
-	ptStart.scale(_sxToHan, _syToHan);
-	ptStart.move(_dxToHan, _dyToHan);
-
-	Point ptEnd(vecPoints[_rgAcids.getEnd()]);
-	ptEnd.scale(_sxToHan, _syToHan);
-	ptEnd.move(_dxToHan, _dyToHan);
-
-	const HPOINTARRAY& vecHPointsForward = hst.getPointsForward();
-	Unit nDeviationForward = vecHPointsForward[0].squareDeviationFrom(ptStart);
-	nDeviationForward += vecHPointsForward[vecHPointsForward.size()-1].squareDeviationFrom(ptEnd);
-
-	const HPOINTARRAY& vecHPointsReverse = hst.getPointsReverse();
-	Unit nDeviationReverse = vecHPointsReverse[0].squareDeviationFrom(ptStart);
-	nDeviationReverse += vecHPointsReverse[vecHPointsReverse.size()-1].squareDeviationFrom(ptEnd);
-
-	TDATA(SCORING,L4,(LLTRACE,
-					"Stroke %ld is %s relative to the Han (length %6.9f)",
-					(_id+1),
-					(nDeviationForward < nDeviationReverse ? "forward" : "reverse"),
-					hst.getLength()));
-
-	return (nDeviationForward < nDeviationReverse
-			? vecHPointsForward
-			: vecHPointsReverse);
+	return (iHPoint > hpath.size() && iPoint <= _rgAcids.getEnd()
+			? DM_NOHANPOINTS
+			: (iPoint > _rgAcids.getEnd() && iHPoint < hpath.size()
+			   ? DM_NOPOINTS
+			   : DM_MEASURED));
 }
+#endif
 
 //--------------------------------------------------------------------------------
 //
@@ -347,9 +539,14 @@ INVALID:
 /*
  * Function: calcScore
  *
+ * With the minimum group score mode, scoring stops once the minimum group score
+ * divided by the passed cost falls below the passed bound. The gene level elements
+ * only reduce the group score (when their weights are not negative), so the
+ * minimum so far bounds the final score and remaining groups, placement, and
+ * marks need not be measured.
  */
 bool
-Gene::calcScore()
+Gene::calcScore(UNIT nScoreBound, UNIT nCost)
 {
 	ENTER(SCORING,calcScore);
 	ASSERT(isInvalid(GI_SCORE));
@@ -373,9 +570,16 @@ Gene::calcScore()
 	Unit nyToHan = 0;
 	bool fSuccess = false;
 
+	bool fBounded = false;
 	if (Globals::isGroupScoreMode(GSM_MINIMUM))
+	{
 		scoreGroup.setToMax();
 
+		fBounded = (nScoreBound > 0);
+		for (size_t sc=0; fBounded && sc < SC_GENEMAX; ++sc)
+			fBounded = (Globals::getGeneWeight(static_cast<SCORECOMPONENT>(sc)) >= 0);
+	}
+
 	for (size_t iGroup=0; iGroup < _vecGroups.size(); ++iGroup)
 	{
 		const HGroup& hgrp = vecHGroups[iGroup];
@@ -396,6 +600,14 @@ Gene::calcScore()
 		{
 			ASSERT(Globals::isGroupScoreMode(GSM_MINIMUM));
 			scoreGroup = min<UNIT>(grp.score(), scoreGroup);
+
+			if (fBounded && Unit(scoreGroup / nCost) < nScoreBound)
+			{
+				TDATA(SCORING,L3,(LLTRACE, "Gene score bounded at %f after %ld of %ld groups", static_cast<UNIT>(scoreGroup), (iGroup+1), _vecGroups.size()));
+				_nScore = scoreGroup;
+				_fScoreBounded = true;
+				goto INVALID;
+			}
 		}
 
 		// Calculate gross error in scale factor consistency
@@ -10,7 +10,7 @@
  * contain \em genes corresponding to one or more Han glyphs. (See Stylus
  * documentation for full details.) The engine is designed to execute as
  * a task within a grid-network or cluster with one task per-CPU.
- * \par Stylus holds at most one genome whose state is represents the
+ * \par Each Stylus engine holds at most one genome whose state is represents the
  * active \em trial. Stylus moves from one trial to the next through a
  * sequence of mutation and validation.
  *
@@ -37,9 +37,18 @@
  * success, failure, and obtain the details of the last error.
  *
  * \section threads Thread Safety
- * \par Stylus is \em not thread-safe. Stylus is designed to be used as task within a
- * distributed grid. Nor does Stylus support mechanisms for even creating mutliple
- * genomes per process.
+ * \par A single Stylus engine is \em not thread-safe. Each engine holds one genome
+ * (along with its plan, statistics, random generator, and trace state) and may be
+ * driven by only one thread at a time. Callers wanting several genomes per process
+ * create additional engines (see stCreateEngine()) and bind each to the thread
+ * driving it (see stSetEngine()). A thread that does not bind an engine uses its
+ * own default genome and random generator, created on its first call into Stylus
+ * (or, for the caller, by stInitialize()); a genome set on one such thread is not
+ * visible to any other. Loaded Han definitions, XML schemas, and global values
+ * (see stSetGlobals()) are shared, read-only, by all engines and should be
+ * established before starting additional threads.
+ * \par Errors are recorded per-thread; stGetLastError() returns the last error
+ * raised on the calling thread.
  *
  * \section memory Memory Handling
  * \par When Stylus needs to return to the caller data of indeterminate size (e.g.,
@@ -218,6 +227,68 @@ extern "C" {
 	 */
 	ST_RETCODE stSetScope(const char* pszURLHan, const char* pszURLXMLSchema);
 
+	/**
+	 * \brief Opaque handle to a Stylus engine
+	 *
+	 * An engine holds one genome along with its plan, statistics, random generator,
+	 * and trace state. All genome routines (e.g., stSetGenome(), stExecutePlan())
+	 * operate on the engine bound to the calling thread.
+	 */
+	typedef struct ST_ENGINE* ST_HENGINE;
+
+	/**
+	 * \brief Create a new, empty engine
+	 *
+	 * The engine is not bound to any thread; use stSetEngine() to bind it.
+	 * 
+	 * \param[out] phEngine Pointer to location to receive the engine handle
+	 */
+	ST_RETCODE stCreateEngine(ST_HENGINE* phEngine);
+
+	/**
+	 * \brief Destroy an engine previously returned by stCreateEngine()
+	 *
+	 * The engine must not be executing a plan nor be bound to any thread other
+	 * than the caller. If bound to the calling thread, the thread reverts to its
+	 * default genome.
+	 * 
+	 * \param[in] hEngine Handle of the engine to destroy
+	 */
+	ST_RETCODE stDestroyEngine(ST_HENGINE hEngine);
+
+	/**
+	 * \brief Bind an engine to the calling thread
+	 *
+	 * Subsequent genome routines called from this thread operate on the bound
+	 * engine. An engine may be bound to at most one thread at a time.
+	 * 
+	 * \param[in] hEngine Handle of the engine to bind (NULL restores the thread's default genome)
+	 */
+	ST_RETCODE stSetEngine(ST_HENGINE hEngine);
+
+	/**
+	 * \brief Retrieve the engine bound to the calling thread
+	 *
+	 * \param[out] phEngine Pointer to location to receive the engine handle
+	 *						(NULL if the thread uses its default genome)
+	 */
+	ST_RETCODE stGetEngine(ST_HENGINE* phEngine);
+
+	/**
+	 * \brief Methods to set/get the number of worker threads
+	 *
+	 * Stylus uses worker threads to evaluate, in parallel, the mutations
+	 * considered by exhaustive trials and those passed to stEvaluateMutations.
+	 * The results are identical to those obtained without worker threads. The
+	 * workers start when the count is set and remain until it changes or Stylus
+	 * terminates. A count of zero uses one thread per hardware core; a count of
+	 * one (the default) disables worker threads.
+	 */
+	//@{
+	ST_RETCODE stSetThreads(size_t cThreads);
+	ST_RETCODE stGetThreads(size_t* pcThreads);
+	//@}
+
 	/**
 	 * \brief Retrieve, as a human-readable string, the Stylus version information
 	 * 
@@ -435,7 +506,7 @@ extern "C" {
 	 * \brief Set the active genome
 	 *
 	 * A genome is the object on which Stylus operates and is built from an XML
-	 * description. Stylus holds, at any one time, no more than one genome.
+	 * description. Each engine holds, at any one time, no more than one genome.
 	 * Loading a genome replaces any previously loaded genome, including closing
 	 * all associated files.
 	 * 
@@ -646,6 +717,9 @@ extern "C" {
 		ST_ATTEMPTS _atDeleted;		///< Number of attempted/accepted deletions
 		ST_ATTEMPTS _atInserted;	///< Number of attempted/accepted insertions
 		ST_ATTEMPTS _atTransposed;	///< Number of attempted/accepted transpositions
+
+		size_t _cCacheHits;			///< Number of validations answered from the fitness cache
+		size_t _cCacheMisses;		///< Number of validations not found in the fitness cache
 	} ST_STATISTICS;
 
 	/**
@@ -654,6 +728,23 @@ extern "C" {
 	 */
 	ST_RETCODE stGetStatistics(ST_STATISTICS* pStatistics);
 
+	/**
+	 * \brief Methods to obtain the statistics of each lineage
+	 *
+	 * Plans that evolve a population (see the plan population option) execute
+	 * several lineages; the first lineage is the genome itself. The statistics
+	 * of each lineage are those of the last plan to evolve a population (no
+	 * lineages exist otherwise).
+	 *
+	 * \param[out] pcLineages Pointer to location to receive the number of lineages
+	 * \param[in] iLineage Index of the lineage
+	 * \param[out] pStatistics Pointer to location to receive the lineage statistics
+	 */
+	//@{
+	ST_RETCODE stGetLineages(size_t* pcLineages);
+	ST_RETCODE stGetLineageStatistics(size_t iLineage, ST_STATISTICS* pStatistics);
+	//@}
+
 	/**
 	 * \brief Genome state enumeration
 	 *
@@ -776,6 +867,68 @@ extern "C" {
 	 */
 	ST_RETCODE stGetGenomeTermination(ST_GENOMETERMINATION* pgt, ST_GENOMEREASON* pgr, char* pszTermination, size_t* pcchTermination);
 
+	/**
+	 * \brief Mutation types
+	 *
+	 */
+	typedef enum
+	{
+		STMT_COPY = 0,				///< Copy bases from the source to the target
+		STMT_CHANGE,				///< Change the bases at the target
+		STMT_DELETE,				///< Delete bases at the target
+		STMT_INSERT,				///< Insert bases at the target
+		STMT_TRANSPOSE				///< Move bases from the source to the target
+	} ST_MUTATIONTYPE;
+
+	/**
+	 * \brief A fully specified mutation
+	 *
+	 * As in plans, indexes are one-based and, except for single base changes,
+	 * must lie on a codon boundary. Counts are in whole codons except for
+	 * changes, which affect either one or three bases.
+	 */
+	typedef struct
+	{
+		ST_MUTATIONTYPE _mt;		///< Mutation type
+		size_t _iSource;			///< Source index (copy and transpose only)
+		size_t _iTarget;			///< Target index
+		size_t _cbBases;			///< Number of bases affected (may be zero for changes and insertions)
+		const char* _pszBases;		///< Incoming bases (change and insert only)
+	} ST_MUTATION;
+
+	/**
+	 * \brief The outcome of evaluating a mutation
+	 *
+	 * Scores are set only if the mutated genome validated; otherwise, the
+	 * termination codes record why the mutation or validation failed.
+	 */
+	typedef struct
+	{
+		bool _fValid;					///< Mutation applied and the genome validated
+		UNIT _nScore;					///< Gene score of the mutated genome
+		UNIT _nUnits;					///< Gene units of the mutated genome
+		UNIT _nCost;					///< Cost of the mutated genome
+		UNIT _nFitness;					///< Fitness of the mutated genome
+		ST_GENOMETERMINATION _gt;		///< Failing action (if any)
+		ST_GENOMEREASON _gr;			///< Failing action reason (if any)
+	} ST_EVALRESULT;
+
+	/**
+	 * \brief Evaluate a batch of mutations without changing the genome
+	 *
+	 * Each mutation is applied, by itself, to a copy of the active genome,
+	 * which is then compiled, validated, and scored. The genome, its
+	 * statistics, and its history are left untouched. Mutations observe the
+	 * options (e.g., preserveGenes) of the last executed plan. The batch is
+	 * divided among the available worker threads (see stSetThreads); results
+	 * do not depend on the number of threads.
+	 *
+	 * \param[in] aryMutations Array of mutations to evaluate
+	 * \param[in] cMutations Number of mutations in the array
+	 * \param[out] aryResults Array to receive one result per mutation
+	 */
+	ST_RETCODE stEvaluateMutations(const ST_MUTATION* aryMutations, size_t cMutations, ST_EVALRESULT* aryResults);
+
     ST_RETCODE stSetSeed(const char * seed);
 #ifdef __cplusplus
 }
@@ -89,6 +89,13 @@ bool python_status_callback()
 %ignore stInitialize;
 %ignore stTerminate;
 %ignore stSetScope;
+%ignore ST_HENGINE;
+%ignore stCreateEngine;
+%ignore stDestroyEngine;
+%ignore stSetEngine;
+%ignore stGetEngine;
+%ignore stSetThreads;
+%ignore stGetThreads;
 %ignore stGetVersion;
 %ignore stGetMutationDescription;
 
@@ -176,6 +183,18 @@ bool python_status_callback()
 %ignore stExecutePlan;
 
 %ignore stGetStatistics;
+%ignore stGetLineages;
+%ignore stGetLineageStatistics;
+
+%ignore STMT_COPY;
+%ignore STMT_CHANGE;
+%ignore STMT_DELETE;
+%ignore STMT_INSERT;
+%ignore STMT_TRANSPOSE;
+%ignore ST_MUTATIONTYPE;
+%ignore ST_MUTATION;
+%ignore ST_EVALRESULT;
+%ignore stEvaluateMutations;
 
 %ignore stGetGenomeState;
 %include <stylus.h>
@@ -533,6 +552,14 @@ bool python_status_callback()
 
     }
 
+	unsigned long setThreads(size_t cThreads)
+	{
+		ST_RETCODE rc = ::ensureStylus();
+		return (!ST_ISSUCCESS(rc)
+				? rc
+				: ::stSetThreads(cThreads));
+	}
+
 
 
 	const char** getTraceRegions()
@@ -690,6 +717,93 @@ bool python_status_callback()
 		return statistics;
 	}
 
+	size_t getLineages()
+	{
+		size_t cLineages = 0;
+		if (ST_ISSUCCESS(::ensureStylus()))
+			::stGetLineages(&cLineages);
+		return cLineages;
+	}
+
+	STATISTICS getLineageStatistics(size_t iLineage)
+	{
+		STATISTICS statistics;
+		if (ST_ISSUCCESS(::ensureStylus()))
+			::stGetLineageStatistics(iLineage, &statistics);
+		return statistics;
+	}
+
+	/*
+	 * Evaluate a list of mutations, each a tuple of (type, sourceIndex, targetIndex,
+	 * countBases, bases) where type is one of copy, change, delete, insert, or
+	 * transpose. Returns a list holding, for each mutation, a tuple of (valid,
+	 * score, units, cost, fitness, termination, reason) or, should Stylus fail,
+	 * the return code.
+	 */
+	PyObject* evaluateMutations(PyObject* pyMutations)
+	{
+		static const char* aryMUTATIONTYPES[] =
+		{
+			"copy",
+			"change",
+			"delete",
+			"insert",
+			"transpose"
+		};
+
+		if (!PyList_Check(pyMutations))
+		{
+			PyErr_SetString(PyExc_TypeError,"Stylusengine Error: Call must pass a list");
+			return NULL;
+		}
+
+		size_t cMutations = PyList_Size(pyMutations);
+		std::vector<ST_MUTATION> vecMutations(cMutations);
+		for (size_t iMutation=0; iMutation < cMutations; ++iMutation)
+		{
+			const char* pszType = NULL;
+			unsigned long iSource = 0;
+			unsigned long iTarget = 0;
+			unsigned long cbBases = 0;
+			const char* pszBases = NULL;
+			if (!PyArg_ParseTuple(PyList_GetItem(pyMutations,iMutation), "skkk|z", &pszType, &iSource, &iTarget, &cbBases, &pszBases))
+				return NULL;
+
+			ST_MUTATION& stm = vecMutations[iMutation];
+			stm._mt = static_cast<ST_MUTATIONTYPE>(ARRAY_LENGTH(aryMUTATIONTYPES));
+			for (size_t iType=0; iType < ARRAY_LENGTH(aryMUTATIONTYPES); ++iType)
+			{
+				if (::strcmp(pszType, aryMUTATIONTYPES[iType]) == 0)
+				{
+					stm._mt = static_cast<ST_MUTATIONTYPE>(iType);
+					break;
+				}
+			}
+			stm._iSource = iSource;
+			stm._iTarget = iTarget;
+			stm._cbBases = cbBases;
+			stm._pszBases = pszBases;
+		}
+
+		std::vector<ST_EVALRESULT> vecResults(cMutations);
+		ST_RETCODE rc = ::ensureStylus();
+		if (ST_ISSUCCESS(rc) && cMutations > 0)
+			rc = ::stEvaluateMutations(&vecMutations[0], cMutations, &vecResults[0]);
+		if (!ST_ISSUCCESS(rc))
+			return PyInt_FromLong(rc);
+
+		PyObject* pyResults = PyList_New(cMutations);
+		for (size_t iResult=0; VALID(pyResults) && iResult < cMutations; ++iResult)
+		{
+			const ST_EVALRESULT& er = vecResults[iResult];
+			PyList_SET_ITEM(pyResults, iResult, Py_BuildValue("(Nddddii)",
+												PyBool_FromLong(er._fValid),
+												er._nScore, er._nUnits, er._nCost, er._nFitness,
+												static_cast<int>(er._gt), static_cast<int>(er._gr)));
+		}
+		return pyResults;
+	}
+
 	ST_GENOMESTATE getState()
 	{
 		ST_GENOMESTATE gs;
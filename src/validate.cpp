@@ -39,28 +39,30 @@ Stroke::calcDimensions(Gene& gene)
 	ENTER(VALIDATION,calcDimensions);
 
 	const ACIDTYPEARRAY& vecAcids = gene.getAcids();
-	const POINTARRAY& vecPoints = gene.getPoints();
+	const UNITARRAY& vecX = gene.getX();
+	const UNITARRAY& vecY = gene.getY();
 	long iAcid = _rgAcids.getStart()-1;
 
 	ASSERT(iAcid >= 0);
 
 	// Strokes begin where the previous vector ends
-	Point ptTopLeft(vecPoints[iAcid]);
-	Point ptBottomRight(vecPoints[iAcid]);
+	Point ptTopLeft(vecX[iAcid], vecY[iAcid]);
+	Point ptBottomRight(vecX[iAcid], vecY[iAcid]);
 
 	// Sum the lengths of vectors contained in the stroke
 	ASSERT(_slVectors.getLength() == 0);
 	for (++iAcid; iAcid <= _rgAcids.getEnd(); ++iAcid)
 	{
-		const Point& pt = vecPoints[iAcid];
-		if (pt.x() < ptTopLeft.x())
-			ptTopLeft.x() = pt.x();
-		if (pt.y() > ptTopLeft.y())
-			ptTopLeft.y() = pt.y();
-		if (pt.x() > ptBottomRight.x())
-			ptBottomRight.x() = pt.x();
-		if (pt.y() < ptBottomRight.y())
-			ptBottomRight.y() = pt.y();
+		Unit x(vecX[iAcid]);
+		Unit y(vecY[iAcid]);
+		if (x < ptTopLeft.x())
+			ptTopLeft.x() = x;
+		if (y > ptTopLeft.y())
+			ptTopLeft.y() = y;
+		if (x > ptBottomRight.x())
+			ptBottomRight.x() = x;
+		if (y < ptBottomRight.y())
+			ptBottomRight.y() = y;
 
 		_slVectors += vecAcids[iAcid];
 	}
@@ -443,8 +445,8 @@ StrokeRangeChange::toString() const
 /*
  * Function: ensureAcids
  *
- * Compile the codons into ACIDTYPEs and establish the point at the end
- * of each vector (the start vector is located at _ptOrigin).
+ * Compile the codons into ACIDTYPEs and calculate the points at the end
+ * of each vector from the first changed acid onward.
  */
 void
 Gene::ensureAcids(size_t iAcidChange, long cAcidsChanged)
@@ -453,7 +455,7 @@ Gene::ensureAcids(size_t iAcidChange, long cAcidsChanged)
 
 	ASSERT(iAcidChange == 0 || !Genome::isState(STGS_VALIDATING));
 	ASSERT(iAcidChange == 0 || static_cast<long>(_vecAcids.size()) == Codon::numWholeCodons(_rgBases.getLength()));
-	ASSERT(iAcidChange == 0 || _vecAcids.size() == _vecPoints.size());
+	ASSERT(iAcidChange == 0 || _vecAcids.size() == _vecX.size());
 
 	if (_vecAcids.empty())
 	{
@@ -461,7 +463,8 @@ Gene::ensureAcids(size_t iAcidChange, long cAcidsChanged)
 		ASSERT(_rgBases.isEmpty() || cAcids >= 2);
 
 		_vecAcids.resize(cAcids);
-		_vecPoints.resize(cAcids);
+		_vecX.resize(cAcids);
+		_vecY.resize(cAcids);
 
 		iAcidChange = 0;
 		cAcidsChanged = _vecAcids.size();
@@ -470,49 +473,123 @@ Gene::ensureAcids(size_t iAcidChange, long cAcidsChanged)
 	TFLOW(VALIDATION,L3,(LLTRACE, "Creating acids from %ld for %ld codons", (iAcidChange+1), cAcidsChanged));
 
 	ASSERT(_vecAcids.size() >= 2);
-	ASSERT(_vecAcids.size() == _vecPoints.size());
+	ASSERT(_vecAcids.size() == _vecX.size());
+	ASSERT(_vecAcids.size() == _vecY.size());
 	ASSERT(_vecAcids.size() == static_cast<size_t>(_rgBases.getLength() / Codon::s_cchCODON));
 
 	// If acids were added, convert the corresponding bases to ACIDTYPEs
 	if (cAcidsChanged > 0)
 	{
-		const char* pszBases = Genome::getBases().c_str();
 		size_t iBase = _rgBases.getStart() + (iAcidChange * Codon::s_cchCODON);
-		size_t iAcid = iAcidChange;
-		size_t iAcidEnd = iAcidChange + cAcidsChanged;
-
-		for (; iAcid < iAcidEnd; iBase += Codon::s_cchCODON, ++iAcid)
-			_vecAcids[iAcid] = Genome::codonToType(pszBases+iBase);
+		Genome::codonsToTypes(Genome::getBaseSequence().view(iBase, cAcidsChanged * Codon::s_cchCODON),
+							  cAcidsChanged,
+							  &_vecAcids[iAcidChange]);
 	}
 
-	// Calculate the points associated with each acid from the point of change onward
-	// - The point associated with the first codon is the origin of the gene; all others
-	//   are the value after applying the acid (that is, the start codon is treated as
-	//   a zero-length acid)
-	Point pt;
+	// Every later point moves with the changed vector; recalculate the points from
+	// the point of change onward (and note which lattice points are affected)
+	ensurePoints(iAcidChange);
+	_cLattice = min(_cLattice, (iAcidChange + Constants::s_cLATTICEINTERVAL - 1) / Constants::s_cLATTICEINTERVAL);
+	
+	// Calculate the total vector length of the gene
+	// - The length excludes the start and stop codons
+	_nUnits = 0;
+	for (size_t iAcid=1; iAcid < _vecAcids.size()-1; iAcid++)
+		_nUnits += Acid::typeToAcid(_vecAcids[iAcid]).getLength();
+	TDATA(VALIDATION,L3,(LLTRACE, "Gene has %0.15f total units", static_cast<UNIT>(_nUnits)));
+
+	markValid(GI_ACIDS | GI_POINTS);
+}
+
+/*
+ * Function: ensurePoints
+ *
+ * Establish the point at the end of each vector from the passed acid onward
+ * (the start vector is located at _ptOrigin). Each point is the prior point
+ * plus the vector, summed in sequence order.
+ *
+ * NOTES:
+ * - Holding the points in a tree of prefix sums with lazy translation would
+ *   make a change cost O(log n), but every validation reads every point and
+ *   regrouping the (irrational) sums would alter the points in their last bits
+ */
+void
+Gene::ensurePoints(size_t iAcidChange)
+{
+	ENTER(VALIDATION,ensurePoints);
+
+	ASSERT(_vecAcids.size() == _vecX.size());
+	ASSERT(_vecAcids.size() == _vecY.size());
+	ASSERT(iAcidChange <= _vecX.size());
+
+	TFLOW(VALIDATION,L3,(LLTRACE, "Creating points from %lu for %lu acids", (iAcidChange+1), (_vecX.size()-iAcidChange)));
 
+	// The point associated with the first codon is the origin of the gene; all others
+	// are the value after applying the acid (that is, the start codon is treated as
+	// a zero-length acid)
 	size_t iAcid = iAcidChange;
 	if (iAcid <= 0)
 	{
-		_vecPoints[0] = _ptOrigin;
+		_vecX[0] = _ptOrigin.x();
+		_vecY[0] = _ptOrigin.y();
 		iAcid++;
 	}
 
-	pt = _vecPoints[iAcid-1];
-	for (; iAcid < _vecPoints.size(); ++iAcid)
+	UNIT x = _vecX[iAcid-1];
+	UNIT y = _vecY[iAcid-1];
+	for (; iAcid < _vecX.size(); ++iAcid)
 	{
-		pt += _vecAcids[iAcid];
-		_vecPoints[iAcid] = pt;
+		const Acid& acid = Acid::typeToAcid(_vecAcids[iAcid]);
+		x += acid.getDX();
+		y += acid.getDY();
+		_vecX[iAcid] = x;
+		_vecY[iAcid] = y;
 	}
-	
-	// Calculate the total vector length of the gene
-	// - The length excludes the start and stop codons
-	_nUnits = 0;
-	for (iAcid=1; iAcid < _vecAcids.size()-1; iAcid++)
-		_nUnits += Acid::typeToAcid(_vecAcids[iAcid]).getLength();
-	TDATA(VALIDATION,L3,(LLTRACE, "Gene has %0.15f total units", static_cast<UNIT>(_nUnits)));
+}
 
-	markValid(GI_ACIDS | GI_POINTS);
+/*
+ * Function: calcLatticePoint
+ *
+ * Return the exact point (relative to the origin) after applying the vector
+ * of the passed acid.
+ *
+ * NOTES:
+ * - Only every s_cLATTICEINTERVAL-th lattice point is kept; storing one for
+ *   every acid costs more than re-summing the few acids since the last one
+ * - Lattice points are summed from the acids, not the points, and only when
+ *   first needed after a change (see ensureAcids)
+ */
+LatticePoint
+Gene::calcLatticePoint(size_t iAcid) const
+{
+	ENTER(VALIDATION,calcLatticePoint);
+
+	ASSERT(iAcid < _vecAcids.size());
+
+	size_t iLattice = iAcid / Constants::s_cLATTICEINTERVAL;
+	if (iLattice >= _cLattice)
+	{
+		_vecLattice.resize(((_vecAcids.size() - 1) / Constants::s_cLATTICEINTERVAL) + 1);
+		if (_cLattice <= 0)
+		{
+			_vecLattice[0].clear();
+			_cLattice = 1;
+		}
+
+		for (; _cLattice <= iLattice; ++_cLattice)
+		{
+			LatticePoint lpt(_vecLattice[_cLattice-1]);
+			size_t iAcidEnd = _cLattice * Constants::s_cLATTICEINTERVAL;
+			for (size_t iAcidNext=iAcidEnd - Constants::s_cLATTICEINTERVAL + 1; iAcidNext <= iAcidEnd; ++iAcidNext)
+				lpt += _vecAcids[iAcidNext];
+			_vecLattice[_cLattice] = lpt;
+		}
+	}
+
+	LatticePoint lpt(_vecLattice[iLattice]);
+	for (size_t iAcidNext=(iLattice * Constants::s_cLATTICEINTERVAL)+1; iAcidNext <= iAcid; ++iAcidNext)
+		lpt += _vecAcids[iAcidNext];
+	return lpt;
 }
 
 /*
@@ -521,6 +598,11 @@ Gene::ensureAcids(size_t iAcidChange, long cAcidsChanged)
  * Determine the coherence of each vector by examining all possible trivectors.
  * For each vector is a coherence count, ranging from 0 to 3, indicating how
  * many trivectors within which it was found.
+ *
+ * NOTES:
+ * - A changed acid alters only the trivectors containing it and, so, only the
+ *   coherence of vectors within two acids of it; when the changed acids are
+ *   known (see markInvalid), only those vectors are recounted
  */
 void
 Gene::ensureCoherence()
@@ -530,29 +612,91 @@ Gene::ensureCoherence()
 	ASSERT(isValid(GI_ACIDS));
 	ASSERT(_vecAcids.size() >= Codon::s_nTRIVECTOR+2);
 
-	if (_vecCoherent.empty())
-		_vecCoherent.resize(_vecAcids.size());
+	// Recount around the changed acids unless a stop codon precedes the last acid
+	// (trivectors end at the first stop codon, so any such stop affects all that follow)
+	bool fRecount = !_rgAcidsDirty.isEmpty() && !_fInternalStop;
+	for (long iAcid=(fRecount ? _rgAcidsDirty.getStart() : 0); fRecount && iAcid <= _rgAcidsDirty.getEnd(); ++iAcid)
+		fRecount = !Acid::typeToAcid(_vecAcids[iAcid]).isStop();
 
-	ASSERT(_vecCoherent.size() >= Codon::s_nTRIVECTOR+2);
-	ASSERT(_vecAcids.size() == _vecCoherent.size());
+	if (fRecount)
+	{
+		ASSERT(_vecAcids.size() == _vecCoherent.size());
+		ASSERT(_rgAcidsDirty.getEnd() < static_cast<long>(_vecAcids.size()-1));
+
+		long iTrivectorLast = _vecAcids.size() - Codon::s_nTRIVECTOR - 1;
+		long iAcidFirst = max<long>(_rgAcidsDirty.getStart() - (Codon::s_nTRIVECTOR-1), 0);
+		long iAcidLast = min<long>(_rgAcidsDirty.getEnd() + (Codon::s_nTRIVECTOR-1), _vecAcids.size()-1);
+
+		TFLOW(VALIDATION,L3,(LLTRACE, "Recounting coherence from %ld to %ld", (iAcidFirst+1), (iAcidLast+1)));
+
+		for (long iAcid=iAcidFirst; iAcid <= iAcidLast; ++iAcid)
+		{
+			_vecCoherent[iAcid] = 0;
+			for (long iTrivector=max<long>(iAcid-(Codon::s_nTRIVECTOR-1), 1); iTrivector <= min<long>(iAcid, iTrivectorLast); ++iTrivector)
+			{
+				if (Codon::isCoherent(_vecAcids[iTrivector+0], _vecAcids[iTrivector+1], _vecAcids[iTrivector+2]))
+					++_vecCoherent[iAcid];
+			}
+		}
+
+#ifdef ST_DEBUG
+		COHERENCEARRAY vecCoherent(_vecAcids.size());
+		calcCoherence(vecCoherent);
+		ASSERT(vecCoherent == _vecCoherent);
+#endif
+	}
+
+	// Otherwise, count the coherence of all vectors (and rebuild all segments)
+	else
+	{
+		if (!_rgAcidsDirty.isEmpty())
+		{
+			_rgAcidsDirty.clear();
+			_dAcidsDirty = 0;
+			_vecSegments.clear();
+			_cCoherent = 0;
+		}
+
+		_vecCoherent.assign(_vecAcids.size(), 0);
+		_fInternalStop = calcCoherence(_vecCoherent);
+	}
+
+	markValid(GI_COHERENCE);
+}
+
+/*
+ * Function: calcCoherence
+ *
+ * Count the coherence of every vector into the passed (zero-filled) array,
+ * returning true if the trivectors ended at a stop codon preceding the last
+ * acid.
+ */
+bool
+Gene::calcCoherence(COHERENCEARRAY& vecCoherent) const
+{
+	ENTER(VALIDATION,calcCoherence);
+
+	ASSERT(vecCoherent.size() >= Codon::s_nTRIVECTOR+2);
+	ASSERT(_vecAcids.size() == vecCoherent.size());
 	ASSERT(Acid::typeToAcid(_vecAcids[_vecAcids.size()-1]).isStop());
 
-	_vecCoherent[0] = 0;
-	_vecCoherent[1] = 0;
-	_vecCoherent[2] = 0;
+	vecCoherent[0] = 0;
+	vecCoherent[1] = 0;
+	vecCoherent[2] = 0;
 
-	for (long iAcid=1; !Acid::typeToAcid(_vecAcids[iAcid+2]).isStop(); ++iAcid)
+	long iAcid = 1;
+	for (; !Acid::typeToAcid(_vecAcids[iAcid+2]).isStop(); ++iAcid)
 	{
-		_vecCoherent[iAcid+2] = 0;
+		vecCoherent[iAcid+2] = 0;
 		if (Codon::isCoherent(_vecAcids[iAcid+0], _vecAcids[iAcid+1], _vecAcids[iAcid+2]))
 		{
-			++_vecCoherent[iAcid+0];
-			++_vecCoherent[iAcid+1];
-			++_vecCoherent[iAcid+2];
+			++vecCoherent[iAcid+0];
+			++vecCoherent[iAcid+1];
+			++vecCoherent[iAcid+2];
 		}
 	}
 
-	markValid(GI_COHERENCE);
+	return (static_cast<size_t>(iAcid+2) < _vecAcids.size()-1);
 }
 
 /*
@@ -566,6 +710,9 @@ Gene::ensureCoherence()
  * - Strokes could be built up from the coherence array without directly
  *   using the notion of segments; however, since strokes deal with coherent
  *   ranges, first dividing the vectors into segments makes sense
+ * - When the changed acids are known, only the segments spanning the
+ *   recounted vectors are rebuilt; those following are shifted by the
+ *   number of acids inserted or deleted
  */
 void
 Gene::ensureSegments()
@@ -578,24 +725,104 @@ Gene::ensureSegments()
 	ASSERT(_vecAcids.size() == _vecCoherent.size());
 	ASSERT(Acid::typeToAcid(_vecAcids[_vecAcids.size()-1]).isStop());
 
-	bool fWasCoherent = !(_vecCoherent[1] > 0);
-	long iSegment = -1;
+	if (!_rgAcidsDirty.isEmpty() && !_vecSegments.empty())
+	{
+		// Rebuild from the segment containing the last vector before those recounted
+		// through the segment containing the first vector after them (the boundaries
+		// of both depend only on unchanged vectors)
+		long iAcidStop = _vecAcids.size()-1;
+		long iAcidBefore = _rgAcidsDirty.getStart() - Codon::s_nTRIVECTOR;
+		long iAcidAfter = _rgAcidsDirty.getEnd() + Codon::s_nTRIVECTOR;
+
+		size_t iSegmentFirst = 0;
+		size_t iSegmentLast = _vecSegments.size()-1;
+		long iAcidFirst = 1;
+		long iAcidLast = iAcidStop-1;
+
+		if (iAcidBefore >= 1)
+		{
+			iSegmentFirst = findSegment(iAcidBefore);
+			iAcidFirst = _vecSegments[iSegmentFirst].getStart();
+		}
+		if (iAcidAfter < iAcidStop)
+		{
+			iSegmentLast = findSegment(iAcidAfter - _dAcidsDirty);
+			iAcidLast = _vecSegments[iSegmentLast].getEnd() + _dAcidsDirty;
+		}
+
+		TFLOW(VALIDATION,L3,(LLTRACE, "Rebuilding segments %lu to %lu from %ld to %ld", (iSegmentFirst+1), (iSegmentLast+1), iAcidFirst, iAcidLast));
+
+		SEGMENTARRAY vecSegments;
+		size_t cCoherent = 0;
+		calcSegments(iAcidFirst, iAcidLast, vecSegments, cCoherent);
+
+		for (size_t iSegment=iSegmentFirst; iSegment <= iSegmentLast; ++iSegment)
+		{
+			if (_vecSegments[iSegment].isCoherent())
+				--_cCoherent;
+		}
+		_cCoherent += cCoherent;
+
+		for (size_t iSegment=iSegmentLast+1; iSegment < _vecSegments.size(); ++iSegment)
+			_vecSegments[iSegment].moveRange(_dAcidsDirty);
+
+		_vecSegments.erase(_vecSegments.begin()+iSegmentFirst, _vecSegments.begin()+iSegmentLast+1);
+		_vecSegments.insert(_vecSegments.begin()+iSegmentFirst, vecSegments.begin(), vecSegments.end());
+
+#ifdef ST_DEBUG
+		vecSegments.clear();
+		cCoherent = 0;
+		calcSegments(1, iAcidStop, vecSegments, cCoherent);
+		ASSERT(vecSegments == _vecSegments);
+		ASSERT(cCoherent == _cCoherent);
+#endif
+	}
+
+	else
+	{
+		_vecSegments.clear();
+		_cCoherent = 0;
+		calcSegments(1, _vecAcids.size()-1, _vecSegments, _cCoherent);
+	}
+
+	_rgAcidsDirty.clear();
+	_dAcidsDirty = 0;
+
+	// Since, coherent and incoherent segments alternate,
+	// their absolute difference should never exceed one
+	ASSERT(::abs(static_cast<size_t>(_vecSegments.size() - (2 * _cCoherent))) <= 1);
+
+	TFLOW(VALIDATION,L3,(LLTRACE, "%d segments created", _vecSegments.size()));
+	TRACEDOIF(VALIDATION,DATA,L3,traceSegments());
+
+	markValid(GI_SEGMENTS);
+}
+
+/*
+ * Function: calcSegments
+ *
+ * Append to the passed array the segments of the vectors from the first acid
+ * through the last (or the first stop codon), counting those coherent. The
+ * first acid always begins a new segment.
+ */
+void
+Gene::calcSegments(long iAcidFirst, long iAcidLast, SEGMENTARRAY& vecSegments, size_t& cCoherent) const
+{
+	ENTER(VALIDATION,calcSegments);
 
-	_vecSegments.clear();
+	bool fWasCoherent = !(_vecCoherent[iAcidFirst] > 0);
 
-	// Iterate across all vectors between the start and stop codon
-	for (long iAcid=1; !Acid::typeToAcid(_vecAcids[iAcid]).isStop(); ++iAcid)
+	for (long iAcid=iAcidFirst; iAcid <= iAcidLast && !Acid::typeToAcid(_vecAcids[iAcid]).isStop(); ++iAcid)
 	{
 		bool fIsCoherent = (_vecCoherent[iAcid] > 0);
 		if (fWasCoherent != fIsCoherent)
 		{
 			fWasCoherent = fIsCoherent;
-			++iSegment;
-			_vecSegments.resize(iSegment+1);
+			vecSegments.resize(vecSegments.size()+1);
 			if (fIsCoherent)
-				++_cCoherent;
+				++cCoherent;
 
-			Segment& sg = _vecSegments.back();
+			Segment& sg = vecSegments.back();
 			sg.setRange(Range(iAcid,iAcid));
 			sg.setCoherent(fIsCoherent);
 			sg = _vecAcids[iAcid];
@@ -603,20 +830,37 @@ Gene::ensureSegments()
 
 		else
 		{
-			Segment& sg = _vecSegments.back();
+			Segment& sg = vecSegments.back();
 			sg += _vecAcids[iAcid];
 			sg.setEnd(iAcid);
 		}
 	}
+}
 
-	// Since, coherent and incoherent segments alternate,
-	// their absolute difference should never exceed one
-	ASSERT(::abs(static_cast<size_t>(_vecSegments.size() - (2 * _cCoherent))) <= 1);
+/*
+ * Function: findSegment
+ *
+ * Return the index of the segment containing the passed acid.
+ */
+size_t
+Gene::findSegment(long iAcid) const
+{
+	ENTER(VALIDATION,findSegment);
 
-	TFLOW(VALIDATION,L3,(LLTRACE, "%d segments created", _vecSegments.size()));
-	TRACEDOIF(VALIDATION,DATA,L3,traceSegments());
+	ASSERT(!_vecSegments.empty());
+	ASSERT(_vecSegments.front().getStart() <= iAcid && iAcid <= _vecSegments.back().getEnd());
 
-	markValid(GI_SEGMENTS);
+	size_t iSegmentLow = 0;
+	size_t iSegmentHigh = _vecSegments.size()-1;
+	while (iSegmentLow < iSegmentHigh)
+	{
+		size_t iSegment = (iSegmentLow + iSegmentHigh + 1) / 2;
+		if (_vecSegments[iSegment].getStart() <= iAcid)
+			iSegmentLow = iSegment;
+		else
+			iSegmentHigh = iSegment-1;
+	}
+	return iSegmentLow;
 }
 
 /*
@@ -1118,17 +1362,131 @@ INVALID:
 /*
  * Function: ensureOverlaps
  *
+ * Overlaps are translation-invariant: Strokes whose vectors are unchanged
+ * and which moved together (by the same offset, including not at all) overlap
+ * exactly as before, just translated. Only overlaps between other stroke
+ * pairs are detected anew.
  */
 void
 Gene::ensureOverlaps()
 {
 	ENTER(VALIDATION,ensureOverlaps);
 
-	Overlaps overlaps(_vecAcids, _vecPoints, _vecStrokes);
-	_setOverlaps = overlaps.getOverlaps();
+	size_t cStrokes = _vecStrokes.size();
+	STROKEOVERLAPS setOverlaps;
+	LINECROSSINGARRAY vecCrossings;
+	vector<bool> vecPairs;
+
+	// Note where each stroke now begins
+	LATTICEPOINTARRAY vecOrigins(cStrokes);
+	for (size_t iStroke=0; iStroke < cStrokes; ++iStroke)
+		vecOrigins[iStroke] = calcLatticePoint(_vecStrokes[iStroke].getStart()-1);
+
+	// Reuse the overlaps of stroke pairs that moved together
+	// - The offset of a stroke is the distance its start point moved; lattice
+	//   offsets are exact, so strokes moved together only if their offsets are equal
+	// - Reused overlaps are found again where their lines now cross (rather than
+	//   translating the earlier point) so that they match detection exactly
+	if (_vecOverlapRanges.size() == cStrokes)
+	{
+		LATTICEPOINTARRAY vecOffsets(cStrokes);
+		vector<bool> vecRigid(cStrokes);
+		for (size_t iStroke=0; iStroke < cStrokes; ++iStroke)
+		{
+			vecRigid[iStroke] = isStrokeRigid(iStroke);
+			if (vecRigid[iStroke])
+			{
+				vecOffsets[iStroke] = vecOrigins[iStroke];
+				vecOffsets[iStroke] -= _vecOverlapOrigins[iStroke];
+			}
+		}
+
+		size_t cReused = 0;
+		vecPairs.resize(cStrokes * cStrokes, true);
+		for (size_t iStroke1=0; iStroke1 < cStrokes; ++iStroke1)
+		{
+			for (size_t iStroke2=iStroke1+1; iStroke2 < cStrokes; ++iStroke2)
+			{
+				if (vecRigid[iStroke1] && vecRigid[iStroke2] && vecOffsets[iStroke1] == vecOffsets[iStroke2])
+				{
+					vecPairs[(iStroke1 * cStrokes) + iStroke2] = false;
+					++cReused;
+				}
+			}
+		}
+
+		for (size_t iCrossing=0; iCrossing < _vecOverlapCrossings.size(); ++iCrossing)
+		{
+			LineCrossing lc(_vecOverlapCrossings[iCrossing]);
+			size_t iStroke1 = lc.getFirstStroke();
+			size_t iStroke2 = lc.getSecondStroke();
+			if (vecPairs[(iStroke1 * cStrokes) + iStroke2])
+				continue;
+
+			lc.shift(_vecStrokes[iStroke1].getStart() - _vecOverlapRanges[iStroke1].getStart(),
+					 _vecStrokes[iStroke2].getStart() - _vecOverlapRanges[iStroke2].getStart());
+
+			Point ptIntersection;
+			if (	Overlaps::intersects(getX(), getY(), lc, ptIntersection)
+				&&	setOverlaps.insert(STROKEOVERLAP(iStroke1, iStroke2, ptIntersection)).second)
+				vecCrossings.push_back(lc);
+		}
+
+		TFLOW(VALIDATION,L3,(LLTRACE, "Reusing overlaps for %ld of %ld stroke pairs", cReused, ((cStrokes * (cStrokes-1)) / 2)));
+	}
+
+	Overlaps overlaps(_vecAcids, getX(), getY(), _vecStrokes);
+	const STROKEOVERLAPS& setFound = overlaps.getOverlaps(vecPairs);
+	const LINECROSSINGARRAY& vecFound = overlaps.getCrossings();
+	setOverlaps.insert(setFound.begin(), setFound.end());
+	vecCrossings.insert(vecCrossings.end(), vecFound.begin(), vecFound.end());
+	_setOverlaps.swap(setOverlaps);
+
+#ifdef ST_DEBUG
+	if (!vecPairs.empty())
+	{
+		Overlaps overlapsAll(_vecAcids, getX(), getY(), _vecStrokes);
+		ASSERT(_setOverlaps == overlapsAll.getOverlaps());
+	}
+#endif
+
+	// Note the stroke locations for use by the next pass
+	_vecOverlapRanges.resize(cStrokes);
+	for (size_t iStroke=0; iStroke < cStrokes; ++iStroke)
+		_vecOverlapRanges[iStroke] = _vecStrokes[iStroke].getRange();
+	_vecOverlapOrigins.swap(vecOrigins);
+	_vecOverlapCrossings.swap(vecCrossings);
+	_rgOverlapsDirty.clear();
+	_dOverlapsDirty = 0;
 
 	TFLOW(VALIDATION,L3,(LLTRACE, "%ld overlapping strokes", _setOverlaps.size()));
 	TRACEDOIF(VALIDATION,DATA,L3,traceStrokeOverlaps());
 
 	markValid(GI_OVERLAPS);
 }
+
+/*
+ * Function: isStrokeRigid
+ *
+ * A stroke is rigid if none of its vectors changed since overlaps were last
+ * found; it either lies wholly before the changed acids or wholly after them
+ * (shifted by the net acids inserted or deleted).
+ */
+bool
+Gene::isStrokeRigid(size_t iStroke) const
+{
+	ENTER(VALIDATION,isStrokeRigid);
+
+	const Range& rgStroke = _vecStrokes[iStroke].getRange();
+	Range rgBefore(rgStroke);
+
+	if (!_rgOverlapsDirty.isEmpty())
+	{
+		if (rgStroke.getStart() > _rgOverlapsDirty.getEnd())
+			rgBefore -= _dOverlapsDirty;
+		else if (rgStroke.getEnd() >= _rgOverlapsDirty.getStart())
+			return false;
+	}
+
+	return (rgBefore == _vecOverlapRanges[iStroke]);
+}
@@ -60,8 +60,11 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"accepted",
 	"acceptedMutations",
 	"accumulateMutations",
+	"all",
 	"ancestors",
 	"attempt",
+	"attemptHistory",
+	"attemptHistorySize",
 	"attempted",
 	"attempts",
 	"author",
@@ -71,6 +74,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"bases",
 	"basesAfter",
 	"bottom",
+	"boundScores",
 	"bounds",
 	"change",
 	"changed",
@@ -81,6 +85,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
     "compared",
     "comparedMutations",
 	"containedStrokes",
+	"cooling",
 	"copied",
 	"copies",
 	"copy",
@@ -115,6 +120,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"factor",
 	"firstStroke",
 	"fitness",
+	"fitnessCache",
 	"fitnessCondition",
 	"fitnessRange",
 	"fixedCost",
@@ -141,6 +147,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"insert",
 	"inserted",
 	"insertions",
+	"last",
 	"left",
 	"length",
 	"likelihood",
@@ -148,6 +155,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"maintain",
 	"marks",
 	"maximum",
+	"migrationInterval",
 	"minimum",
 	"minimumStrokeLength",
 	"missingOverlaps",
@@ -164,6 +172,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"plan",
 	"point",
 	"points",
+	"population",
 	"preserveGenes",
 	"processorID",
 	"reasonCode",
@@ -175,6 +184,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"rollbackCondition",
 	"rollbackLimit",
 	"rollbacks",
+	"sample",
 	"scale",
 	"score",
 	"scoreCondition",
@@ -184,6 +194,7 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"segment",
 	"segments",
 	"silent",
+	"size",
 	"sourceIndex",
 	"sp-deviation",
 	"sp-dropouts",
@@ -193,16 +204,20 @@ const char* XMLDocument::s_aryXMLTAG[XT_MAX] =
 	"sp-missingOverlaps",
 	"sp-placement",
 	"sp-scale",
+	"speculativeAttempts",
 	"statistics",
 	"step",
 	"steps",
 	"strain",
 	"stroke",
+	"strokeOrientation",
 	"strokes",
 	"sxToHan",
 	"syToHan",
 	"tandem",
 	"targetIndex",
+	"temperature",
+	"temperatureRatio",
 	"termination",
 	"terminationCode",
 	"terminationConditions",
@@ -263,6 +278,7 @@ const char* XMLDocument::s_aryXMLXPATH[XP_MAX] =
 	"st:terminationConditions/st:durationCondition",
 	"st:terminationConditions/st:rollbackCondition",
 	"st:terminationConditions/st:fitnessCondition",
+	"st:population",
 	"/st:plan/st:steps/st:step",
 	"st:trialConditions",
 	"st:costCondition",
@@ -295,7 +311,7 @@ SCHEMA XMLDocument::s_arySCHEMAS[] =
 };
 
 string XMLDocument::s_strScope;
-char XMLDocument::s_szXMLError[Constants::s_cbmaxBUFFER];
+thread_local char XMLDocument::s_szXMLError[Constants::s_cbmaxBUFFER];
 
 /*
  * Function: xmlFreeChar
@@ -331,14 +347,8 @@ XMLDocument::initialize()
 {
 	ENTER(XML,initialize);
 
-	clearErrors();
-	
 	::xmlInitParser();
-	::xmlLineNumbersDefault(1);
-	::xmlSubstituteEntitiesDefault(1);
-
-	xmlGenericErrorFunc pf = &handlerGenericError;
-	::initGenericErrorDefaultFunc(&pf);
+	initializeThread();
 
 	::xmlNanoHTTPInit();
 	
@@ -346,6 +356,26 @@ XMLDocument::initialize()
 	terminatePath(s_strScope);
 }
 
+/*
+ * Function: initializeThread
+ *
+ * Establish the libxml2 settings, which libxml2 keeps per thread, for the
+ * calling thread.
+ */
+void
+XMLDocument::initializeThread()
+{
+	ENTER(XML,initializeThread);
+
+	clearErrors();
+
+	::xmlLineNumbersDefault(1);
+	::xmlSubstituteEntitiesDefault(1);
+
+	xmlGenericErrorFunc pf = &handlerGenericError;
+	::initGenericErrorDefaultFunc(&pf);
+}
+
 /*
  * Function: terminate
  *
@@ -91,8 +91,11 @@ namespace org_biologicinstitute_stylus
 		XT_ACCEPTED = 0,
 		XT_ACCEPTEDMUTATIONS,
 		XT_ACCUMULATEMUTATIONS,
+		XT_ALL,
 		XT_ANCESTORS,
 		XT_ATTEMPT,
+		XT_ATTEMPTHISTORY,
+		XT_ATTEMPTHISTORYSIZE,
 		XT_ATTEMPTED,
 		XT_ATTEMPTS,
 		XT_AUTHOR,
@@ -102,6 +105,7 @@ namespace org_biologicinstitute_stylus
 		XT_BASES,
 		XT_BASESAFTER,
 		XT_BOTTOM,
+		XT_BOUNDSCORES,
 		XT_BOUNDS,
 		XT_CHANGE,
 		XT_CHANGED,
@@ -112,6 +116,7 @@ namespace org_biologicinstitute_stylus
         XT_COMPARED,
         XT_COMPAREDMUTATIONS,
 		XT_CONTAINEDSTROKES,
+		XT_COOLING,
 		XT_COPIED,
 		XT_COPIES,
 		XT_COPY,
@@ -146,6 +151,7 @@ namespace org_biologicinstitute_stylus
 		XT_FACTOR,
 		XT_FIRSTSTROKE,
 		XT_FITNESS,
+		XT_FITNESSCACHE,
 		XT_FITNESSCONDITION,
 		XT_FITNESSRANGE,
 		XT_FIXEDCOST,
@@ -172,6 +178,7 @@ namespace org_biologicinstitute_stylus
 		XT_INSERT,
 		XT_INSERTED,
 		XT_INSERTIONS,
+		XT_LAST,
 		XT_LEFT,
 		XT_LENGTH,
 		XT_LIKELIHOOD,
@@ -179,6 +186,7 @@ namespace org_biologicinstitute_stylus
 		XT_MAINTAIN,
 		XT_MARKS,
 		XT_MAXIMUM,
+		XT_MIGRATIONINTERVAL,
 		XT_MINIMUM,
 		XT_MINIMUMSTROKELENGTH,
 		XT_MISSINGOVERLAPS,
@@ -195,6 +203,7 @@ namespace org_biologicinstitute_stylus
 		XT_PLAN,
 		XT_POINT,
 		XT_POINTS,
+		XT_POPULATION,
 		XT_PRESERVEGENES,
 		XT_PROCESSORID,
 		XT_REASONCODE,
@@ -206,6 +215,7 @@ namespace org_biologicinstitute_stylus
 		XT_ROLLBACKCONDITION,
 		XT_ROLLBACKLIMIT,
 		XT_ROLLBACKS,
+		XT_SAMPLE,
 		XT_SCALE,
 		XT_SCORE,
 		XT_SCORECONDITION,
@@ -215,6 +225,7 @@ namespace org_biologicinstitute_stylus
 		XT_SEGMENT,
 		XT_SEGMENTS,
 		XT_SILENT,
+		XT_SIZE,
 		XT_SOURCEINDEX,
 		XT_SPDEVIATION,
 		XT_SPDROPOUTS,
@@ -224,16 +235,20 @@ namespace org_biologicinstitute_stylus
 		XT_SPMISSINGOVERLAPS,
 		XT_SPPLACEMENT,
 		XT_SPSCALE,
+		XT_SPECULATIVEATTEMPTS,
 		XT_STATISTICS,
 		XT_STEP,
 		XT_STEPS,
 		XT_STRAIN,
 		XT_STROKE,
+		XT_STROKEORIENTATION,
 		XT_STROKES,
 		XT_SXTOHAN,
 		XT_SYTOHAN,
 		XT_TANDEM,
 		XT_TARGETINDEX,
+		XT_TEMPERATURE,
+		XT_TEMPERATURERATIO,
 		XT_TERMINATION,
 		XT_TERMINATIONCODE,
 		XT_TERMINATIONCONDITIONS,
@@ -301,6 +316,7 @@ namespace org_biologicinstitute_stylus
 		XP_TERMINATIONDURATION,
 		XP_TERMINATIONROLLBACK,
 		XP_TERMINATIONFITNESS,
+		XP_POPULATION,
 		XP_STEPS,
 		XP_TRIALCONDITIONS,
 		XP_TRIALCOST,
@@ -363,6 +379,7 @@ namespace org_biologicinstitute_stylus
 		static bool isXPathSuccess(xmlXPathObjectPtr pxpo, int nMaximumNodes = std::numeric_limits<int>::max(), int nMinimumNodes = 1);
 
 		static void initialize();
+		static void initializeThread();
 		static void terminate();
 		
 		static void setScope(const char* pszScope);
@@ -519,7 +536,7 @@ namespace org_biologicinstitute_stylus
 		static const char* s_aryXMLXPATH[XP_MAX];
 
 		static std::string s_strScope;
-		static char s_szXMLError[Constants::s_cbmaxBUFFER];
+		static thread_local char s_szXMLError[Constants::s_cbmaxBUFFER];
 
 		/**
 		 * \brief Initialization helper routines to load/free schemas
@@ -21,8 +21,8 @@ This script builds tests data for all of the sample plans and genomes
 import os
 import xml.dom.minidom
 import random
-from stylus import execute_stylus_plan
-from data import BLACKLIST
+from stylus import execute_stylus_plan, execute_stylus_evaluation
+from data import BLACKLIST, GLOBALS, EVALUATIONS
 from util import drop_extension
 
 def find_genes():
@@ -79,7 +79,16 @@ def collect_test_data(plan, gene):
         print "Collecting test data for plan: ", plan_name, "gene: ", gene_name
         target_path = os.path.join('test_data', plan_name)
         execute_stylus_plan(os.path.basename(gene), plan, './test_data', './sample/', 
-                './sample/', './sample/plans', target_path)
+                './sample/', './sample/plans', target_path, GLOBALS.get(plan_name))
+
+def collect_evaluation(gene):
+    gene_name = drop_extension(os.path.basename(gene))
+    print "Collecting test data for evaluation of gene: ", gene_name
+    holding_folder = os.path.basename(gene)[0] + '000'
+    target_file = os.path.join('test_data', EVALUATIONS, gene_name + '.txt')
+    open_create_folders(target_file, 'w').close()
+    execute_stylus_evaluation(os.path.join('test_data', holding_folder, os.path.basename(gene)),
+            './sample', './schemas', target_file)
 
 
 def main():
@@ -95,5 +104,8 @@ def main():
         for gene in genes:
             collect_test_data(plan, gene)
 
+    for gene in genes:
+        collect_evaluation(gene)
+
 if __name__ == '__main__':
     main()
@@ -5,6 +5,15 @@ BLACKLIST = [
     ('7DDA', 'performance') # performance.xml make specific references to 52DC
 ]
 
+# The following maps plans to the globals file with which they should
+# be run (plans not listed run with the default globals)
+GLOBALS = {
+    'orientation' : 'sample/globals/endpoints.xml' # scores strokes with the non-default orientation
+}
+
+# Directory (within test_data) holding the results of evaluate.py
+EVALUATIONS = 'evaluations'
+
 IGNORE = {
         'history' : ['uuid', 'creationTool', 'creationDate'],
         'genome' : ['uuid', 'creationTool', 'creationDate'],
@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+# Stylus, Copyright 2011 Biologic Institute
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+evaluate.py
+
+This script evaluates a fixed batch of mutations against a genome (using
+stEvaluateMutations) and writes one line of results per mutation
+
+Usage: evaluate.py genome_file han_url schema_url output_file
+"""
+import sys
+import stylusengine as Stylus
+
+# Mutations lie within the first 1272 bases (the shortest sample gene)
+# and on codon boundaries of genes starting at base 1
+MUTATIONS = [
+    ('change', 0, 601, 1, 'A'),
+    ('change', 0, 604, 3, 'GCT'),
+    ('change', 0, 1000, 1, 'T'),
+    ('insert', 0, 901, 3, 'ACT'),
+    ('delete', 0, 1201, 3),
+    ('delete', 0, 100, 6),
+    ('copy', 301, 1000, 6),
+    ('transpose', 61, 1150, 3)
+]
+
+def main(argv):
+    genome_file, han_url, schema_url, output_file = argv[1:5]
+
+    rc = Stylus.setScope(han_url, schema_url)
+    if rc:
+        raise Exception(Stylus.errorToString(rc))
+
+    rc = Stylus.setGenome(open(genome_file).read(), 'tests')
+    if rc:
+        raise Exception(Stylus.errorToString(rc))
+
+    results = Stylus.evaluateMutations(MUTATIONS)
+    if not isinstance(results, list):
+        raise Exception(Stylus.errorToString(results))
+
+    output = open(output_file, 'w')
+    for mutation, result in zip(MUTATIONS, results):
+        output.write('%s %d %0.15f %0.15f %0.15f %0.15f %d %d\n' % ((mutation[0],) + tuple(result)))
+    output.close()
+
+if __name__ == '__main__':
+    main(sys.argv)
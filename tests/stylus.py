@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import os
 import subprocess
 import sys
 
@@ -19,7 +20,7 @@ class StylusExecutionError(Exception):
     pass
         
 
-def execute_stylus_plan(gene, plan, genome_url, han_url, html_url, plan_url, data_dir):
+def execute_stylus_plan(gene, plan, genome_url, han_url, html_url, plan_url, data_dir, globals_path = None):
     """
     Execute the stylus program, no output or return value.
     If stylus fails an StylusExecutionError exception will be raised
@@ -29,8 +30,12 @@ def execute_stylus_plan(gene, plan, genome_url, han_url, html_url, plan_url, dat
     else:
         version = 'r'
 
-    stylus = subprocess.Popen(['./stylus', version, '-e', '--', '-g', gene, '-p', plan,
-        '-u', ','.join([genome_url, han_url, html_url, plan_url]), '-d', data_dir], 
+    arguments = ['./stylus', version, '-e', '--', '-g', gene, '-p', plan,
+        '-u', ','.join([genome_url, han_url, html_url, plan_url]), '-d', data_dir]
+    if globals_path:
+        arguments += ['-c', os.path.abspath(globals_path)]
+
+    stylus = subprocess.Popen(arguments,
         stdout = subprocess.PIPE, stderr = subprocess.STDOUT)
 
     stdout, stderr = stylus.communicate()
@@ -38,5 +43,23 @@ def execute_stylus_plan(gene, plan, genome_url, han_url, html_url, plan_url, dat
         raise StylusExecutionError(stdout)
 
 
+def execute_stylus_evaluation(genome_file, han_path, schema_path, output_file):
+    """
+    Evaluate the mutations of evaluate.py against the genome, writing the
+    results to output_file.
+    If the evaluation fails an StylusExecutionError exception will be raised
+    """
+    environment = dict(os.environ)
+    environment['PYTHONPATH'] = os.pathsep.join([os.path.abspath('lib'), environment.get('PYTHONPATH', '')])
+
+    evaluation = subprocess.Popen(['python', 'tests/evaluate.py', genome_file,
+        'file://' + os.path.abspath(han_path) + '/', 'file://' + os.path.abspath(schema_path) + '/', output_file],
+        stdout = subprocess.PIPE, stderr = subprocess.STDOUT, env = environment)
+
+    stdout, stderr = evaluation.communicate()
+    if evaluation.returncode != 0:
+        raise StylusExecutionError(stdout)
+
+
 if __name__ == '__main__':
     execute_stylus_plan('52DC.gene', 'simple.xml', './sample/', './sample/', './sample/', './sample/plans', 'alpha')
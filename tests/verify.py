@@ -17,8 +17,8 @@ import os
 import tempfile
 import shutil
 import sys
-from stylus import execute_stylus_plan
-from data import BLACKLIST, IGNORE
+from stylus import execute_stylus_plan, execute_stylus_evaluation
+from data import BLACKLIST, IGNORE, GLOBALS, EVALUATIONS
 from util import drop_extension
 import xml.parsers.expat
 
@@ -26,6 +26,8 @@ DATA_DIR = './test_data/current/'
 
 def find_plans():
     for filename in os.listdir('test_data'):
+        if filename == EVALUATIONS:
+            continue
         try:
             int(filename)
         except ValueError:
@@ -62,6 +64,9 @@ def as_xml_elements(source):
 class XMLDifferenceError(Exception):
     pass
 
+class EvaluationDifferenceError(Exception):
+    pass
+
 def xml_file_compare(correct_file, current_file):
     correct_elements = as_xml_elements(correct_file)
     current_elements = as_xml_elements(current_file)
@@ -85,13 +90,29 @@ def verify_result(plan, gene):
     print "Testing", plan, gene
     data_dir = os.path.join(DATA_DIR, drop_extension(plan))
     execute_stylus_plan(gene, plan, './test_data', './sample',
-        './sample', './sample/plans', data_dir)
+        './sample', './sample/plans', data_dir, GLOBALS.get(drop_extension(plan)))
     xml_directory_compare( 
         os.path.join('test_data', drop_extension(plan), drop_extension(gene) ),
         os.path.join(data_dir, drop_extension(gene) )
     )
 
 
+def verify_evaluation(gene):
+    print "Testing evaluation", gene
+    gene_name = drop_extension(gene)
+    correct_file = os.path.join('test_data', EVALUATIONS, gene_name + '.txt')
+    current_file = os.path.join(DATA_DIR, EVALUATIONS, gene_name + '.txt')
+    try:
+        os.makedirs(os.path.dirname(current_file))
+    except OSError:
+        pass
+    execute_stylus_evaluation(os.path.join('test_data', gene[0] + '000', gene),
+        './sample', './schemas', current_file)
+    if open(correct_file).read() != open(current_file).read():
+        raise EvaluationDifferenceError("""Baseline File: %s
+Current File: %s
+Evaluations differ!""" % (correct_file, current_file))
+
 
 def main():
     try:
@@ -107,6 +128,9 @@ def main():
             if (drop_extension(gene), drop_extension(plan)) not in BLACKLIST:
                 verify_result(plan, gene)
 
+    for gene in genes:
+        verify_evaluation(gene)
+
     
 
 if __name__ == '__main__':